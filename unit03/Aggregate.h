@@ -0,0 +1,396 @@
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+#include"CommonHeader.h"
+//BinaryTree.h and Query.h, which aggregates are computed through,
+//are included before this header
+
+int countQuery(TREE* tree, QUERY* query);
+  int exactStep(QUERY_PLAN* plan);
+int* groupTree(TREE* tree, FIND_BY type, int* groupCount);
+  THREAD_RETURN THREAD_CALL groupThread(void* argument);
+int topGroups(TREE* tree, FIND_BY type, int k, int* groups, int* counts);
+  int rankGroups(int* counts, int groupCount, int k, int* groups);
+  int compareGroups(const void* a, const void* b);
+int printGroups(TREE* tree, FIND_BY type, int k);
+
+/*
+  GroupTask
+  description
+    a run of rows of the column store of a tree counted by one
+    thread.
+  data:
+    tree        tree whose column store is counted.
+    type        the field the rows are grouped by.
+    first       the first row counted.
+    last        the row after the last counted.
+    counts      the number of rows holding each value of the
+                field.
+*/
+typedef struct GroupTaskP
+{
+  TREE* tree;
+  FIND_BY type;
+  int first;
+  int last;
+  int* counts;
+} GroupTask;
+
+/*
+  countQuery
+  description
+    counts the nodes fitting a query without collecting them
+    in order or formatting any. A term answered by a bitmap is
+    counted from the size of the bitmap, and a plan whose every
+    step finds only nodes fitting it from the size of the
+    bitmap it finds. Otherwise the nodes found are tested, on
+    as many threads as there are processors for large trees.
+  params:
+    tree      tree being counted.
+    query     the query, NULL counts every node.
+  return:
+    count     the number of nodes fitting.
+*/
+int countQuery(TREE* tree, QUERY* query)
+{
+  QUERY_PLAN* plan;
+  BITMAP* found = NULL;
+  NODE** nodes;
+  int count;
+
+  if(query == NULL) return tree->size;
+  plan = planQuery(tree, query, BY_KEY, 0);
+  if(plan->path == PATH_BITMAP)
+  {
+    count = countTree(tree, query->type, query->target);
+    deletePlan(plan);
+    return count;
+  }
+  if(plan->path != PATH_SCAN)
+  {
+    found = runStep(tree, plan);
+    if(exactStep(plan))
+    {
+      count = bitmapCount(found);
+      deleteBitmap(found);
+      deletePlan(plan);
+      return count;
+    }
+  }
+
+  nodes = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  if(nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to count query");
+    PAUSE
+    exit(0);
+  }
+  if(found == NULL) count = scanQuery(tree, query, nodes);
+  else
+  {
+    count = filterNodes(nodes, bitmapElements(found, nodes), query);
+    deleteBitmap(found);
+  }
+  free(nodes);
+  deletePlan(plan);
+  return count;
+}
+
+/*
+  exactStep
+  description
+    tests whether the nodes a step of a plan finds all fit its
+    part of the query, so that they need not be tested.
+  params:
+    plan      the step.
+  return:
+    exact     1 if they all fit, otherwise 0.
+*/
+int exactStep(QUERY_PLAN* plan)
+{
+  QUERY_PLAN* step;
+
+  switch(plan->path)
+  {
+    case PATH_LOOKUP:
+    case PATH_BITMAP:
+      return 1;
+    case PATH_INTERSECT:
+    case PATH_UNION:
+      for(step = plan->steps; step != NULL; step = step->next)
+      {
+        //parts of an intersection which are not joined are tested
+        if(plan->path == PATH_INTERSECT && step != plan->driver && !step->joined) return 0;
+        if(!exactStep(step)) return 0;
+      }
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+/*
+  groupTree
+  description
+    counts the nodes holding each value of a field of many
+    repeated values, without visiting any node. A field with
+    a bitmap index is counted from the sizes of its bitmaps,
+    any other from the column store of the tree (which is
+    rebuilt first if there is none or if it is stale), split
+    into a run of rows for each processor for large trees.
+    Each run is counted separately and the counts are summed.
+  params:
+    tree      tree being counted.
+    type      the field the nodes are grouped by.
+    groupCount
+              set to the number of groups.
+  return:
+    counts*   new array of the number of nodes in each group,
+              to be freed, or NULL if the field cannot be
+              grouped.
+*/
+int* groupTree(TREE* tree, FIND_BY type, int* groupCount)
+{
+  FunctionPointers* functionPointers = tree->functionPointers;
+  BITMAP_INDEX* index;
+  GroupTask* tasks;
+  THREAD* threads;
+  int *started, *counts;
+  int taskCount = 1, share, groups, i, j;
+
+  if(type == BY_KEY || type == LEAVES) return NULL;
+  //an index is only read if it has been built for searches
+  for(index = tree->bitmaps; index != NULL && index->type != type; index = index->next);
+  if(index != NULL)
+  {
+    index = getBitmapIndex(tree, type);
+    counts = (int*) calloc(index->keyCount + 1, sizeof(int));
+    if(counts == NULL)
+    {
+      printf("sufficient memory could not be allocated to group tree");
+      PAUSE
+      exit(0);
+    }
+    lockMutex(&tree->bitmapLock);
+    for(i = 0; i < index->keyCount; i++)
+    {
+      if(index->bitmaps[i] != NULL) counts[i] = bitmapCount(index->bitmaps[i]);
+    }
+    unlockMutex(&tree->bitmapLock);
+    *groupCount = index->keyCount;
+    return counts;
+  }
+
+  if(functionPointers->groupColumns == NULL) return NULL;
+  if(tree->columns == NULL || tree->columnsStale) buildColumns(tree);
+  if((groups = functionPointers->groupColumns(tree->columns, type, 0, 0, NULL)) < 0) return NULL;
+  if(tree->size > PARALLEL_GRAIN) taskCount = processorCount();
+
+  tasks = (GroupTask*) malloc(taskCount * sizeof(GroupTask));
+  threads = (THREAD*) malloc(taskCount * sizeof(THREAD));
+  started = (int*) calloc(taskCount, sizeof(int));
+  if(tasks == NULL || threads == NULL || started == NULL)
+  {
+    printf("sufficient memory could not be allocated to group tree");
+    PAUSE
+    exit(0);
+  }
+  share = (tree->size + taskCount - 1) / taskCount;
+  for(i = 0; i < taskCount; i++)
+  {
+    tasks[i].counts = (int*) calloc(groups + 1, sizeof(int));
+    if(tasks[i].counts == NULL)
+    {
+      printf("sufficient memory could not be allocated to group tree");
+      PAUSE
+      exit(0);
+    }
+  }
+  for(i = 0; i < taskCount; i++)
+  {
+    tasks[i].tree = tree;
+    tasks[i].type = type;
+    tasks[i].first = i * share;
+    tasks[i].last = i == taskCount - 1 ? tree->size : (i + 1) * share;
+    //the first run is counted by this thread, as are any whose
+    //thread could not be started
+    if(i > 0) started[i] = !startThread(&threads[i], &groupThread, &tasks[i]);
+  }
+  for(i = 0; i < taskCount; i++)
+  {
+    if(!started[i]) groupThread(&tasks[i]);
+  }
+  counts = tasks[0].counts;
+  for(i = 1; i < taskCount; i++)
+  {
+    if(started[i]) joinThread(threads[i]);
+    for(j = 0; j < groups; j++) counts[j] += tasks[i].counts[j];
+    free(tasks[i].counts);
+  }
+  free(tasks);
+  free(threads);
+  free(started);
+  *groupCount = groups;
+  return counts;
+}
+
+/*
+  groupThread
+  description
+    thread entry point counting the rows of a GroupTask.
+  params:
+    argument  the GroupTask being carried out.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+THREAD_RETURN THREAD_CALL groupThread(void* argument)
+{
+  GroupTask* task = (GroupTask*) argument;
+
+  if(task->first < task->last)
+  {
+    task->tree->functionPointers->groupColumns(task->tree->columns, task->type, task->first, task->last, task->counts);
+  }
+  return 0;
+}
+
+/*
+  topGroups
+  description
+    finds the values of a field held by the most nodes (see
+    groupTree).
+  params:
+    tree      tree being counted.
+    type      the field the nodes are grouped by.
+    k         the most values to return.
+    groups    filled with the values found, most held first,
+              ties lowest first.
+    counts    filled with the number of nodes holding each
+              value found.
+  return:
+    count     the number of values found, or -1 if the field
+              cannot be grouped.
+*/
+int topGroups(TREE* tree, FIND_BY type, int k, int* groups, int* counts)
+{
+  int *all, *ranked;
+  int groupCount, count, i;
+
+  if((all = groupTree(tree, type, &groupCount)) == NULL) return -1;
+  ranked = (int*) malloc((groupCount + 1) * sizeof(int));
+  if(ranked == NULL)
+  {
+    printf("sufficient memory could not be allocated to rank groups");
+    PAUSE
+    exit(0);
+  }
+  count = rankGroups(all, groupCount, k, ranked);
+  for(i = 0; i < count; i++)
+  {
+    groups[i] = ranked[i];
+    counts[i] = all[ranked[i]];
+  }
+  free(ranked);
+  free(all);
+  return count;
+}
+
+/*
+  rankGroups
+  description
+    orders the groups held by any node, most held first.
+  params:
+    counts    the number of nodes in each group.
+    groupCount
+              the number of groups.
+    k         the most groups to return, 0 for all.
+    groups    filled with the groups, ties lowest first. It
+              must have room for groupCount groups.
+  return:
+    count     the number of groups returned.
+*/
+int rankGroups(int* counts, int groupCount, int k, int* groups)
+{
+  long long* ranks = (long long*) malloc((groupCount + 1) * sizeof(long long));
+  int held = 0, i;
+
+  if(ranks == NULL)
+  {
+    printf("sufficient memory could not be allocated to rank groups");
+    PAUSE
+    exit(0);
+  }
+  //the count is held above the group, taken from the largest
+  //count, so that both are ordered by one comparison
+  for(i = 0; i < groupCount; i++)
+  {
+    if(counts[i] > 0) ranks[held++] = ((long long) (0x7fffffff - counts[i]) << 32) | i;
+  }
+  qsort(ranks, held, sizeof(long long), &compareGroups);
+  if(k <= 0 || k > held) k = held;
+  for(i = 0; i < k; i++) groups[i] = (int) (ranks[i] & 0xffffffff);
+  free(ranks);
+  return k;
+}
+
+/*
+  compareGroups
+  description
+    qsort comparison of the ranks of groups made by rankGroups.
+  params:
+    a         the first rank.
+    b         the second rank.
+  return:
+    comp      negative, zero or positive as a is ordered
+              before, with or after b.
+*/
+int compareGroups(const void* a, const void* b)
+{
+  long long x = *((const long long*) a), y = *((const long long*) b);
+  return x < y ? -1 : x > y;
+}
+
+/*
+  printGroups
+  description
+    prints the values of a field held by the most nodes, and
+    the number of nodes holding each.
+  params:
+    tree      tree being counted.
+    type      the field the nodes are grouped by.
+    k         the most values printed, 0 for all.
+  return:
+    count     the number of values printed.
+*/
+int printGroups(TREE* tree, FIND_BY type, int k)
+{
+  char* string = valueBufferA;
+  int *counts, *groups;
+  int groupCount, count, i;
+
+  if((counts = groupTree(tree, type, &groupCount)) == NULL)
+  {
+    printf("\nERROR: FIELD CANNOT BE COUNTED\n");
+    return 0;
+  }
+  groups = (int*) malloc((groupCount + 1) * sizeof(int));
+  if(groups == NULL)
+  {
+    printf("sufficient memory could not be allocated to print groups");
+    PAUSE
+    exit(0);
+  }
+  count = rankGroups(counts, groupCount, k, groups);
+
+  printf("\n%-10s%s\n", "count", "value");
+  for(i = 0; i < count; i++)
+  {
+    tree->functionPointers->groupToString(type, groups[i], string);
+    printf("%-10d%s\n", counts[groups[i]], string);
+  }
+  printf("%d value(s) printed, of %d record(s).\n\n", count, tree->size);
+  free(groups);
+  free(counts);
+  return count;
+}
+
+#endif
@@ -0,0 +1,572 @@
+#ifndef BTREE_H
+#define BTREE_H
+#include"CommonHeader.h"
+#include"Node.h"
+
+//minimum degree of the b-tree, every node other than the root holds
+//between BTREE_DEGREE-1 and 2*BTREE_DEGREE-1 elements
+#define BTREE_DEGREE 16
+#define BTREE_MAX (2 * BTREE_DEGREE - 1)
+
+typedef struct BTREE_NODE_P BTREE_NODE;
+
+BTREE_NODE* newBTreeNode(int leaf);
+int deleteBTree(BTREE_NODE* bNode, int clear);
+
+int insertBTree(BTREE_NODE** root, NODE* node);
+  int splitBTreeChild(BTREE_NODE* bNode, int i);
+  int insertBTreeNonFull(BTREE_NODE* bNode, NODE* node, unsigned long long prefix);
+
+int removeBTree(BTREE_NODE** root, NODE* node);
+  int removeBTreeNode(BTREE_NODE* bNode, NODE* node, unsigned long long prefix);
+  int fillBTreeChild(BTREE_NODE* bNode, int i);
+  int borrowBTreeLess(BTREE_NODE* bNode, int i);
+  int borrowBTreeGreater(BTREE_NODE* bNode, int i);
+  int mergeBTreeChildren(BTREE_NODE* bNode, int i);
+
+int* findBTree(BTREE_NODE* bNode, NODE* node);
+int* searchBTree(BTREE_NODE* bNode, char* key);
+int walkBTree(BTREE_NODE* bNode, int (*visit)(int* ptr_branch, void* context), void* context);
+
+int lowerBoundBTree(BTREE_NODE* bNode, unsigned long long prefix, NODE* node);
+int setBTreeEntry(BTREE_NODE* bNode, int i, NODE* node);
+int moveBTreeEntries(BTREE_NODE* to, int toIndex, BTREE_NODE* from, int fromIndex, int count);
+unsigned long long keyPrefix(char* key);
+
+/*
+  BTREE_NODE
+  description
+    node of an in memory b-tree. The elements of each node are
+    held in order, alongside an array of their key prefixes, so
+    that the position of a key in a node is usually found by a
+    scan of one contiguous array without touching the elements.
+  data:
+    count       the number of elements held.
+    leaf        whether the node has no children.
+    prefix      the first 8 characters of each element's key,
+                packed so that comparing two prefixes as
+                integers orders them as strings.
+    entries     handles of the elements held (see nodeAt).
+    children    the children of the node (unused for leaves),
+                children[i] holds the elements ordered before
+                entries[i].
+*/
+struct BTREE_NODE_P
+{
+  int count;
+  int leaf;
+  unsigned long long prefix[BTREE_MAX];
+  int entries[BTREE_MAX];
+  BTREE_NODE* children[BTREE_MAX + 1];
+};
+
+/*
+  newBTreeNode
+  description
+    creates an empty b-tree node.
+  params:
+    leaf      whether the node is a leaf.
+  return:
+    bNode*    node created
+*/
+BTREE_NODE* newBTreeNode(int leaf)
+{
+  BTREE_NODE* bNode = (BTREE_NODE*) malloc(sizeof(BTREE_NODE));
+  if(bNode == NULL)
+  {
+    printf("sufficient memory could not be allocated to create b-tree node");
+    PAUSE
+    exit(0);
+  }
+  bNode->count = 0;
+  bNode->leaf = leaf;
+  return bNode;
+}
+
+/*
+  deleteBTree
+  description
+    frees a b-tree.
+  params:
+    bNode     root of the b-tree.
+    clear     whether the elements are also deleted.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteBTree(BTREE_NODE* bNode, int clear)
+{
+  int i;
+  if(bNode == NULL) return 0;
+
+  for(i = 0; i < bNode->count; i++)
+  {
+    if(!bNode->leaf) deleteBTree(bNode->children[i], clear);
+    if(clear) deleteNode(nodeAt(bNode->entries[i]), 0);
+  }
+  if(!bNode->leaf) deleteBTree(bNode->children[bNode->count], clear);
+  free(bNode);
+  return 0;
+}
+
+/*
+  insertBTree
+  description
+    adds an element to a b-tree. Full nodes are split on the way
+    down so that the insertion never has to climb back up.
+  params:
+    root      the root of the b-tree.
+    node      element being added.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int insertBTree(BTREE_NODE** root, NODE* node)
+{
+  BTREE_NODE* bNode;
+
+  if(*root == NULL) *root = newBTreeNode(1);
+  if((*root)->count == BTREE_MAX)
+  {
+    bNode = newBTreeNode(0);
+    bNode->children[0] = *root;
+    splitBTreeChild(bNode, 0);
+    *root = bNode;
+  }
+  return insertBTreeNonFull(*root, node, keyPrefix(node->key));
+}
+
+/*
+  splitBTreeChild
+  description
+    splits a full child in two around its middle element, which
+    moves up into the parent.
+  params:
+    bNode     parent node, which must not be full.
+    i         position of the full child.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int splitBTreeChild(BTREE_NODE* bNode, int i)
+{
+  BTREE_NODE* child = bNode->children[i];
+  BTREE_NODE* sibling = newBTreeNode(child->leaf);
+  int j;
+
+  moveBTreeEntries(sibling, 0, child, BTREE_DEGREE, BTREE_DEGREE - 1);
+  if(!child->leaf)
+  {
+    for(j = 0; j < BTREE_DEGREE; j++) sibling->children[j] = child->children[j + BTREE_DEGREE];
+  }
+  sibling->count = BTREE_DEGREE - 1;
+  child->count = BTREE_DEGREE - 1;
+
+  for(j = bNode->count; j > i; j--) bNode->children[j + 1] = bNode->children[j];
+  bNode->children[i + 1] = sibling;
+  moveBTreeEntries(bNode, i + 1, bNode, i, bNode->count - i);
+  moveBTreeEntries(bNode, i, child, BTREE_DEGREE - 1, 1);
+  bNode->count++;
+  return 0;
+}
+
+/*
+  insertBTreeNonFull
+  description
+    adds an element below a node known not to be full.
+  params:
+    bNode     node being added to.
+    node      element being added.
+    prefix    key prefix of the element.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int insertBTreeNonFull(BTREE_NODE* bNode, NODE* node, unsigned long long prefix)
+{
+  int i = lowerBoundBTree(bNode, prefix, node);
+
+  while(!bNode->leaf)
+  {
+    if(bNode->children[i]->count == BTREE_MAX)
+    {
+      splitBTreeChild(bNode, i);
+      if(lowerBoundBTree(bNode, prefix, node) > i) i++;
+    }
+    bNode = bNode->children[i];
+    i = lowerBoundBTree(bNode, prefix, node);
+  }
+
+  moveBTreeEntries(bNode, i + 1, bNode, i, bNode->count - i);
+  setBTreeEntry(bNode, i, node);
+  bNode->count++;
+  return 0;
+}
+
+/*
+  removeBTree
+  description
+    removes an element from a b-tree. Children are refilled on
+    the way down so that the removal never has to climb back up.
+  params:
+    root      the root of the b-tree.
+    node      element being removed.
+  return:
+    removed   1 if the element was found and removed, else 0.
+*/
+int removeBTree(BTREE_NODE** root, NODE* node)
+{
+  BTREE_NODE* bNode = *root;
+  int removed;
+
+  if(bNode == NULL) return 0;
+  removed = removeBTreeNode(bNode, node, keyPrefix(node->key));
+  if(bNode->count == 0)
+  {
+    *root = bNode->leaf ? NULL : bNode->children[0];
+    free(bNode);
+  }
+  return removed;
+}
+
+/*
+  removeBTreeNode
+  description
+    removes an element from below a node holding at least
+    BTREE_DEGREE elements (or the root).
+  params:
+    bNode     node being removed from.
+    node      element being removed.
+    prefix    key prefix of the element.
+  return:
+    removed   1 if the element was found and removed, else 0.
+*/
+int removeBTreeNode(BTREE_NODE* bNode, NODE* node, unsigned long long prefix)
+{
+  int i = lowerBoundBTree(bNode, prefix, node);
+  BTREE_NODE *less, *greater;
+  NODE* replacement;
+
+  if(i < bNode->count && bNode->entries[i] == node->handle)
+  {
+    if(bNode->leaf)
+    {
+      moveBTreeEntries(bNode, i, bNode, i + 1, bNode->count - i - 1);
+      bNode->count--;
+      return 1;
+    }
+
+    //an inner element is replaced by its neighbour from a child
+    //with elements to spare, or pushed down into a merged child
+    less = bNode->children[i];
+    greater = bNode->children[i + 1];
+    if(less->count >= BTREE_DEGREE)
+    {
+      while(!less->leaf) less = less->children[less->count];
+      replacement = nodeAt(less->entries[less->count - 1]);
+      setBTreeEntry(bNode, i, replacement);
+      return removeBTreeNode(bNode->children[i], replacement, bNode->prefix[i]);
+    }
+    if(greater->count >= BTREE_DEGREE)
+    {
+      while(!greater->leaf) greater = greater->children[0];
+      replacement = nodeAt(greater->entries[0]);
+      setBTreeEntry(bNode, i, replacement);
+      return removeBTreeNode(bNode->children[i + 1], replacement, bNode->prefix[i]);
+    }
+    mergeBTreeChildren(bNode, i);
+    return removeBTreeNode(less, node, prefix);
+  }
+
+  if(bNode->leaf) return 0;
+  if(bNode->children[i]->count < BTREE_DEGREE) i = fillBTreeChild(bNode, i);
+  return removeBTreeNode(bNode->children[i], node, prefix);
+}
+
+/*
+  fillBTreeChild
+  description
+    gives a child with the minimum number of elements one more,
+    borrowing from a sibling or merging with one.
+  params:
+    bNode     parent node.
+    i         position of the child.
+  return:
+    i         position of the refilled child.
+*/
+int fillBTreeChild(BTREE_NODE* bNode, int i)
+{
+  if(i > 0 && bNode->children[i - 1]->count >= BTREE_DEGREE)
+  {
+    borrowBTreeLess(bNode, i);
+  }
+  else if(i < bNode->count && bNode->children[i + 1]->count >= BTREE_DEGREE)
+  {
+    borrowBTreeGreater(bNode, i);
+  }
+  else if(i < bNode->count)
+  {
+    mergeBTreeChildren(bNode, i);
+  }
+  else
+  {
+    mergeBTreeChildren(bNode, --i);
+  }
+  return i;
+}
+
+/*
+  borrowBTreeLess
+  description
+    rotates an element from a child's lesser sibling, through
+    the parent, into the child.
+  params:
+    bNode     parent node.
+    i         position of the child.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int borrowBTreeLess(BTREE_NODE* bNode, int i)
+{
+  BTREE_NODE* child = bNode->children[i];
+  BTREE_NODE* sibling = bNode->children[i - 1];
+  int j;
+
+  moveBTreeEntries(child, 1, child, 0, child->count);
+  if(!child->leaf)
+  {
+    for(j = child->count + 1; j > 0; j--) child->children[j] = child->children[j - 1];
+    child->children[0] = sibling->children[sibling->count];
+  }
+  moveBTreeEntries(child, 0, bNode, i - 1, 1);
+  moveBTreeEntries(bNode, i - 1, sibling, sibling->count - 1, 1);
+  child->count++;
+  sibling->count--;
+  return 0;
+}
+
+/*
+  borrowBTreeGreater
+  description
+    rotates an element from a child's greater sibling, through
+    the parent, into the child.
+  params:
+    bNode     parent node.
+    i         position of the child.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int borrowBTreeGreater(BTREE_NODE* bNode, int i)
+{
+  BTREE_NODE* child = bNode->children[i];
+  BTREE_NODE* sibling = bNode->children[i + 1];
+  int j;
+
+  moveBTreeEntries(child, child->count, bNode, i, 1);
+  moveBTreeEntries(bNode, i, sibling, 0, 1);
+  moveBTreeEntries(sibling, 0, sibling, 1, sibling->count - 1);
+  if(!child->leaf)
+  {
+    child->children[child->count + 1] = sibling->children[0];
+    for(j = 0; j < sibling->count; j++) sibling->children[j] = sibling->children[j + 1];
+  }
+  child->count++;
+  sibling->count--;
+  return 0;
+}
+
+/*
+  mergeBTreeChildren
+  description
+    merges two neighbouring children, along with the parent
+    element between them, into the lesser child.
+  params:
+    bNode     parent node.
+    i         position of the lesser child.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int mergeBTreeChildren(BTREE_NODE* bNode, int i)
+{
+  BTREE_NODE* child = bNode->children[i];
+  BTREE_NODE* sibling = bNode->children[i + 1];
+  int j;
+
+  moveBTreeEntries(child, child->count, bNode, i, 1);
+  moveBTreeEntries(child, child->count + 1, sibling, 0, sibling->count);
+  if(!child->leaf)
+  {
+    for(j = 0; j <= sibling->count; j++) child->children[child->count + 1 + j] = sibling->children[j];
+  }
+  child->count += sibling->count + 1;
+
+  moveBTreeEntries(bNode, i, bNode, i + 1, bNode->count - i - 1);
+  for(j = i + 1; j < bNode->count; j++) bNode->children[j] = bNode->children[j + 1];
+  bNode->count--;
+  free(sibling);
+  return 0;
+}
+
+/*
+  findBTree
+  description
+    finds the slot holding a particular element.
+  params:
+    bNode     root of the b-tree.
+    node      element being searched for.
+  return:
+    ptr_branch
+              the slot holding the element, or NULL.
+*/
+int* findBTree(BTREE_NODE* bNode, NODE* node)
+{
+  unsigned long long prefix = keyPrefix(node->key);
+  int i;
+
+  while(bNode != NULL)
+  {
+    i = lowerBoundBTree(bNode, prefix, node);
+    if(i < bNode->count && bNode->entries[i] == node->handle) return &bNode->entries[i];
+    bNode = bNode->leaf ? NULL : bNode->children[i];
+  }
+  return NULL;
+}
+
+/*
+  searchBTree
+  description
+    finds the slot holding an element with a given key.
+  params:
+    bNode     root of the b-tree.
+    key       key being searched for.
+  return:
+    ptr_branch
+              the slot holding the element, or NULL.
+*/
+int* searchBTree(BTREE_NODE* bNode, char* key)
+{
+  unsigned long long prefix = keyPrefix(key);
+  int i, compare;
+
+  while(bNode != NULL)
+  {
+    compare = 1;
+    for(i = 0; i < bNode->count && bNode->prefix[i] <= prefix; i++)
+    {
+      if(bNode->prefix[i] == prefix && (compare = strcmp(nodeAt(bNode->entries[i])->key, key)) >= 0) break;
+    }
+    if(i < bNode->count && compare == 0) return &bNode->entries[i];
+    bNode = bNode->leaf ? NULL : bNode->children[i];
+  }
+  return NULL;
+}
+
+/*
+  walkBTree
+  description
+    visits every element of a b-tree in order.
+  params:
+    bNode     root of the b-tree.
+    visit     function called with the slot of each element,
+              returning nonzero stops the walk.
+    context   passed on to visit.
+  return:
+    stop      nonzero if the walk was stopped.
+*/
+int walkBTree(BTREE_NODE* bNode, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  int i;
+  if(bNode == NULL) return 0;
+
+  for(i = 0; i < bNode->count; i++)
+  {
+    if(!bNode->leaf && walkBTree(bNode->children[i], visit, context)) return 1;
+    if(visit(&bNode->entries[i], context)) return 1;
+  }
+  return !bNode->leaf && walkBTree(bNode->children[bNode->count], visit, context);
+}
+
+/*
+  lowerBoundBTree
+  description
+    finds the position of the first element of a node which is
+    not ordered before the given one. Elements are only read
+    when their key prefix matches.
+  params:
+    bNode     node being searched.
+    prefix    key prefix of the element.
+    node      element being placed.
+  return:
+    i         position of the first element not less than node.
+*/
+int lowerBoundBTree(BTREE_NODE* bNode, unsigned long long prefix, NODE* node)
+{
+  int i;
+  for(i = 0; i < bNode->count; i++)
+  {
+    if(bNode->prefix[i] > prefix) break;
+    if(bNode->prefix[i] == prefix && nodeCompareSort(nodeAt(bNode->entries[i]), node) >= 0) break;
+  }
+  return i;
+}
+
+/*
+  setBTreeEntry
+  description
+    places an element at a position in a node.
+  params:
+    bNode     node being modified.
+    i         position being set.
+    node      element being placed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int setBTreeEntry(BTREE_NODE* bNode, int i, NODE* node)
+{
+  bNode->entries[i] = node->handle;
+  bNode->prefix[i] = keyPrefix(node->key);
+  return 0;
+}
+
+/*
+  moveBTreeEntries
+  description
+    copies a run of elements and their prefixes between (or
+    within) nodes.
+  params:
+    to        destination node.
+    toIndex   position of the first destination slot.
+    from      source node.
+    fromIndex position of the first source slot.
+    count     the number of elements copied.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int moveBTreeEntries(BTREE_NODE* to, int toIndex, BTREE_NODE* from, int fromIndex, int count)
+{
+  if(count <= 0) return 0;
+  memmove(&to->entries[toIndex], &from->entries[fromIndex], count * sizeof(int));
+  memmove(&to->prefix[toIndex], &from->prefix[fromIndex], count * sizeof(unsigned long long));
+  return 0;
+}
+
+/*
+  keyPrefix
+  description
+    packs the first 8 characters of a key into an integer, most
+    significant byte first, so that integer order is string order.
+  params:
+    key       the key.
+  return:
+    prefix    the packed prefix.
+*/
+unsigned long long keyPrefix(char* key)
+{
+  unsigned long long prefix = 0;
+  int i, end = 0;
+
+  for(i = 0; i < 8; i++)
+  {
+    if(!end && key[i] == '\0') end = 1;
+    prefix = (prefix << 8) | (end ? 0 : (unsigned char) key[i]);
+  }
+  return prefix;
+}
+
+#endif
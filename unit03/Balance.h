@@ -0,0 +1,1634 @@
+#ifndef BALANCE_H
+#define BALANCE_H
+#include"CommonHeader.h"
+#include"Node.h"
+
+//colours of red-black tree nodes, held in NODE.balance
+#define BLACK_NODE 0
+#define RED_NODE 1
+//marks relaxed nodes with a branch written to since the last fix up
+#define RELAXED_DIRTY 1
+//levels a relaxed tree may grow past the least possible height
+//before it is fixed up, even while it is being written to
+#define RELAXED_SLACK 4
+
+typedef enum BALANCE_POLICY_P BALANCE_POLICY;
+typedef NODE* (*JOIN_FUNCTION)(NODE* less, NODE* node, NODE* greater);
+
+int updateElement(NODE* node);
+int elementHeight(NODE* node);
+int elementWeight(NODE* node);
+NODE* rotateLess(NODE* node);
+NODE* rotateGreater(NODE* node);
+
+NODE* joinElement(NODE* less, NODE* node, NODE* greater);
+  NODE* joinLessElement(NODE* less, NODE* node, NODE* greater);
+  NODE* joinGreaterElement(NODE* less, NODE* node, NODE* greater);
+
+int collectElement(NODE* node, NODE** nodes, int count);
+NODE* buildElement(NODE** nodes, int count);
+NODE* rebuildElement(NODE* node);
+int measureBranch(NODE* node);
+int compareBranch(NODE* node, NODE* target);
+NODE* detachElement(NODE* node);
+
+NODE* insertAvl(NODE* node, NODE* nodeIn);
+NODE* removeAvl(NODE* node, NODE* target);
+  NODE* removeFirstAvl(NODE* node, NODE** first);
+  NODE* balanceAvl(NODE* node);
+
+NODE* insertRedBlack(NODE* node, NODE* nodeIn);
+NODE* removeRedBlack(NODE* node, NODE* target);
+  NODE* removeFirstRedBlack(NODE* node, NODE** first);
+  NODE* balanceRedBlack(NODE* node);
+  NODE* rotateRedLess(NODE* node);
+  NODE* rotateRedGreater(NODE* node);
+  NODE* moveRedLess(NODE* node);
+  NODE* moveRedGreater(NODE* node);
+  int flipColours(NODE* node);
+  int isRed(NODE* node);
+NODE* buildRedBlack(NODE** nodes, int count);
+  NODE* buildRedBlackLevel(NODE** nodes, int count, int height, long long capacity);
+NODE* joinRedBlack(NODE* less, NODE* node, NODE* greater);
+  NODE* joinGreaterRedBlack(NODE* less, int height, NODE* node, NODE* greater, int greaterHeight);
+  NODE* joinLessRedBlack(NODE* less, int lessHeight, NODE* node, NODE* greater, int height);
+  int blackHeight(NODE* node);
+
+NODE* insertTreap(NODE* node, NODE* nodeIn);
+NODE* removeTreap(NODE* node, NODE* target);
+NODE* joinTreap(NODE* less, NODE* node, NODE* greater);
+NODE* mergeTreap(NODE* less, NODE* greater);
+NODE* buildTreap(NODE** nodes, int count);
+int treapPriority(void);
+
+NODE* insertScapegoat(NODE* node, NODE* nodeIn, int depth, int limit, int* unbalanced);
+NODE* removeScapegoat(NODE* node, NODE* target);
+  NODE* removeFirstScapegoat(NODE* node, NODE** first);
+int scapegoatLimit(int size);
+
+NODE* insertSplay(NODE* node, NODE* nodeIn);
+NODE* removeSplay(NODE* node, NODE* target);
+NODE* joinSplay(NODE* less, NODE* node, NODE* greater);
+NODE* splayElement(NODE* node, int (*compare)(NODE* node, void* target), void* target);
+int compareSplayNode(NODE* node, void* target);
+int compareSplayKey(NODE* node, void* target);
+
+NODE* insertRelaxed(NODE* node, NODE* nodeIn, int depth, int* deepest);
+NODE* removeRelaxed(NODE* node, NODE* target);
+  NODE* removeFirstRelaxed(NODE* node, NODE** first);
+NODE* fixRelaxed(NODE* node);
+int relaxedLimit(int size);
+
+/*
+  BALANCE_POLICY
+  description
+    the scheme used to keep a BINARY_ENGINE tree balanced,
+    chosen through the TreeDataPointers passed to newBinaryTree.
+  data:
+    ADHOC_BALANCE
+                the original scheme, nodes of overly tall branches
+                are re-added lower down the tree by balanceTree.
+    AVL_BALANCE the heights of every node's branches differ by at
+                most one. Lookups are fastest, suited to read heavy
+                trees.
+    RED_BLACK_BALANCE
+                left leaning red-black tree, the colour of each node
+                is held in NODE.balance. Fewer rotations per write
+                than AVL, suited to write heavy trees.
+    TREAP_BALANCE
+                every node is given a random priority, held in
+                NODE.balance, and the tree is kept in heap order of
+                priority. Split and join are cheap.
+    SCAPEGOAT_BALANCE
+                no per node data is needed. When an insertion runs
+                too deep, the branch which has grown lopsided is
+                rebuilt, when enough nodes have been removed the 
+                whole tree is.
+    SPLAY_BALANCE
+                every node looked up, added or modified is moved
+                to the root, so frequently used nodes stay a few
+                steps from it. Lookups change the shape of the
+                tree, so it must not be read by more than one 
+                thread at a time. Only the weight of nodes is 
+                kept, their height is not.
+    RELAXED_BALANCE
+                writes only link and unlink nodes, marking the 
+                nodes they pass. A maintenance thread later fixes
+                up the marked branches into an AVL tree, once 
+                writes pause or the tree grows RELAXED_SLACK 
+                levels taller than it needs to be. Split, join 
+                and union are not supported.
+*/
+enum BALANCE_POLICY_P
+{
+  ADHOC_BALANCE     = 0 ,
+  AVL_BALANCE       = 1 ,
+  RED_BLACK_BALANCE = 2 ,
+  TREAP_BALANCE     = 3 ,
+  SCAPEGOAT_BALANCE = 4 ,
+  SPLAY_BALANCE     = 5 ,
+  RELAXED_BALANCE   = 6
+};
+
+/*
+  updateElement
+  description
+    recalculates the height and weight of a single node from
+    those of its children.
+  params:
+    node      node being updated.
+  return: 
+    height    the new height of the node.
+*/
+int updateElement(NODE* node)
+{
+  int left = elementHeight(getLess(node)), right = elementHeight(getGreater(node));
+  node->height = (left > right ? left : right) + 1;
+  node->weight = elementWeight(getLess(node)) + elementWeight(getGreater(node)) + 1;
+  return node->height;
+}
+
+/*
+  elementHeight
+  description
+    returns the height of a branch.
+  params:
+    node      root of the branch (may be NULL).
+  return: 
+    height    the height of the branch, 0 if empty.
+*/
+int elementHeight(NODE* node)
+{
+  return node ? node->height : 0;
+}
+
+/*
+  elementWeight
+  description
+    returns the number of nodes in a branch.
+  params:
+    node      root of the branch (may be NULL).
+  return: 
+    weight    the number of nodes in the branch, 0 if empty.
+*/
+int elementWeight(NODE* node)
+{
+  return node ? node->weight : 0;
+}
+
+/*
+  rotateLess
+  description
+    rotates a branch so that its greater child becomes its root.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* rotateLess(NODE* node)
+{
+  NODE* greater = getGreater(node);
+  setGreater(node, getLess(greater));
+  setLess(greater, node);
+  updateElement(node);
+  updateElement(greater);
+  return greater;
+}
+
+/*
+  rotateGreater
+  description
+    rotates a branch so that its lesser child becomes its root.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* rotateGreater(NODE* node)
+{
+  NODE* less = getLess(node);
+  setLess(node, getGreater(less));
+  setGreater(less, node);
+  updateElement(node);
+  updateElement(less);
+  return less;
+}
+
+/*
+  joinElement
+  description
+    joins two branches and a node, every key in the lesser branch
+    is ordered before the node and every key in the greater branch
+    after it. The result is kept height balanced, and is built in 
+    time proportional to the difference in branch heights.
+  params:
+    less      lesser branch.
+    node      node placed between the branches.
+    greater   greater branch.
+  return: 
+    node      root of the joined branch.
+*/
+NODE* joinElement(NODE* less, NODE* node, NODE* greater)
+{
+  if(elementHeight(less) > elementHeight(greater) + 1)
+  {
+    return joinGreaterElement(less, node, greater);
+  }
+  if(elementHeight(greater) > elementHeight(less) + 1)
+  {
+    return joinLessElement(less, node, greater);
+  }
+  setLess(node, less);
+  setGreater(node, greater);
+  updateElement(node);
+  return node;
+}
+
+/*
+  joinGreaterElement
+  description
+    joins a short greater branch onto the greater spine 
+    of a taller lesser branch.
+  params:
+    less      taller, lesser branch.
+    node      node placed between the branches.
+    greater   shorter, greater branch.
+  return: 
+    node      root of the joined branch.
+*/
+NODE* joinGreaterElement(NODE* less, NODE* node, NODE* greater)
+{
+  NODE* spine = getGreater(less);
+
+  if(elementHeight(spine) <= elementHeight(greater) + 1)
+  {
+    setLess(node, spine);
+    setGreater(node, greater);
+    updateElement(node);
+    if(elementHeight(node) <= elementHeight(getLess(less)) + 1)
+    {
+      setGreater(less, node);
+      updateElement(less);
+      return less;
+    }
+    setGreater(less, rotateGreater(node));
+    updateElement(less);
+    return rotateLess(less);
+  }
+
+  setGreater(less, joinGreaterElement(spine, node, greater));
+  updateElement(less);
+  if(elementHeight(getGreater(less)) <= elementHeight(getLess(less)) + 1) return less;
+  return rotateLess(less);
+}
+
+/*
+  joinLessElement
+  description
+    joins a short lesser branch onto the lesser spine
+    of a taller greater branch.
+  params:
+    less      shorter, lesser branch.
+    node      node placed between the branches.
+    greater   taller, greater branch.
+  return: 
+    node      root of the joined branch.
+*/
+NODE* joinLessElement(NODE* less, NODE* node, NODE* greater)
+{
+  NODE* spine = getLess(greater);
+
+  if(elementHeight(spine) <= elementHeight(less) + 1)
+  {
+    setLess(node, less);
+    setGreater(node, spine);
+    updateElement(node);
+    if(elementHeight(node) <= elementHeight(getGreater(greater)) + 1)
+    {
+      setLess(greater, node);
+      updateElement(greater);
+      return greater;
+    }
+    setLess(greater, rotateLess(node));
+    updateElement(greater);
+    return rotateGreater(greater);
+  }
+
+  setLess(greater, joinLessElement(less, node, spine));
+  updateElement(greater);
+  if(elementHeight(getLess(greater)) <= elementHeight(getGreater(greater)) + 1) return greater;
+  return rotateGreater(greater);
+}
+
+/*
+  collectElement
+  description
+    writes the nodes of a branch into an array in order.
+  params:
+    node      root of the branch being collected.
+    nodes     array large enough to hold every node in the branch.
+    count     the number of nodes already in the array.
+  return: 
+    count     the number of nodes in the array after collection.
+*/
+int collectElement(NODE* node, NODE** nodes, int count)
+{
+  if(node == NULL) return count;
+  count = collectElement(getLess(node), nodes, count);
+  nodes[count++] = node;
+  return collectElement(getGreater(node), nodes, count);
+}
+
+/*
+  buildElement
+  description
+    links an ordered array of nodes into a balanced branch,
+    which satisfies every BALANCE_POLICY but red-black and
+    treap, which build their own.
+  params:
+    nodes     ordered array of nodes.
+    count     the number of nodes in the array.
+  return: 
+    node      root of the new branch.
+*/
+NODE* buildElement(NODE** nodes, int count)
+{
+  int middle = count / 2;
+  NODE* node;
+  if(count <= 0) return NULL;
+
+  node = nodes[middle];
+  setLess(node, buildElement(nodes, middle));
+  setGreater(node, buildElement(nodes + middle + 1, count - middle - 1));
+  updateElement(node);
+  return node;
+}
+
+/*
+  rebuildElement
+  description
+    relinks a branch into a perfectly balanced shape.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* rebuildElement(NODE* node)
+{
+  int count = elementWeight(node);
+  NODE** nodes;
+
+  if(node == NULL) return NULL;
+  nodes = (NODE**) malloc(count * sizeof(NODE*));
+  if(nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to rebuild tree");
+    PAUSE
+    exit(0);
+  }
+  collectElement(node, nodes, 0);
+  node = buildElement(nodes, count);
+  free(nodes);
+  return node;
+}
+
+/*
+  measureBranch
+  description
+    recalculates the height and weight of every node in a branch.
+  params:
+    node      root of the branch.
+  return: 
+    height    the height of the branch.
+*/
+int measureBranch(NODE* node)
+{
+  if(node == NULL) return 0;
+  measureBranch(getLess(node));
+  measureBranch(getGreater(node));
+  return updateElement(node);
+}
+
+/*
+  compareBranch
+  description
+    compares a node in a branch with one being searched for.
+  params:
+    node      node in the branch.
+    target    node being searched for.
+  return: 
+    comparison
+              0 if they are the same node, otherwise the ordinal
+              comparison of node with target.
+*/
+int compareBranch(NODE* node, NODE* target)
+{
+  return node == target ? 0 : nodeCompareSort(node, target);
+}
+
+/*
+  detachElement
+  description
+    clears the branches of a node which has been taken out of
+    a tree.
+  params:
+    node      the node.
+  return: 
+    node      the node.
+*/
+NODE* detachElement(NODE* node)
+{
+  setLess(node, NULL);
+  setGreater(node, NULL);
+  updateElement(node);
+  return node;
+}
+
+/*
+  insertAvl
+  description
+    adds a node to an AVL branch.
+  params:
+    node      root of the branch.
+    nodeIn    node being added.
+  return: 
+    node      new root of the branch.
+*/
+NODE* insertAvl(NODE* node, NODE* nodeIn)
+{
+  if(node == NULL) return detachElement(nodeIn);
+
+  if(nodeCompareSort(node, nodeIn) > 0) setLess(node, insertAvl(getLess(node), nodeIn));
+  else setGreater(node, insertAvl(getGreater(node), nodeIn));
+  return balanceAvl(node);
+}
+
+/*
+  removeAvl
+  description
+    removes a node from an AVL branch. A node with two branches
+    is replaced by the least node of its greater branch.
+  params:
+    node      root of the branch.
+    target    node being removed.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeAvl(NODE* node, NODE* target)
+{
+  NODE* first;
+  int compare;
+
+  if(node == NULL) return NULL;
+  compare = compareBranch(node, target);
+  if(compare > 0) setLess(node, removeAvl(getLess(node), target));
+  else if(compare < 0) setGreater(node, removeAvl(getGreater(node), target));
+  else
+  {
+    if(getGreater(node) == NULL)
+    {
+      first = getLess(node);
+      detachElement(node);
+      return first;
+    }
+    setGreater(node, removeFirstAvl(getGreater(node), &first));
+    setLess(first, getLess(node));
+    setGreater(first, getGreater(node));
+    detachElement(node);
+    node = first;
+  }
+  return balanceAvl(node);
+}
+
+/*
+  removeFirstAvl
+  description
+    removes the least node from an AVL branch.
+  params:
+    node      root of the branch.
+    first     filled with the removed node.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeFirstAvl(NODE* node, NODE** first)
+{
+  if(getLess(node) == NULL)
+  {
+    *first = node;
+    return getGreater(node);
+  }
+  setLess(node, removeFirstAvl(getLess(node), first));
+  return balanceAvl(node);
+}
+
+/*
+  balanceAvl
+  description
+    restores the AVL property at the root of a branch whose
+    children are AVL branches differing in height by at most two.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* balanceAvl(NODE* node)
+{
+  updateElement(node);
+  if(elementHeight(getLess(node)) > elementHeight(getGreater(node)) + 1)
+  {
+    if(elementHeight(getLess(getLess(node))) < elementHeight(getGreater(getLess(node))))
+    {
+      setLess(node, rotateLess(getLess(node)));
+    }
+    return rotateGreater(node);
+  }
+  if(elementHeight(getGreater(node)) > elementHeight(getLess(node)) + 1)
+  {
+    if(elementHeight(getGreater(getGreater(node))) < elementHeight(getLess(getGreater(node))))
+    {
+      setGreater(node, rotateGreater(getGreater(node)));
+    }
+    return rotateLess(node);
+  }
+  return node;
+}
+
+/*
+  insertRedBlack
+  description
+    adds a node to a left leaning red-black branch. The root of
+    the tree must be coloured black afterwards.
+  params:
+    node      root of the branch.
+    nodeIn    node being added.
+  return: 
+    node      new root of the branch.
+*/
+NODE* insertRedBlack(NODE* node, NODE* nodeIn)
+{
+  if(node == NULL)
+  {
+    nodeIn->balance = RED_NODE;
+    return detachElement(nodeIn);
+  }
+
+  if(nodeCompareSort(node, nodeIn) > 0) setLess(node, insertRedBlack(getLess(node), nodeIn));
+  else setGreater(node, insertRedBlack(getGreater(node), nodeIn));
+  return balanceRedBlack(node);
+}
+
+/*
+  removeRedBlack
+  description
+    removes a node from a left leaning red-black branch. A red
+    link is carried down the search path so that the node is 
+    never removed from a 2-node. The root of the tree must be
+    coloured red beforehand if both its children are black, and
+    black afterwards.
+  params:
+    node      root of the branch.
+    target    node being removed, which must be in the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeRedBlack(NODE* node, NODE* target)
+{
+  NODE* first;
+
+  if(compareBranch(node, target) > 0)
+  {
+    if(!isRed(getLess(node)) && !isRed(getLess(getLess(node)))) node = moveRedLess(node);
+    setLess(node, removeRedBlack(getLess(node), target));
+  }
+  else
+  {
+    if(isRed(getLess(node))) node = rotateRedGreater(node);
+    if(node == target && getGreater(node) == NULL)
+    {
+      detachElement(node);
+      return NULL;
+    }
+    if(!isRed(getGreater(node)) && !isRed(getLess(getGreater(node)))) node = moveRedGreater(node);
+    if(node == target)
+    {
+      setGreater(node, removeFirstRedBlack(getGreater(node), &first));
+      setLess(first, getLess(node));
+      setGreater(first, getGreater(node));
+      first->balance = node->balance;
+      detachElement(node);
+      node = first;
+    }
+    else setGreater(node, removeRedBlack(getGreater(node), target));
+  }
+  return balanceRedBlack(node);
+}
+
+/*
+  removeFirstRedBlack
+  description
+    removes the least node from a left leaning red-black branch.
+  params:
+    node      root of the branch.
+    first     filled with the removed node.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeFirstRedBlack(NODE* node, NODE** first)
+{
+  if(getLess(node) == NULL)
+  {
+    *first = node;
+    return NULL;
+  }
+  if(!isRed(getLess(node)) && !isRed(getLess(getLess(node)))) node = moveRedLess(node);
+  setLess(node, removeFirstRedBlack(getLess(node), first));
+  return balanceRedBlack(node);
+}
+
+/*
+  balanceRedBlack
+  description
+    restores the left leaning red-black properties at the root
+    of a branch on the way back up from an insertion or removal.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* balanceRedBlack(NODE* node)
+{
+  if(isRed(getGreater(node)) && !isRed(getLess(node))) node = rotateRedLess(node);
+  if(isRed(getLess(node)) && isRed(getLess(getLess(node)))) node = rotateRedGreater(node);
+  if(isRed(getLess(node)) && isRed(getGreater(node))) flipColours(node);
+  updateElement(node);
+  return node;
+}
+
+/*
+  rotateRedLess
+  description
+    rotates a red greater link over to the lesser side.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* rotateRedLess(NODE* node)
+{
+  NODE* greater = rotateLess(node);
+  greater->balance = node->balance;
+  node->balance = RED_NODE;
+  return greater;
+}
+
+/*
+  rotateRedGreater
+  description
+    rotates a red lesser link over to the greater side.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* rotateRedGreater(NODE* node)
+{
+  NODE* less = rotateGreater(node);
+  less->balance = node->balance;
+  node->balance = RED_NODE;
+  return less;
+}
+
+/*
+  moveRedLess
+  description
+    makes the lesser child of a branch, or one of its children,
+    red ahead of a removal below it.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* moveRedLess(NODE* node)
+{
+  flipColours(node);
+  if(isRed(getLess(getGreater(node))))
+  {
+    setGreater(node, rotateRedGreater(getGreater(node)));
+    node = rotateRedLess(node);
+    flipColours(node);
+  }
+  return node;
+}
+
+/*
+  moveRedGreater
+  description
+    makes the greater child of a branch, or one of its children,
+    red ahead of a removal below it.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* moveRedGreater(NODE* node)
+{
+  flipColours(node);
+  if(isRed(getLess(getLess(node))))
+  {
+    node = rotateRedGreater(node);
+    flipColours(node);
+  }
+  return node;
+}
+
+/*
+  flipColours
+  description
+    flips the colour of a node and both its children.
+  params:
+    node      the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int flipColours(NODE* node)
+{
+  node->balance = !node->balance;
+  getLess(node)->balance = !getLess(node)->balance;
+  getGreater(node)->balance = !getGreater(node)->balance;
+  return 0;
+}
+
+/*
+  isRed
+  description
+    returns whether a node is red, empty branches are black.
+  params:
+    node      the node (may be NULL).
+  return: 
+    red       1 if the node is red.
+*/
+int isRed(NODE* node)
+{
+  return node != NULL && node->balance == RED_NODE;
+}
+
+/*
+  buildRedBlack
+  description
+    links an ordered array of nodes into a left leaning red-black
+    tree of the least possible height.
+  params:
+    nodes     ordered array of nodes.
+    count     the number of nodes in the array.
+  return: 
+    node      root of the tree.
+*/
+NODE* buildRedBlack(NODE** nodes, int count)
+{
+  long long capacity = 2;
+  int height = 1;
+
+  if(count <= 0) return NULL;
+  //the tallest black height whose complete tree fits the nodes, a
+  //tree of black height h holds from 2^h-1 up to 3^h-1 nodes
+  while((2LL << height) - 1 <= count)
+  {
+    height++;
+    capacity = capacity * 3 + 2;
+  }
+  return buildRedBlackLevel(nodes, count, height, capacity);
+}
+
+/*
+  buildRedBlackLevel
+  description
+    links an ordered array of nodes into a left leaning red-black
+    branch of a given black height, treating it as a 2-3 tree.
+    The root becomes a 2-node (one black node) when the rest of
+    the nodes fit below two branches, otherwise a 3-node (a black 
+    node with a red lesser child) with three branches.
+  params:
+    nodes     ordered array of nodes.
+    count     the number of nodes in the array.
+    height    black height of the branch.
+    capacity  the most nodes a branch of this height can hold.
+  return: 
+    node      root of the branch.
+*/
+NODE* buildRedBlackLevel(NODE** nodes, int count, int height, long long capacity)
+{
+  long long below = (capacity + 1) / 3 - 1;
+  int less, middle, greater;
+  NODE *node, *red;
+
+  if(height == 0) return NULL;
+  if(count - 1 <= 2 * below)
+  {
+    less = (count - 1) / 2;
+    node = nodes[less];
+    setLess(node, buildRedBlackLevel(nodes, less, height - 1, below));
+    setGreater(node, buildRedBlackLevel(nodes + less + 1, count - less - 1, height - 1, below));
+  }
+  else
+  {
+    less = (count - 2) / 3;
+    middle = (count - 2 - less) / 2;
+    greater = count - 2 - less - middle;
+    red = nodes[less];
+    setLess(red, buildRedBlackLevel(nodes, less, height - 1, below));
+    setGreater(red, buildRedBlackLevel(nodes + less + 1, middle, height - 1, below));
+    red->balance = RED_NODE;
+    updateElement(red);
+
+    node = nodes[less + middle + 1];
+    setLess(node, red);
+    setGreater(node, buildRedBlackLevel(nodes + less + middle + 2, greater, height - 1, below));
+  }
+  node->balance = BLACK_NODE;
+  updateElement(node);
+  return node;
+}
+
+/*
+  joinRedBlack
+  description
+    joins two left leaning red-black branches and a node, every 
+    key in the lesser branch is ordered before the node and every
+    key in the greater branch after it. The node is added as a 
+    red node on the spine of the branch of greater black height,
+    at the level of the other branch, and fixed up as an inserted
+    node would be. Measuring the black heights takes time 
+    proportional to the height of the branches.
+  params:
+    less      lesser branch.
+    node      node placed between the branches.
+    greater   greater branch.
+  return: 
+    node      root of the joined branch, coloured black.
+*/
+NODE* joinRedBlack(NODE* less, NODE* node, NODE* greater)
+{
+  int lessHeight, greaterHeight;
+
+  //a red root may be coloured black, which leaves the branch a
+  //left leaning red-black branch one black node taller
+  if(isRed(less)) less->balance = BLACK_NODE;
+  if(isRed(greater)) greater->balance = BLACK_NODE;
+  lessHeight = blackHeight(less);
+  greaterHeight = blackHeight(greater);
+
+  if(lessHeight > greaterHeight)
+  {
+    node = joinGreaterRedBlack(less, lessHeight, node, greater, greaterHeight);
+  }
+  else if(greaterHeight > lessHeight)
+  {
+    node = joinLessRedBlack(less, lessHeight, node, greater, greaterHeight);
+  }
+  else
+  {
+    setLess(node, less);
+    setGreater(node, greater);
+    updateElement(node);
+  }
+  node->balance = BLACK_NODE;
+  return node;
+}
+
+/*
+  joinGreaterRedBlack
+  description
+    joins a greater branch of lower black height onto the 
+    greater spine of a lesser branch.
+  params:
+    less      lesser branch, or the part of its spine reached.
+    height    black height of less.
+    node      node placed between the branches.
+    greater   greater branch, whose root is black.
+    greaterHeight
+              black height of greater.
+  return: 
+    node      new root of the lesser branch.
+*/
+NODE* joinGreaterRedBlack(NODE* less, int height, NODE* node, NODE* greater, int greaterHeight)
+{
+  if(height == greaterHeight && !isRed(less))
+  {
+    setLess(node, less);
+    setGreater(node, greater);
+    node->balance = RED_NODE;
+    updateElement(node);
+    return node;
+  }
+  setGreater(less, joinGreaterRedBlack(getGreater(less), height - !isRed(less), node, greater, greaterHeight));
+  return balanceRedBlack(less);
+}
+
+/*
+  joinLessRedBlack
+  description
+    joins a lesser branch of lower black height onto the 
+    lesser spine of a greater branch.
+  params:
+    less      lesser branch, whose root is black.
+    lessHeight
+              black height of less.
+    node      node placed between the branches.
+    greater   greater branch, or the part of its spine reached.
+    height    black height of greater.
+  return: 
+    node      new root of the greater branch.
+*/
+NODE* joinLessRedBlack(NODE* less, int lessHeight, NODE* node, NODE* greater, int height)
+{
+  if(height == lessHeight && !isRed(greater))
+  {
+    setLess(node, less);
+    setGreater(node, greater);
+    node->balance = RED_NODE;
+    updateElement(node);
+    return node;
+  }
+  setLess(greater, joinLessRedBlack(less, lessHeight, node, getLess(greater), height - !isRed(greater)));
+  return balanceRedBlack(greater);
+}
+
+/*
+  blackHeight
+  description
+    counts the black nodes on the path from the root of a left
+    leaning red-black branch to its lowest lesser node, which 
+    every path through the branch holds as many of.
+  params:
+    node      root of the branch (may be NULL).
+  return: 
+    height    the black height of the branch, 0 if empty.
+*/
+int blackHeight(NODE* node)
+{
+  int height = 0;
+
+  for(; node != NULL; node = getLess(node)) height += !isRed(node);
+  return height;
+}
+
+/*
+  insertTreap
+  description
+    adds a node, whose priority has already been set, to a treap
+    branch. It is placed as a leaf and rotated up past any node
+    of lower priority.
+  params:
+    node      root of the branch.
+    nodeIn    node being added.
+  return: 
+    node      new root of the branch.
+*/
+NODE* insertTreap(NODE* node, NODE* nodeIn)
+{
+  if(node == NULL) return detachElement(nodeIn);
+
+  if(nodeCompareSort(node, nodeIn) > 0)
+  {
+    setLess(node, insertTreap(getLess(node), nodeIn));
+    if(getLess(node)->balance > node->balance) return rotateGreater(node);
+  }
+  else
+  {
+    setGreater(node, insertTreap(getGreater(node), nodeIn));
+    if(getGreater(node)->balance > node->balance) return rotateLess(node);
+  }
+  updateElement(node);
+  return node;
+}
+
+/*
+  removeTreap
+  description
+    removes a node from a treap branch, its branches are merged
+    in its place.
+  params:
+    node      root of the branch.
+    target    node being removed.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeTreap(NODE* node, NODE* target)
+{
+  NODE* merged;
+  int compare;
+
+  if(node == NULL) return NULL;
+  compare = compareBranch(node, target);
+  if(compare == 0)
+  {
+    merged = mergeTreap(getLess(node), getGreater(node));
+    detachElement(node);
+    return merged;
+  }
+  if(compare > 0) setLess(node, removeTreap(getLess(node), target));
+  else setGreater(node, removeTreap(getGreater(node), target));
+  updateElement(node);
+  return node;
+}
+
+/*
+  joinTreap
+  description
+    joins two treap branches and a node, every key in the lesser
+    branch is ordered before the node and every key in the 
+    greater branch after it. The node sinks below any root of
+    higher priority.
+  params:
+    less      lesser branch.
+    node      node placed between the branches.
+    greater   greater branch.
+  return: 
+    node      root of the joined branch.
+*/
+NODE* joinTreap(NODE* less, NODE* node, NODE* greater)
+{
+  int lessPriority = less ? less->balance : -1;
+  int greaterPriority = greater ? greater->balance : -1;
+
+  if(node->balance >= lessPriority && node->balance >= greaterPriority)
+  {
+    setLess(node, less);
+    setGreater(node, greater);
+    updateElement(node);
+    return node;
+  }
+  if(lessPriority > greaterPriority)
+  {
+    setGreater(less, joinTreap(getGreater(less), node, greater));
+    updateElement(less);
+    return less;
+  }
+  setLess(greater, joinTreap(less, node, getLess(greater)));
+  updateElement(greater);
+  return greater;
+}
+
+/*
+  mergeTreap
+  description
+    joins two treap branches without a node between them.
+  params:
+    less      lesser branch.
+    greater   greater branch.
+  return: 
+    node      root of the merged branch.
+*/
+NODE* mergeTreap(NODE* less, NODE* greater)
+{
+  if(less == NULL) return greater;
+  if(greater == NULL) return less;
+
+  if(less->balance > greater->balance)
+  {
+    setGreater(less, mergeTreap(getGreater(less), greater));
+    updateElement(less);
+    return less;
+  }
+  setLess(greater, mergeTreap(less, getLess(greater)));
+  updateElement(greater);
+  return greater;
+}
+
+/*
+  buildTreap
+  description
+    gives an ordered array of nodes new priorities and links them
+    into a treap. Each node is pushed onto the greater spine of 
+    the treap built so far, taking the nodes of lower priority 
+    off the spine as its lesser branch.
+  params:
+    nodes     ordered array of nodes.
+    count     the number of nodes in the array.
+  return: 
+    node      root of the treap.
+*/
+NODE* buildTreap(NODE** nodes, int count)
+{
+  NODE** spine;
+  NODE* last;
+  int i, top = 0;
+
+  if(count <= 0) return NULL;
+  spine = (NODE**) malloc(count * sizeof(NODE*));
+  if(spine == NULL)
+  {
+    printf("sufficient memory could not be allocated to build treap");
+    PAUSE
+    exit(0);
+  }
+
+  for(i = 0; i < count; i++)
+  {
+    nodes[i]->balance = treapPriority();
+    setGreater(nodes[i], NULL);
+    last = NULL;
+    while(top > 0 && spine[top - 1]->balance < nodes[i]->balance) last = spine[--top];
+    setLess(nodes[i], last);
+    if(top > 0) setGreater(spine[top - 1], nodes[i]);
+    spine[top++] = nodes[i];
+  }
+  last = spine[0];
+  free(spine);
+  measureBranch(last);
+  return last;
+}
+
+/*
+  treapPriority
+  description
+    draws a random treap priority.
+  params:
+    void
+  return: 
+    priority  a non negative random priority.
+*/
+int treapPriority(void)
+{
+  //rand may give as few as 15 bits, two are combined unsigned so
+  //that the shift cannot overflow
+  return (int) ((((unsigned int) rand() << 15) ^ (unsigned int) rand()) & 0x3FFFFFFF);
+}
+
+/*
+  insertScapegoat
+  description
+    adds a node to a scapegoat branch. If the node is placed
+    deeper than the limit, the lowest node on its path with a 
+    branch holding more than 2/3 of its nodes is rebuilt.
+  params:
+    node      root of the branch.
+    nodeIn    node being added.
+    depth     depth of the branch in the tree.
+    limit     the greatest depth allowed.
+    unbalanced
+              set while a scapegoat is still to be found.
+  return: 
+    node      new root of the branch.
+*/
+NODE* insertScapegoat(NODE* node, NODE* nodeIn, int depth, int limit, int* unbalanced)
+{
+  NODE* child;
+
+  if(node == NULL)
+  {
+    *unbalanced = depth > limit;
+    return detachElement(nodeIn);
+  }
+
+  if(nodeCompareSort(node, nodeIn) > 0) setLess(node, child = insertScapegoat(getLess(node), nodeIn, depth + 1, limit, unbalanced));
+  else setGreater(node, child = insertScapegoat(getGreater(node), nodeIn, depth + 1, limit, unbalanced));
+  updateElement(node);
+
+  if(*unbalanced && 3 * elementWeight(child) > 2 * elementWeight(node))
+  {
+    *unbalanced = 0;
+    return rebuildElement(node);
+  }
+  return node;
+}
+
+/*
+  removeScapegoat
+  description
+    removes a node from a scapegoat branch. A node with two 
+    branches is replaced by the least node of its greater branch.
+  params:
+    node      root of the branch.
+    target    node being removed.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeScapegoat(NODE* node, NODE* target)
+{
+  NODE* first;
+  int compare;
+
+  if(node == NULL) return NULL;
+  compare = compareBranch(node, target);
+  if(compare > 0) setLess(node, removeScapegoat(getLess(node), target));
+  else if(compare < 0) setGreater(node, removeScapegoat(getGreater(node), target));
+  else
+  {
+    if(getGreater(node) == NULL)
+    {
+      first = getLess(node);
+      detachElement(node);
+      return first;
+    }
+    setGreater(node, removeFirstScapegoat(getGreater(node), &first));
+    setLess(first, getLess(node));
+    setGreater(first, getGreater(node));
+    detachElement(node);
+    node = first;
+  }
+  updateElement(node);
+  return node;
+}
+
+/*
+  removeFirstScapegoat
+  description
+    removes the least node from a scapegoat branch.
+  params:
+    node      root of the branch.
+    first     filled with the removed node.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeFirstScapegoat(NODE* node, NODE** first)
+{
+  if(getLess(node) == NULL)
+  {
+    *first = node;
+    return getGreater(node);
+  }
+  setLess(node, removeFirstScapegoat(getLess(node), first));
+  updateElement(node);
+  return node;
+}
+
+/*
+  scapegoatLimit
+  description
+    returns the greatest depth allowed in a scapegoat tree, the
+    log base 3/2 of the most nodes it has held since it was last
+    rebuilt.
+  params:
+    size      the most nodes held.
+  return: 
+    limit     the greatest depth allowed.
+*/
+int scapegoatLimit(int size)
+{
+  double power = 1.0;
+  int limit = 0;
+
+  while(power < size)
+  {
+    power *= 1.5;
+    limit++;
+  }
+  return limit;
+}
+
+/*
+  insertSplay
+  description
+    adds a node to a splay branch. The branch is splayed about
+    the node and split at its root, the node becomes the new 
+    root with the two halves as its branches.
+  params:
+    node      root of the branch.
+    nodeIn    node being added.
+  return: 
+    node      new root of the branch (nodeIn).
+*/
+NODE* insertSplay(NODE* node, NODE* nodeIn)
+{
+  detachElement(nodeIn);
+  if(node == NULL) return nodeIn;
+
+  node = splayElement(node, &compareSplayNode, nodeIn);
+  if(compareSplayNode(node, nodeIn) > 0)
+  {
+    setLess(nodeIn, getLess(node));
+    setGreater(nodeIn, node);
+    setLess(node, NULL);
+  }
+  else
+  {
+    setGreater(nodeIn, getGreater(node));
+    setLess(nodeIn, node);
+    setGreater(node, NULL);
+  }
+  updateElement(node);
+  updateElement(nodeIn);
+  return nodeIn;
+}
+
+/*
+  removeSplay
+  description
+    removes a node from a splay branch. The node is splayed to 
+    the root, and the greatest node of its lesser branch is 
+    splayed up to take its place.
+  params:
+    node      root of the branch.
+    target    node being removed.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeSplay(NODE* node, NODE* target)
+{
+  NODE* rest;
+
+  if(node == NULL) return NULL;
+  node = splayElement(node, &compareSplayNode, target);
+  if(node != target) return node;
+
+  if(getLess(node) == NULL) rest = getGreater(node);
+  else
+  {
+    //every node of the lesser branch is less than the target, so
+    //the greatest is splayed up and has no greater branch
+    rest = splayElement(getLess(node), &compareSplayNode, target);
+    setGreater(rest, getGreater(node));
+    updateElement(rest);
+  }
+  detachElement(node);
+  return rest;
+}
+
+/*
+  joinSplay
+  description
+    joins two splay branches and a node between them. Splay
+    trees keep no balance, so the node simply becomes the root.
+  params:
+    less      lesser branch.
+    node      node placed between the branches.
+    greater   greater branch.
+  return: 
+    node      root of the joined branch.
+*/
+NODE* joinSplay(NODE* less, NODE* node, NODE* greater)
+{
+  setLess(node, less);
+  setGreater(node, greater);
+  updateElement(node);
+  return node;
+}
+
+/*
+  splayElement
+  description
+    top down splay. The branch is descended towards the target,
+    pairs of nodes on the same side are rotated, and the nodes
+    passed are hung on lesser and greater trees which become 
+    the branches of the last node reached. The weights of the
+    nodes on the edges of these trees are put right afterwards,
+    from the top down.
+  params:
+    node      root of the branch.
+    compare   compares a node with the target.
+    target    the value being searched for.
+  return: 
+    node      new root of the branch, the node matching the 
+              target, or the last node on the way to it.
+*/
+NODE* splayElement(NODE* node, int (*compare)(NODE* node, void* target), void* target)
+{
+  NODE header, *less = &header, *greater = &header, *next;
+  int lessWeight = 0, greaterWeight = 0, comparison;
+
+  if(node == NULL) return NULL;
+  header.less = header.greater = NODE_NONE;
+  while((comparison = compare(node, target)) != 0)
+  {
+    if(comparison > 0)
+    {
+      if(getLess(node) == NULL) break;
+      if(compare(getLess(node), target) > 0)
+      {
+        next = getLess(node);
+        setLess(node, getGreater(next));
+        setGreater(next, node);
+        node->weight = elementWeight(getLess(node)) + elementWeight(getGreater(node)) + 1;
+        node = next;
+        if(getLess(node) == NULL) break;
+      }
+      setLess(greater, node);
+      greater = node;
+      node = getLess(node);
+      greaterWeight += elementWeight(getGreater(greater)) + 1;
+    }
+    else
+    {
+      if(getGreater(node) == NULL) break;
+      if(compare(getGreater(node), target) < 0)
+      {
+        next = getGreater(node);
+        setGreater(node, getLess(next));
+        setLess(next, node);
+        node->weight = elementWeight(getLess(node)) + elementWeight(getGreater(node)) + 1;
+        node = next;
+        if(getGreater(node) == NULL) break;
+      }
+      setGreater(less, node);
+      less = node;
+      node = getGreater(node);
+      lessWeight += elementWeight(getLess(less)) + 1;
+    }
+  }
+  lessWeight += elementWeight(getLess(node));
+  greaterWeight += elementWeight(getGreater(node));
+  node->weight = lessWeight + greaterWeight + 1;
+
+  setGreater(less, NULL);
+  setLess(greater, NULL);
+  for(next = getGreater(&header); next != NULL; next = getGreater(next))
+  {
+    next->weight = lessWeight;
+    lessWeight -= elementWeight(getLess(next)) + 1;
+  }
+  for(next = getLess(&header); next != NULL; next = getLess(next))
+  {
+    next->weight = greaterWeight;
+    greaterWeight -= elementWeight(getGreater(next)) + 1;
+  }
+
+  setGreater(less, getLess(node));
+  setLess(greater, getGreater(node));
+  setLess(node, getGreater(&header));
+  setGreater(node, getLess(&header));
+  return node;
+}
+
+/*
+  compareSplayNode
+  description
+    splay comparison of a node with a node being searched for.
+    The keys held in the nodes are compared directly, rather
+    than through their values, as splaying compares each node
+    on the path twice.
+  params:
+    node      node in the branch.
+    target    node being searched for.
+  return: 
+    comparison
+              0 if they are the same node, otherwise the ordinal
+              comparison of node with target.
+*/
+int compareSplayNode(NODE* node, void* target)
+{
+  int compare;
+  if(node == target) return 0;
+  compare = strcmp(node->key, ((NODE*) target)->key);
+  return compare ? compare : node->index - ((NODE*) target)->index;
+}
+
+/*
+  compareSplayKey
+  description
+    splay comparison of a node with a key being searched for.
+  params:
+    node      node in the branch.
+    target    key being searched for.
+  return: 
+    comparison
+              the ordinal comparison of the keys.
+*/
+int compareSplayKey(NODE* node, void* target)
+{
+  return strcmp(node->key, (char*) target);
+}
+
+/*
+  insertRelaxed
+  description
+    adds a node to a relaxed branch without rebalancing it. The
+    nodes passed are marked for the next fix up.
+  params:
+    node      root of the branch.
+    nodeIn    node being added.
+    depth     depth of the branch in the tree.
+    deepest   filled with the depth the node is placed at.
+  return: 
+    node      new root of the branch.
+*/
+NODE* insertRelaxed(NODE* node, NODE* nodeIn, int depth, int* deepest)
+{
+  if(node == NULL)
+  {
+    *deepest = depth;
+    nodeIn->balance = 0;
+    return detachElement(nodeIn);
+  }
+
+  if(nodeCompareSort(node, nodeIn) > 0) setLess(node, insertRelaxed(getLess(node), nodeIn, depth + 1, deepest));
+  else setGreater(node, insertRelaxed(getGreater(node), nodeIn, depth + 1, deepest));
+  node->balance = RELAXED_DIRTY;
+  updateElement(node);
+  return node;
+}
+
+/*
+  removeRelaxed
+  description
+    removes a node from a relaxed branch without rebalancing 
+    it. A node with two branches is replaced by the least node
+    of its greater branch. The nodes passed are marked for the
+    next fix up.
+  params:
+    node      root of the branch.
+    target    node being removed.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeRelaxed(NODE* node, NODE* target)
+{
+  NODE* first;
+  int compare;
+
+  if(node == NULL) return NULL;
+  compare = compareBranch(node, target);
+  if(compare > 0) setLess(node, removeRelaxed(getLess(node), target));
+  else if(compare < 0) setGreater(node, removeRelaxed(getGreater(node), target));
+  else
+  {
+    if(getGreater(node) == NULL)
+    {
+      first = getLess(node);
+      detachElement(node);
+      return first;
+    }
+    setGreater(node, removeFirstRelaxed(getGreater(node), &first));
+    setLess(first, getLess(node));
+    setGreater(first, getGreater(node));
+    detachElement(node);
+    node = first;
+  }
+  node->balance = RELAXED_DIRTY;
+  updateElement(node);
+  return node;
+}
+
+/*
+  removeFirstRelaxed
+  description
+    removes the least node from a relaxed branch.
+  params:
+    node      root of the branch.
+    first     filled with the removed node.
+  return: 
+    node      new root of the branch.
+*/
+NODE* removeFirstRelaxed(NODE* node, NODE** first)
+{
+  if(getLess(node) == NULL)
+  {
+    *first = node;
+    return getGreater(node);
+  }
+  setLess(node, removeFirstRelaxed(getLess(node), first));
+  node->balance = RELAXED_DIRTY;
+  updateElement(node);
+  return node;
+}
+
+/*
+  fixRelaxed
+  description
+    turns the marked parts of a relaxed branch back into an AVL
+    branch, from the bottom up. Only marked nodes are visited.
+    A node whose fixed branches differ in height by two is 
+    rotated, one whose branches differ by more is rebuilt.
+  params:
+    node      root of the branch.
+  return: 
+    node      new root of the branch.
+*/
+NODE* fixRelaxed(NODE* node)
+{
+  int difference;
+
+  if(node == NULL || node->balance != RELAXED_DIRTY) return node;
+  node->balance = 0;
+  setLess(node, fixRelaxed(getLess(node)));
+  setGreater(node, fixRelaxed(getGreater(node)));
+
+  difference = elementHeight(getLess(node)) - elementHeight(getGreater(node));
+  if(difference > 2 || difference < -2) return rebuildElement(node);
+  return balanceAvl(node);
+}
+
+/*
+  relaxedLimit
+  description
+    returns the greatest depth a relaxed tree may reach before
+    it is fixed up while still being written to.
+  params:
+    size      the number of nodes in the tree.
+  return: 
+    limit     the least possible height of the tree plus 
+              RELAXED_SLACK.
+*/
+int relaxedLimit(int size)
+{
+  int limit = RELAXED_SLACK;
+
+  while(size > 0)
+  {
+    size >>= 1;
+    limit++;
+  }
+  return limit;
+}
+
+#endif
@@ -1,37 +1,188 @@
 
 #include"CommonHeader.h"
 #include"Node.h"
+#include"Balance.h"
+#include"Snapshot.h"
+#include"BTree.h"
+#include"RadixTree.h"
+#include"SkipList.h"
+#include"Thread.h"
+#include"LookupTable.h"
+#include"Bitmap.h"
+
+//branches with fewer nodes than this are merged by a single thread
+#define PARALLEL_GRAIN 4096
+//number of searches interleaved by findMany
+#define FIND_GROUP 16
+//number of writes after which a snapshot is rebuilt
+#define SNAPSHOT_THRESHOLD 1024
+//bits of the sort key placed by each pass of radixSortElements
+#define RADIX_BITS 11
+//milliseconds between checks for relaxed trees needing a fix up
+#define RELAXED_INTERVAL 10
+//the layout of a tree is measured after it has seen one write for
+//every COMPACT_INTERVAL elements, and it is compacted if more than
+//COMPACT_THRESHOLD percent of its branches lead to another block
+#define COMPACT_INTERVAL 4
+#define COMPACT_THRESHOLD 50
+//number of completions printed by printCompletions
+#define COMPLETION_COUNT 10
 
 typedef struct TREE_P TREE;
 typedef struct TreeDataPointersP TreeDataPointers;
 typedef enum MOD_TYPE_P MOD_TYPE;
 typedef enum FIND_BY_P FIND_BY;
+typedef enum TREE_ENGINE_P TREE_ENGINE;
+typedef struct TreeEnginePointersP TreeEnginePointers;
+typedef struct BalancePointersP BalancePointers;
+typedef struct RELAXED_P RELAXED;
 
 TREE* newBinaryTree(TreeDataPointers* treeDataPointers, FunctionPointers* nodeFunctionPointers);
 
 int initTree(TREE* tree, FunctionPointers* functionPointers, TreeDataPointers* treeDataPointers);
 int deleteTree(TREE* tree);
+  int deleteIndexes(TREE* tree);
 int saveTree(TREE* tree);
 
 int newElement(TREE* tree, FILE* file);
 int addElement(TREE* tree, NODE* nodeIn, int balanceRun);
-int balanceTree(TREE* tree, NODE** node);
+int addElements(TREE* tree, NODE** nodes, size_t n);
+int removeElements(TREE* tree, char** keys, size_t n);
+int balanceTree(TREE* tree, int* node);
+
+int compareElements(const void* a, const void* b);
+int compareKeys(const void* a, const void* b);
 
 NODE* modifyElement(TREE* tree, MOD_TYPE modType);
 
 int measureElement(TREE* tree, NODE* node);
 
-int getElementP(TREE* tree, NODE*** ptr_branch);
-NODE** getElement(NODE** ptr_branch, FIND_BY type, void* value);
+TREE* newEmptyTree(TREE* tree);
+TREE* splitTree(TREE* tree, char* key);
+TREE* joinTrees(TREE* a, TREE* b);
+TREE* unionTrees(TREE* a, TREE* b);
+int joinSupported(TREE* a, TREE* b);
+
+NODE* joinBranches(NODE* less, NODE* greater, JOIN_FUNCTION join);
+NODE* splitLastElement(NODE* node, NODE** last, JOIN_FUNCTION join);
+int splitElement(NODE* node, char* key, NODE** less, NODE** equal, NODE** greater, JOIN_FUNCTION join);
+NODE* unionElement(NODE* a, NODE* b, int depth, JOIN_FUNCTION join);
+THREAD_RETURN THREAD_CALL unionThread(void* argument);
+int reindexElement(NODE* node, char* key);
+
+int getElementP(TREE* tree, int** ptr_branch);
+int* getElement(int* ptr_branch, FIND_BY type, void* value);
+int findMany(TREE* tree, char** keys, size_t n, NODE** results);
+
+int freezeTree(TREE* tree);
+NODE* getSnapshotElement(TREE* tree, char* key);
+int recordWrite(TREE* tree, int count, int reordered);
+
+int compactTree(TREE* tree);
+NODE* compactElement(NODE* node);
+int maintainLayout(TREE* tree);
+int measureLayout(NODE* node, int* scattered);
 
 int getIndexIn(void);
 
 int printEntry(TREE* tree);
 
 int printTree(TREE* tree, FIND_BY type, void* target);
-int printElement(NODE* node, FIND_BY type, void* target);
+int renderTree(TREE* tree, FIND_BY type, void* target, FILE* file);
+int renderElement(NODE* node, FIND_BY type, void* target, RENDERER* renderer);
+int fitsElement(NODE* node, FIND_BY type, void* target);
+int scanTree(TREE* tree, FIND_BY type, void* target, NODE** results);
+int completeTree(TREE* tree, FIND_BY type, char* prefix, int k, char** names, int* counts);
+int printCompletions(TREE* tree, FIND_BY type, char* prefix);
+int buildColumns(TREE* tree);
+int lookupTree(TREE* tree, FIND_BY type, void* target, NODE** results, int limit);
+int buildLookup(TREE* tree);
+int indexElement(TREE* tree, NODE* node);
+int unindexElement(TREE* tree, NODE* node);
+BITMAP* bitmapTree(TREE* tree, FIND_BY type, void* target);
+BITMAP* bitmapTreeAll(TREE* tree);
+int bitmapElements(BITMAP* bitmap, NODE** results);
+int countTree(TREE* tree, FIND_BY type, void* target);
+BITMAP_INDEX* getBitmapIndex(TREE* tree, FIND_BY type);
+int buildBitmaps(TREE* tree);
+int rangeTree(TREE* tree, char* prefix, int (*visit)(int* ptr_branch, void* context), void* context);
+int rangeElement(int* ptr_branch, char* prefix, int length, int (*visit)(int* ptr_branch, void* context), void* context);
+int rangeVisit(int* ptr_branch, void* context);
+int countRange(TREE* tree, char* prefix);
+int countFromElement(NODE* node, char* prefix, int length);
+int countToElement(NODE* node, char* prefix, int length);
+int radixSortElements(NODE** nodes, int count, FIND_BY type);
 int createTitleString(TREE* tree, FIND_BY type, char titleString[]);
 
+TreeEnginePointers* getEngine(TREE_ENGINE engine);
+BalancePointers* getBalance(BALANCE_POLICY policy);
+int* scanElement(TREE* tree, FIND_BY type, void* value);
+int matchVisit(int* ptr_branch, void* context);
+int collectVisit(int* ptr_branch, void* context);
+int printVisit(int* ptr_branch, void* context);
+int saveVisit(int* ptr_branch, void* context);
+
+int insertBinaryElement(TREE* tree, NODE* node);
+int removeBinaryElement(TREE* tree, int* ptr_branch);
+int* findBinaryElement(TREE* tree, FIND_BY type, void* value);
+int* searchBinaryElement(TREE* tree, char* key);
+int walkBinaryElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context);
+int walkElement(int* ptr_branch, int (*visit)(int* ptr_branch, void* context), void* context);
+int clearBinaryElement(TREE* tree);
+
+int insertBTreeElement(TREE* tree, NODE* node);
+int removeBTreeElement(TREE* tree, int* ptr_branch);
+int* findBTreeElement(TREE* tree, FIND_BY type, void* value);
+int* searchBTreeElement(TREE* tree, char* key);
+int walkBTreeElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context);
+int clearBTreeElement(TREE* tree);
+
+int insertArtElement(TREE* tree, NODE* node);
+int removeArtElement(TREE* tree, int* ptr_branch);
+int* findArtElement(TREE* tree, FIND_BY type, void* value);
+int* searchArtElement(TREE* tree, char* key);
+int walkArtElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context);
+int clearArtElement(TREE* tree);
+
+int insertSkipElement(TREE* tree, NODE* node);
+int removeSkipElement(TREE* tree, int* ptr_branch);
+int* findSkipElement(TREE* tree, FIND_BY type, void* value);
+int* searchSkipElement(TREE* tree, char* key);
+int walkSkipElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context);
+int clearSkipElement(TREE* tree);
+
+int insertAdhocElement(TREE* tree, NODE* node);
+int removeAdhocElement(TREE* tree, int* ptr_branch);
+int* findBalancedElement(TREE* tree, FIND_BY type, void* value);
+int* searchBalancedElement(TREE* tree, char* key);
+
+int insertAvlElement(TREE* tree, NODE* node);
+int removeAvlElement(TREE* tree, int* ptr_branch);
+
+int insertRedBlackElement(TREE* tree, NODE* node);
+int removeRedBlackElement(TREE* tree, int* ptr_branch);
+
+int insertTreapElement(TREE* tree, NODE* node);
+int removeTreapElement(TREE* tree, int* ptr_branch);
+
+int insertScapegoatElement(TREE* tree, NODE* node);
+int removeScapegoatElement(TREE* tree, int* ptr_branch);
+
+int insertSplayElement(TREE* tree, NODE* node);
+int removeSplayElement(TREE* tree, int* ptr_branch);
+int* findSplayElement(TREE* tree, FIND_BY type, void* value);
+int* searchSplayElement(TREE* tree, char* key);
+
+int insertRelaxedElement(TREE* tree, NODE* node);
+int removeRelaxedElement(TREE* tree, int* ptr_branch);
+int* findRelaxedElement(TREE* tree, FIND_BY type, void* value);
+int* searchRelaxedElement(TREE* tree, char* key);
+int initRelaxed(TREE* tree);
+int deleteRelaxed(TREE* tree);
+THREAD_RETURN THREAD_CALL maintenanceThread(void* argument);
+int lockTree(TREE* tree);
+int unlockTree(TREE* tree);
+
 /*
   MOD_TYPE
   description
@@ -64,6 +215,11 @@ enum MOD_TYPE_P
                 thus requires the calling of an appropriate function
                 provided by the value.
     INDEX       an element is to be located by index.
+    LEAVES      the elements to be printed are those without
+                branches, the value the print menu gives when
+                asked for leaves. Being negative, it also keeps
+                FIND_BY signed, so it compares cleanly with the
+                int types the value functions return.
 
     *OTHER*     other values can be held by this data-type but are processed
                 by functions provided elseware.
@@ -72,38 +228,342 @@ enum MOD_TYPE_P
 */
 enum FIND_BY_P 
 { 
+  LEAVES  = -1,
   BY_KEY  = 0 , 
   INDEX   = 1
 };
+
+/*
+  TREE_ENGINE
+  description
+    the structure used to hold the elements of a tree, chosen 
+    through the TreeDataPointers passed to newBinaryTree.
+  data:
+    BINARY_ENGINE
+                elements are linked to one another as a binary
+                tree through their less and greater branches.
+    BTREE_ENGINE
+                elements are held in the nodes of a b-tree (as
+                defined in BTree.h), many to a node, which keeps
+                the tree shallow and descents cache friendly.
+    ART_ENGINE  elements are held in an adaptive radix tree (as
+                defined in RadixTree.h) indexed by the characters
+                of their keys, so that a descent costs one step
+                per key character and shared prefixes (common
+                last names) are only compared once.
+    SKIPLIST_ENGINE
+                elements are held in a lock free skip list (as
+                defined in SkipList.h). Any number of threads may
+                add and remove elements at once, as there is no
+                root to contend on and no rebalancing.
+*/
+enum TREE_ENGINE_P
+{
+  BINARY_ENGINE   = 0 ,
+  BTREE_ENGINE    = 1 ,
+  ART_ENGINE      = 2 ,
+  SKIPLIST_ENGINE = 3
+};
+
+/*
+  TreeEnginePointers
+  description
+    struct containing the function pointers which carry out
+    the operations of a TREE_ENGINE. Elements are handed out
+    as pointers to the slot holding them (ptr_branch).
+  data:
+    insert      places a node in the structure.
+                  param   -tree being added to
+                          -node being added
+                  return  -NULL
+    remove      takes a node out of the structure without
+                freeing it.
+                  param   -tree being removed from
+                          -slot holding the node
+                  return  -NULL
+    find        finds a node by a FIND_BY comparison.
+                  param   -tree being searched
+                          -type of comparison
+                          -value being compared against
+                  return  -slot holding the node, or NULL
+    search      finds a node by key.
+                  param   -tree being searched
+                          -key being searched for
+                  return  -slot holding the node, or NULL
+    walk        visits every node in order.
+                  param   -tree being walked
+                          -function called with each slot,
+                           returning nonzero stops the walk
+                          -passed on to the function
+                  return  -nonzero if the walk was stopped
+    clear       frees the structure and every node in it.
+                  param   -tree being cleared
+                  return  -NULL
+*/
+struct TreeEnginePointersP
+{
+  int (*insert)(TREE* tree, NODE* node);
+  int (*remove)(TREE* tree, int* ptr_branch);
+  int* (*find)(TREE* tree, FIND_BY type, void* value);
+  int* (*search)(TREE* tree, char* key);
+  int (*walk)(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context);
+  int (*clear)(TREE* tree);
+};
+
+/*
+  BalancePointers
+  description
+    struct containing the function pointers which keep a
+    BINARY_ENGINE tree balanced under a BALANCE_POLICY.
+  data:
+    insert      links a node into the tree and rebalances it.
+                  param   -tree being added to
+                          -node being added
+                  return  -NULL
+    remove      unlinks a node from the tree, without freeing
+                it, and rebalances it.
+                  param   -tree being removed from
+                          -slot holding the node
+                  return  -NULL
+    find        finds a node by a FIND_BY comparison, self
+                adjusting policies may reshape the tree.
+                  param   -tree being searched
+                          -type of comparison
+                          -value being compared against
+                  return  -slot holding the node, or NULL
+    search      finds a node by key, self adjusting policies
+                may reshape the tree.
+                  param   -tree being searched
+                          -key being searched for
+                  return  -slot holding the node, or NULL
+    build       links an ordered array of nodes into a tree
+                which satisfies the policy.
+                  param   -ordered array of nodes
+                          -the number of nodes
+                  return  -root of the new tree
+    join        joins two branches and a node between them
+                while keeping the policy, used by split, join
+                and union. NULL where these are not supported.
+                  param   -lesser branch
+                          -node between the branches
+                          -greater branch
+                  return  -root of the joined branch
+*/
+struct BalancePointersP
+{
+  int (*insert)(TREE* tree, NODE* node);
+  int (*remove)(TREE* tree, int* ptr_branch);
+  int* (*find)(TREE* tree, FIND_BY type, void* value);
+  int* (*search)(TREE* tree, char* key);
+  NODE* (*build)(NODE** nodes, int count);
+  JOIN_FUNCTION join;
+};
 /*
   TREE
   description
     struct containing the definition for a tree (essentially an abstract structure).
   data:
-    root          pointer to a root or "head" node struct 
-                  (as defined in Node.h).
+    root          handle of the root or "head" node struct 
+                  (as defined in Node.h), NODE_NONE if the
+                  tree is empty.
     size          the number of elements "size" in the tree.
-    staticIndex   the index determining what index value should be 
-                  given to the next node added.
     functionPointers   
                   a pointer to a FunctionPointers struct
                   (as defined in Node.h). A reference to this
-                  is passed on to all child nodes.
+                  is held by the arena of all child nodes.
+    arena         arena the nodes of the tree are taken from.
     treeDataPointers   
                   a pointer to a treeDataPointers struct.
                   This contains functions essential to TREE
                   operations and a link to a file where initial
                   data can be found.
+    snapshot      read only copy of the tree used for lookups
+                  by key (NULL until one is needed).
+    writeCount    the number of writes made since the snapshot
+                  was taken.
+    engine        function pointers of the structure holding
+                  the elements.
+    bTree         root of the b-tree holding the elements when
+                  the BTREE_ENGINE is used.
+    radixTree     root of the radix tree holding the elements
+                  when the ART_ENGINE is used.
+    skipList      skip list holding the elements when the 
+                  SKIPLIST_ENGINE is used.
+    balance       function pointers of the policy keeping a 
+                  BINARY_ENGINE tree balanced.
+    maxSize       the most elements the tree has held since it
+                  was last rebuilt (used by SCAPEGOAT_BALANCE).
+    relaxed       maintenance state of a RELAXED_BALANCE tree,
+                  otherwise NULL.
+    churn         the number of writes made since the layout of
+                  the tree was last measured.
+    columns       column store of the values of the tree used
+                  by scanTree (NULL until one is needed).
+    columnsStale  set when a write has been made since the 
+                  column store was built.
+    lookup        table finding nodes by the lookup key of their
+                  values (NULL until one is needed). It is kept
+                  up to date as nodes are added, modified and
+                  removed.
+    lookupStale   set when nodes have been moved in bulk since
+                  the lookup table was built, which rebuilds it
+                  when it is next needed.
+    bitmaps       bitmap indexes of fields of the values, each
+                  created the first time its field is searched,
+                  and kept up to date like the lookup table.
+    everyBitmap   bitmap of the handles of every node, created
+                  with the first bitmap index.
+    bitmapsStale  set when nodes have been moved in bulk since
+                  the bitmaps were built.
+    bitmapLock    held while the bitmaps are written.
 */
 struct TREE_P
 {
-  NODE* root;
+  int root;
   int size;
-  int staticIndex;
   FunctionPointers* functionPointers;
+  NODE_ARENA* arena;
   TreeDataPointers* treeDataPointers;
+  SNAPSHOT* snapshot;
+  int writeCount;
+  TreeEnginePointers* engine;
+  BTREE_NODE* bTree;
+  ART_NODE* radixTree;
+  SKIP_LIST* skipList;
+  BalancePointers* balance;
+  int maxSize;
+  RELAXED* relaxed;
+  int churn;
+  void* columns;
+  int columnsStale;
+  LOOKUP_TABLE* lookup;
+  int lookupStale;
+  BITMAP_INDEX* bitmaps;
+  BITMAP* everyBitmap;
+  int bitmapsStale;
+  MUTEX bitmapLock;
+};
+
+/*
+  RELAXED
+  description
+    maintenance state of a RELAXED_BALANCE tree. The lock is
+    held by the maintenance thread while it fixes the tree up,
+    and by every operation which reads or writes its branches.
+  data:
+    lock        lock on the branches of the tree.
+    thread      the maintenance thread.
+    running     cleared to stop the maintenance thread.
+    pending     set when nodes have been marked for a fix up.
+    urgent      set when the tree has grown past its slack and
+                should be fixed up without waiting for writes 
+                to pause.
+    writes      the number of writes made, used to tell when
+                writes have paused.
+*/
+struct RELAXED_P
+{
+  MUTEX lock;
+  THREAD thread;
+  int running;
+  int pending;
+  int urgent;
+  int writes;
 };
 
+/*
+  UnionTask
+  description
+    arguments and result of a branch union carried
+    out on a separate thread.
+  data:
+    a           branch whose nodes are kept.
+    b           branch whose nodes are merged in.
+    depth       depth of the branches in the recursion.
+    join        join of the tree's BALANCE_POLICY.
+    result      root of the merged branch.
+*/
+typedef struct UnionTaskP
+{
+  NODE* a;
+  NODE* b;
+  int depth;
+  JOIN_FUNCTION join;
+  NODE* result;
+} UnionTask;
+
+/*
+  MatchContext
+  description
+    state of a walk looking for the first node which
+    fits a FIND_BY comparison.
+  data:
+    type        the type of comparison.
+    value       the value being compared against.
+    result      slot of the node found, or NULL.
+*/
+typedef struct MatchContextP
+{
+  FIND_BY type;
+  void* value;
+  int* result;
+} MatchContext;
+
+/*
+  CollectContext
+  description
+    state of a walk writing every node into an array.
+  data:
+    nodes       array being filled.
+    count       the number of nodes written so far.
+*/
+typedef struct CollectContextP
+{
+  NODE** nodes;
+  int count;
+} CollectContext;
+
+/*
+  RangeContext
+  description
+    state of a walk passing the nodes whose keys begin with a
+    prefix on to another visitor.
+  data:
+    prefix      the beginning of the keys visited.
+    length      the length of the prefix.
+    visit       the visitor nodes are passed on to.
+    context     passed on to visit.
+*/
+typedef struct RangeContextP
+{
+  char* prefix;
+  int length;
+  int (*visit)(int* ptr_branch, void* context);
+  void* context;
+} RangeContext;
+
+/*
+  PrintContext
+  description
+    state of a walk printing the nodes which fit
+    the printTree criteria.
+  data:
+    type        the type of comparison (if any).
+    target      the value being searched for.
+    count       the number of nodes printed so far.
+    nodes       when not NULL, nodes fitting the criteria are 
+                written here to be sorted rather than printed.
+    renderer    renderer the nodes are printed through.
+*/
+typedef struct PrintContextP
+{
+  FIND_BY type;
+  void* target;
+  int count;
+  NODE** nodes;
+  RENDERER* renderer;
+} PrintContext;
+
 /*
   TreeDataPointers
   description
@@ -126,6 +586,16 @@ struct TREE_P
 
     fileAddress the addres of the file where initial data 
                 can be found.
+    engine      the structure used to hold elements.
+    balance     the policy keeping the tree balanced when the
+                BINARY_ENGINE is used.
+    compact     whether a BINARY_ENGINE tree is compacted when
+                its nodes become scattered (see maintainLayout).
+                Compaction moves nodes, so it should be left off
+                if nodes are held on to outside the tree.
+    interactive whether printTree clears the screen before it
+                prints, left off when output is not read at a
+                terminal.
 */
 struct TreeDataPointersP 
 {
@@ -133,8 +603,114 @@ struct TreeDataPointersP
   int (*prompt)(int type, void* input);
   int (*tableHeader)(char* string);
   char* fileAddress;
+  TREE_ENGINE engine;
+  BALANCE_POLICY balance;
+  int compact;
+  int interactive;
+};
+
+//operations of each TREE_ENGINE
+TreeEnginePointers binaryEngine = 
+{
+  &insertBinaryElement,
+  &removeBinaryElement,
+  &findBinaryElement,
+  &searchBinaryElement,
+  &walkBinaryElement,
+  &clearBinaryElement
+};
+TreeEnginePointers bTreeEngine = 
+{
+  &insertBTreeElement,
+  &removeBTreeElement,
+  &findBTreeElement,
+  &searchBTreeElement,
+  &walkBTreeElement,
+  &clearBTreeElement
+};
+TreeEnginePointers artEngine = 
+{
+  &insertArtElement,
+  &removeArtElement,
+  &findArtElement,
+  &searchArtElement,
+  &walkArtElement,
+  &clearArtElement
+};
+TreeEnginePointers skipEngine = 
+{
+  &insertSkipElement,
+  &removeSkipElement,
+  &findSkipElement,
+  &searchSkipElement,
+  &walkSkipElement,
+  &clearSkipElement
 };
 
+//operations of each BALANCE_POLICY
+BalancePointers adhocBalance = 
+{
+  &insertAdhocElement,
+  &removeAdhocElement,
+  &findBalancedElement,
+  &searchBalancedElement,
+  &buildElement,
+  &joinElement
+};
+BalancePointers avlBalance = 
+{
+  &insertAvlElement,
+  &removeAvlElement,
+  &findBalancedElement,
+  &searchBalancedElement,
+  &buildElement,
+  &joinElement
+};
+BalancePointers redBlackBalance = 
+{
+  &insertRedBlackElement,
+  &removeRedBlackElement,
+  &findBalancedElement,
+  &searchBalancedElement,
+  &buildRedBlack,
+  &joinRedBlack
+};
+BalancePointers treapBalance = 
+{
+  &insertTreapElement,
+  &removeTreapElement,
+  &findBalancedElement,
+  &searchBalancedElement,
+  &buildTreap,
+  &joinTreap
+};
+BalancePointers scapegoatBalance = 
+{
+  &insertScapegoatElement,
+  &removeScapegoatElement,
+  &findBalancedElement,
+  &searchBalancedElement,
+  &buildElement,
+  &joinElement
+};
+BalancePointers splayBalance = 
+{
+  &insertSplayElement,
+  &removeSplayElement,
+  &findSplayElement,
+  &searchSplayElement,
+  &buildElement,
+  &joinSplay
+};
+BalancePointers relaxedBalance = 
+{
+  &insertRelaxedElement,
+  &removeRelaxedElement,
+  &findRelaxedElement,
+  &searchRelaxedElement,
+  &buildElement,
+  NULL
+};
 
 
 
@@ -163,7 +739,6 @@ TREE* newBinaryTree(TreeDataPointers* treeDataPointers, FunctionPointers* nodeFu
     PAUSE
     exit(0);
   }
-  tree->staticIndex = 0;
   initTree(tree, nodeFunctionPointers, treeDataPointers);
   return tree;
 }
@@ -187,19 +762,61 @@ TREE* newBinaryTree(TreeDataPointers* treeDataPointers, FunctionPointers* nodeFu
 int initTree(TREE* tree, FunctionPointers* functionPointers, TreeDataPointers* treeDataPointers)
 {
   FILE* file;
-  tree->root = NULL;
+  tree->root = NODE_NONE;
   tree->size = 0;
+  tree->snapshot = NULL;
+  tree->writeCount = 0;
+  tree->churn = 0;
+  tree->columns = NULL;
+  tree->columnsStale = 0;
+  tree->lookup = NULL;
+  tree->lookupStale = 0;
+  tree->bitmaps = NULL;
+  tree->everyBitmap = NULL;
+  tree->bitmapsStale = 0;
+  initMutex(&tree->bitmapLock);
+  tree->bTree = NULL;
+  tree->radixTree = NULL;
   
   tree->functionPointers = functionPointers;
+  tree->arena = getArena(functionPointers);
   tree->treeDataPointers = treeDataPointers;
+  tree->engine = getEngine(treeDataPointers->engine);
+  tree->balance = getBalance(treeDataPointers->balance);
+  tree->maxSize = 0;
+  tree->relaxed = NULL;
+  if(tree->balance == &relaxedBalance) initRelaxed(tree);
+  //the skip list is shared by every thread adding to the tree, so
+  //it is created up front rather than by the first of them
+  tree->skipList = tree->engine == &skipEngine ? newSkipList() : NULL;
 
   file = fopen(tree->treeDataPointers->fileAddress, "rb");
-  while(file != NULL && !feof(file))
-  {
-    newElement(tree, file);
-  }
   if(file != NULL)
   {
+    //initial records are read in full and added as a single batch
+    //so that the tree is only balanced once.
+    NODE** nodes = NULL;
+    NODE* node;
+    size_t count = 0, capacity = 0;
+    while(!feof(file))
+    {
+      node = newNode(tree->arena, file);
+      if(node == NULL) continue;
+      if(count == capacity)
+      {
+        capacity = capacity ? capacity * 2 : 64;
+        nodes = (NODE**) realloc(nodes, capacity * sizeof(NODE*));
+        if(nodes == NULL)
+        {
+          printf("sufficient memory could not be allocated to load tree");
+          PAUSE
+          exit(0);
+        }
+      }
+      nodes[count++] = node;
+    }
+    addElements(tree, nodes, count);
+    free(nodes);
     fclose(file);
   }
   return 0;
@@ -217,15 +834,36 @@ int initTree(TREE* tree, FunctionPointers* functionPointers, TreeDataPointers* t
 */
 int deleteTree(TREE* tree)
 {
-  NODE* node = tree->root;
-  deleteNode(tree->root, 1);
-
+  deleteRelaxed(tree);
+  tree->engine->clear(tree);
+  deleteIndexes(tree);
 
   free(tree);
 
   return 0;
 }
 
+/*
+  deleteIndexes
+  description
+    frees the structures built over the nodes of a tree, its 
+    snapshot, columns (with their tries and trigram indexes),
+    lookup table and bitmaps. The nodes are left alone.
+  params:
+    tree      tree whose indexes are being deleted.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int deleteIndexes(TREE* tree)
+{
+  deleteSnapshot(tree->snapshot);
+  if(tree->columns != NULL) tree->functionPointers->deleteColumns(tree->columns);
+  deleteLookupTable(tree->lookup);
+  deleteBitmapIndex(tree->bitmaps);
+  deleteBitmap(tree->everyBitmap);
+  return 0;
+}
+
 /*
   saveTree
   description
@@ -241,7 +879,7 @@ int deleteTree(TREE* tree)
 int saveTree(TREE* tree)
 {
   FILE* file = fopen(tree->treeDataPointers->fileAddress, "wb");
-  saveNode(tree->root, file);
+  tree->engine->walk(tree, &saveVisit, (void*) file);
   fclose(file);
   return 0;
 }
@@ -263,10 +901,11 @@ int saveTree(TREE* tree)
 */
 int newElement(TREE* tree, FILE* file)
 {
-  NODE* node = newNode(tree->functionPointers, &tree->staticIndex, file);
+  NODE* node = newNode(tree->arena, file);
   if(node != NULL)
   {
     addElement(tree, node, 0);
+    maintainLayout(tree);
     return 1;
   }
   else
@@ -278,28 +917,178 @@ int newElement(TREE* tree, FILE* file)
 /*
   addElement
   description
-    adds a new node to the tree.
+    adds a new node to the tree. Trees using the SKIPLIST_ENGINE
+    may be added to by several threads at once.
   params:
     tree      tree to be added to.
     nodeIn    node to be added to the tree.
+    balanceRun
+              whether the node is being re-added to a binary 
+              tree by balanceTree, in which case it is already
+              counted and no further balancing is done.
   return: 
     NULL      0 value indicating successful exicution.
 */
 int addElement(TREE* tree, NODE* nodeIn, int balanceRun)
 {
-  //node array which will hold the inputs new parent and child
-  NODE **ptr_branch = &(tree->root), **ptr_root = &(tree->root);
+  if(balanceRun)
+  {
+    *getElement(&(tree->root), BY_KEY, nodeIn) = nodeIn->handle;
+    measureElement(tree, nodeAt(tree->root));
+    return 0;
+  }
 
-  tree->size++;
-  ptr_branch = getElement(ptr_branch, BY_KEY, nodeIn);
+  //the key is written once, as the node is placed
+  updateNodeKey(nodeIn);
+  atomicAdd(&tree->size, 1);
+  recordWrite(tree, 1, 0);
+  indexElement(tree, nodeIn);
+  return tree->engine->insert(tree, nodeIn);
+}
 
-  *ptr_branch = nodeIn;
-  if(!balanceRun) 
-  balanceTree(tree, ptr_root);
-  measureElement(tree, tree->root);
-  
-  return 0;
-  
+/*
+  addElements
+  description
+    adds a batch of new nodes to the tree. The batch is sorted,
+    merged with the in-order contents of the tree in one pass,
+    and the tree is rebuilt (and so balanced) only once.
+  params:
+    tree      tree to be added to.
+    nodes     array of nodes to be added. the array is sorted
+              in place.
+    n         the number of nodes in the array.
+  return: 
+    count     the number of nodes added.
+*/
+int addElements(TREE* tree, NODE** nodes, size_t n)
+{
+  NODE **existing, **merged;
+  int size = tree->size;
+  int i, j = 0, k = 0;
+
+  if(n == 0) return 0;
+  //keys are written once, as the nodes are placed
+  for(i = 0; i < (int) n; i++)
+  {
+    updateNodeKey(nodes[i]);
+    indexElement(tree, nodes[i]);
+  }
+  if(tree->engine != &binaryEngine)
+  {
+    for(i = 0; i < (int) n; i++) tree->engine->insert(tree, nodes[i]);
+    tree->size += (int) n;
+    recordWrite(tree, (int) n, 0);
+    return (int) n;
+  }
+
+  existing = (NODE**) malloc((size + 1) * sizeof(NODE*));
+  merged = (NODE**) malloc((size + n) * sizeof(NODE*));
+  if(existing == NULL || merged == NULL)
+  {
+    printf("sufficient memory could not be allocated to add elements");
+    PAUSE
+    exit(0);
+  }
+
+  qsort(nodes, n, sizeof(NODE*), &compareElements);
+  lockTree(tree);
+  size = collectElement(nodeAt(tree->root), existing, 0);
+
+  //both arrays are ordered, so a single merge pass orders the union
+  i = 0;
+  while(i < size && j < (int) n)
+  {
+    merged[k++] = nodeCompareSort(existing[i], nodes[j]) <= 0 ? existing[i++] : nodes[j++];
+  }
+  while(i < size) merged[k++] = existing[i++];
+  while(j < (int) n) merged[k++] = nodes[j++];
+
+  tree->root = getHandle(tree->balance->build(merged, k));
+  tree->size = tree->maxSize = k;
+  recordWrite(tree, (int) n, 0);
+  unlockTree(tree);
+
+  free(existing);
+  free(merged);
+  return k - size;
+}
+
+/*
+  removeElements
+  description
+    removes (and frees) every node whose key appears in the 
+    provided list. The tree is walked once and rebuilt once,
+    no matter how many keys are provided.
+  params:
+    tree      tree to be removed from.
+    keys      array of keys to be removed. the array is sorted
+              in place.
+    n         the number of keys in the array.
+  return: 
+    count     the number of nodes removed.
+*/
+int removeElements(TREE* tree, char** keys, size_t n)
+{
+  NODE **nodes, *node;
+  int* ptr_branch;
+  int size = tree->size;
+  int i, j = 0, k = 0;
+  int compare;
+
+  if(n == 0) return 0;
+  if(tree->engine != &binaryEngine)
+  {
+    for(i = 0; i < (int) n; i++)
+    {
+      while((ptr_branch = tree->engine->search(tree, keys[i])) != NULL)
+      {
+        node = nodeAt(*ptr_branch);
+        unindexElement(tree, node);
+        tree->engine->remove(tree, ptr_branch);
+        deleteNode(node, 0);
+        k++;
+      }
+    }
+    tree->size -= k;
+    recordWrite(tree, k, 1);
+    return k;
+  }
+  if(tree->root == NODE_NONE) return 0;
+  nodes = (NODE**) malloc(size * sizeof(NODE*));
+  if(nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to remove elements");
+    PAUSE
+    exit(0);
+  }
+
+  qsort(keys, n, sizeof(char*), &compareKeys);
+  lockTree(tree);
+  size = collectElement(nodeAt(tree->root), nodes, 0);
+
+  //nodes are ordered by key, so the key list is only walked once
+  for(i = 0; i < size; i++)
+  {
+    compare = -1;
+    while(j < (int) n && (compare = strcmp(keys[j], nodes[i]->key)) < 0) j++;
+
+    if(j < (int) n && compare == 0)
+    {
+      setLess(nodes[i], NULL);
+      setGreater(nodes[i], NULL);
+      unindexElement(tree, nodes[i]);
+      deleteNode(nodes[i], 0);
+    }
+    else nodes[k++] = nodes[i];
+  }
+
+  tree->root = getHandle(tree->balance->build(nodes, k));
+  tree->size = tree->maxSize = k;
+  recordWrite(tree, size - k, 1);
+  unlockTree(tree);
+
+  free(nodes);
+  return size - k;
 }
 
 /*
@@ -317,7 +1106,7 @@ NODE* modifyElement(TREE* tree, MOD_TYPE modType)
 {
   //node array which will hold the inputs desired element and its
   //parent
-  NODE** ptr_branch = &(tree->root);
+  int* ptr_branch = &(tree->root);
 
   int choice = getElementP(tree, &ptr_branch);
 
@@ -327,42 +1116,43 @@ NODE* modifyElement(TREE* tree, MOD_TYPE modType)
   }
   else if(choice != 0)
   {
-    NODE* node = (*ptr_branch);
-    NODE* temp;
+    NODE* node = nodeAt(*ptr_branch);
 
-
-    tree->size--;
-    if((*ptr_branch)->greater != NULL)
-    {
-
-      *ptr_branch = (*ptr_branch)->greater;
-      temp = (*ptr_branch);
-      while(temp->less != NULL) temp = temp->less;
-      temp->less = node->less;
-    }
-    else if((*ptr_branch)->less != NULL)
+    //the node is looked up by its value before the edit, and is
+    //indexed again once it has been edited or re-added
+    unindexElement(tree, node);
+    //an edit leaves the node's key alone, so the node stays where
+    //it is unless the edit changed a field its key is made from
+    if(modType != REMOVE)
     {
-      *ptr_branch = (*ptr_branch)->greater;
-      temp = (*ptr_branch);
+      editNode(node);
+      if(!nodeKeyStale(node))
+      {
+        indexElement(tree, node);
+        return node;
+      }
+      //the node is found again by its old key, the tree may have
+      //been rebalanced while it was edited
+      ptr_branch = tree->engine->find(tree, BY_KEY, node);
     }
-    else *ptr_branch = NULL;
 
+    atomicAdd(&tree->size, -1);
+    recordWrite(tree, 1, 1);
+    tree->engine->remove(tree, ptr_branch);
 
     if(modType == REMOVE)
     {
       deleteNode(node, 0);
       node = NULL;
+      maintainLayout(tree);
     }
     else
     {
       //node->index = 0;
-      node->greater = NULL;
-      node->less = NULL;
-      editNode(node);
+      setGreater(node, NULL);
+      setLess(node, NULL);
       addElement(tree, node, 0);
     }
-    measureElement(tree, tree->root);
-    balanceTree(tree, &tree->root);
     return node;
   }
   else if(choice != 0)
@@ -386,35 +1176,35 @@ NODE* modifyElement(TREE* tree, MOD_TYPE modType)
   return: 
     return    the number of changes made to the tree.
 */
-int balanceTree(TREE* tree, NODE** node)
+int balanceTree(TREE* tree, int* node)
 {
   NODE *less, *greater, *self;
   int lessH, greaterH;
   int changedNode = 0, changedBranch = 0;
   
 
-  measureElement(tree, tree->root);
-  while(node != NULL && *node != NULL)
+  measureElement(tree, nodeAt(tree->root));
+  while(node != NULL && *node != NODE_NONE)
   {
     
     
-    self = *node;
+    self = nodeAt(*node);
     changedNode++;
 
-    less = self->less;
-    greater = self->greater;
+    less = getLess(self);
+    greater = getGreater(self);
     lessH = less ? less->height : 0;
     greaterH = greater ? greater->height : 0;
     if(lessH > greaterH + 1)
     {
-      *node = less;
-      self->less = NULL;
+      *node = self->less;
+      setLess(self, NULL);
       addElement(tree, self, 1);
     }
     else if(greaterH > lessH + 1)
     {
-      *node = greater;
-      self->greater = NULL;
+      *node = self->greater;
+      setGreater(self, NULL);
       addElement(tree, self, 1);
     }
     else break;
@@ -423,7 +1213,7 @@ int balanceTree(TREE* tree, NODE** node)
   }
   if(changedNode )
   {
-    NODE **branch[] = {&(*node)->less, &(*node)->greater};
+    int *branch[] = {&nodeAt(*node)->less, &nodeAt(*node)->greater};
 
     changedBranch += *branch[0] ? balanceTree(tree, branch[0]) : 0;
 
@@ -451,275 +1241,2857 @@ int measureElement(TREE* tree, NODE* node)
   
   int left, right;
   if(node == NULL) return 0;
-  left = measureElement(tree, node->less);
-  right = measureElement(tree, node->greater);
+  left = measureElement(tree, getLess(node));
+  right = measureElement(tree, getGreater(node));
 
   node->height = left > right ? left : right;
   node->height++;
+  node->weight = elementWeight(getLess(node)) + elementWeight(getGreater(node)) + 1;
   return node->height;
 }
 
-
 /*
-  getElementP
+  newEmptyTree
   description
-    function is used to prompt for an element discription, 
-    and find sed element.
+    creates a new, empty tree sharing the function pointers and
+    file of an existing tree. Nothing is read from the file.
   params:
-    tree      tree to be searched.
-    ptr_branch
-              nodes are represented as pointers to nodes,
-              each node is connected to its children by pointers
-              to them, and this parameter is a pointer to one
-              such child pointer. the parameter takes the form of
-              a triple pointer so that the aforementioned pointer 
-              can be changed in this method and such changes will
-              be reflected in the calling function.
+    tree      tree whose pointers are being shared.
   return: 
-    choice    the type of comparison carried to determine which
-              element is desired
+    TREE*     tree created 
 */
-int getElementP(TREE* tree, NODE*** ptr_branch)
+TREE* newEmptyTree(TREE* tree)
 {
+  TREE* empty = (TREE*) malloc(sizeof(TREE));
 
-  char* input = valueBufferC;
-  FIND_BY choice = (FIND_BY) tree->treeDataPointers->findMenu();
-  if(choice != 1 && choice != 0)
-  {
-    tree->treeDataPointers->prompt(choice, (void*) input);
-  }
-  else if(choice == 1)
-  {
-    *((int*) input) = getIndexIn();
-  }
-  else if(choice == 0)
+  if(empty == NULL)
   {
-    input[0] = '\0';
-    return NULL;
+    printf("sufficient memory could not be allocated to create tree");
+    PAUSE
+    exit(0);
   }
-
-  *ptr_branch = getElement(*ptr_branch, choice, (void*) input);
-  input[0] = '\0';
-  return choice;
+  *empty = *tree;
+  empty->root = NODE_NONE;
+  empty->size = 0;
+  empty->snapshot = NULL;
+  empty->writeCount = 0;
+  empty->churn = 0;
+  empty->columns = NULL;
+  empty->columnsStale = 0;
+  empty->lookup = NULL;
+  empty->lookupStale = 0;
+  empty->bitmaps = NULL;
+  empty->everyBitmap = NULL;
+  empty->bitmapsStale = 0;
+  initMutex(&empty->bitmapLock);
+  empty->bTree = NULL;
+  empty->radixTree = NULL;
+  empty->skipList = NULL;
+  empty->relaxed = NULL;
+  return empty;
 }
 
 /*
-  getElement
+  splitTree
   description
-    function is used to retrieve an element fitting its parameters.
+    splits a tree in two around a key. 
   params:
-    ptr_branch
-              the pointer to the pointer connecting the node
-              being currently inspected with its parent.
-    type      the type of comparison to be carried out.
-    value     the value with which nodes are being compared
-
+    tree      tree being split. It keeps every node with 
+              a key less than the one provided.
+    key       key at which the tree is split.
   return: 
-    ptr_branch
-              the pointer to the branch referencing the desired
-              node.
+    TREE*     new tree holding every node with a key greater 
+              than or equal to the one provided, or NULL if 
+              splitting is not supported (see joinSupported).
 */
-NODE** getElement(NODE** ptr_branch, FIND_BY type, void* value)
+TREE* splitTree(TREE* tree, char* key)
 {
-  
-  int compare;
-  NODE** ptr_branch_temp = NULL;
-  if(type == BY_KEY) compare = nodeCompareSort(*ptr_branch, ((NODE*) value));
-  else if(*ptr_branch != NULL)
-  { 
-    compare = nodeCompareFind(*ptr_branch, type, value);
-  }
-  else return NULL;
+  TREE* greaterTree;
+  NODE *less, *equal, *greater;
 
-  if(compare == 0)
-  {
-    return ptr_branch;
-  }
+  if(!joinSupported(tree, tree)) return NULL;
+  greaterTree = newEmptyTree(tree);
+  recordWrite(tree, tree->size, 1);
+  tree->lookupStale = 1;
+  tree->bitmapsStale = 1;
+  splitElement(nodeAt(tree->root), key, &less, &equal, &greater, tree->balance->join);
+  tree->root = getHandle(less);
+  tree->size = tree->maxSize = elementWeight(less);
+  greaterTree->root = getHandle(joinBranches(equal, greater, tree->balance->join));
+  greaterTree->size = greaterTree->maxSize = elementWeight(nodeAt(greaterTree->root));
+  return greaterTree;
+}
 
-  if(type != BY_KEY || compare > 0)
-  {
-    ptr_branch_temp = &((*ptr_branch)->less);
-    ptr_branch_temp = getElement(ptr_branch_temp, type, value);
-	if(ptr_branch_temp) return ptr_branch_temp;
-  }
+/*
+  joinTrees
+  description
+    appends one tree to another. Every key in the second tree
+    must be greater than or equal to every key in the first.
+    Nodes keep their indexes, which no two trees share, but for
+    those of the second tree whose key equals the greatest key
+    of the first, which are given new ones to be ordered after
+    it. The trees are joined in time proportional to the height
+    of the taller.
+  params:
+    a         tree being appended to.
+    b         tree being appended, it is free'd on success.
+  return: 
+    TREE*     the joined tree (a), or NULL if the trees overlap
+              or joining is not supported (see joinSupported).
+*/
+TREE* joinTrees(TREE* a, TREE* b)
+{
+  NODE *last = nodeAt(a->root), *first = nodeAt(b->root);
+  if(!joinSupported(a, b)) return NULL;
+  while(last != NULL && getGreater(last) != NULL) last = getGreater(last);
+  while(first != NULL && getLess(first) != NULL) first = getLess(first);
 
-  if(type != BY_KEY || compare < 0)
+  if(last != NULL && first != NULL && strcmp(last->key, first->key) > 0)
   {
-    ptr_branch_temp = &((*ptr_branch)->greater);
-    ptr_branch_temp = getElement(ptr_branch_temp, type, value);
-	if(ptr_branch_temp) return ptr_branch_temp;
+    printf("\nERROR: TREES OVERLAP\n");
+    return NULL;
   }
-  return ptr_branch_temp;
 
+  if(last != NULL && first != NULL) reindexElement(nodeAt(b->root), last->key);
+  recordWrite(a, b->size, 1);
+  a->lookupStale = 1;
+  a->bitmapsStale = 1;
+  a->root = getHandle(joinBranches(nodeAt(a->root), nodeAt(b->root), a->balance->join));
+  a->size = a->maxSize = elementWeight(nodeAt(a->root));
+  deleteIndexes(b);
+  free(b);
+  return a;
 }
 
-
 /*
-  getIndexIn
+  unionTrees
   description
-    prompts for and gets the index of the desired element.
+    merges one tree into another. Nodes of the second tree
+    with a key already held by the first are deleted, the
+    rest keep their indexes. Large trees are merged on
+    several threads.
   params:
-    void
+    a         tree being merged into.
+    b         tree being merged, it is free'd.
   return: 
-    index     the index of the desired element.
+    TREE*     the merged tree (a), or NULL if joining is not
+              supported (see joinSupported).
 */
-int getIndexIn(void)
+TREE* unionTrees(TREE* a, TREE* b)
 {
-  int index; 
-  printf("please enter the index number of the desired contact.");
-  scanf("%d", &index);
-  return index;
+  if(!joinSupported(a, b)) return NULL;
+  recordWrite(a, b->size, 1);
+  a->lookupStale = 1;
+  a->bitmapsStale = 1;
+  a->root = getHandle(unionElement(nodeAt(a->root), nodeAt(b->root), 0, a->balance->join));
+  a->size = a->maxSize = elementWeight(nodeAt(a->root));
+  deleteIndexes(b);
+  free(b);
+  return a;
 }
 
+/*
+  joinSupported
+  description
+    checks that split, join and union can be carried out on a
+    pair of trees. Both must use the BINARY_ENGINE, which these
+    work on directly, and the same BALANCE_POLICY, which must 
+    provide a join. RELAXED_BALANCE does not, as its nodes may
+    be fixed up by its maintenance thread at any time.
+  params:
+    a         first tree being checked.
+    b         second tree being checked (may be the first).
+  return: 
+    result    1 if the operation is supported, otherwise an
+              error is printed and 0 returned.
+*/
+int joinSupported(TREE* a, TREE* b)
+{
+  if(a->engine != &binaryEngine || b->engine != &binaryEngine)
+  {
+    printf("\nERROR: OPERATION NOT SUPPORTED BY TREE ENGINE\n");
+    return 0;
+  }
+  if(a->balance != b->balance || a->balance->join == NULL)
+  {
+    printf("\nERROR: OPERATION NOT SUPPORTED BY BALANCING POLICY\n");
+    return 0;
+  }
+  return 1;
+}
 
 /*
-  printEntry
+  joinBranches
   description
-    request an element discription from the user then print
-    the value's info at full size.
+    joins two branches without a node between them.
   params:
-    tree      tree in which the element is located.
+    less      lesser branch.
+    greater   greater branch.
+    join      join of the tree's BALANCE_POLICY.
   return: 
-    NULL      0 value indicating successful exicution.
+    node      root of the joined branch.
 */
-int printEntry(TREE* tree)
+NODE* joinBranches(NODE* less, NODE* greater, JOIN_FUNCTION join)
 {
-  char* valueString = valueBufferC;
+  NODE* last;
+  if(less == NULL) return greater;
+  if(greater == NULL) return less;
 
+  less = splitLastElement(less, &last, join);
+  return join(less, last, greater);
+}
 
-  
-  NODE** ptr_branch = &(tree->root);
-  int choice = getElementP(tree, &ptr_branch);
+/*
+  splitLastElement
+  description
+    removes the greatest node from a branch.
+  params:
+    node      root of the branch.
+    last      filled with the removed node.
+    join      join of the tree's BALANCE_POLICY.
+  return: 
+    node      root of the remaining branch.
+*/
+NODE* splitLastElement(NODE* node, NODE** last, JOIN_FUNCTION join)
+{
+  NODE* rest;
+  if(getGreater(node) == NULL)
+  {
+    rest = getLess(node);
+    setLess(node, NULL);
+    updateElement(node);
+    *last = node;
+    return rest;
+  }
+  rest = splitLastElement(getGreater(node), last, join);
+  return join(getLess(node), node, rest);
+}
 
+/*
+  splitElement
+  description
+    splits a branch into the nodes with keys less than, equal to,
+    and greater than the key provided.
+  params:
+    node      root of the branch being split.
+    key       key at which the branch is split.
+    less      filled with the branch of lesser keys.
+    equal     filled with the branch of equal keys.
+    greater   filled with the branch of greater keys.
+    join      join of the tree's BALANCE_POLICY.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int splitElement(NODE* node, char* key, NODE** less, NODE** equal, NODE** greater, JOIN_FUNCTION join)
+{
+  NODE *branchLess, *branchEqual, *branchGreater;
+  int compare;
 
-  if(ptr_branch != NULL && *ptr_branch != NULL && choice != 0)
+  if(node == NULL)
   {
+    *less = *equal = *greater = NULL;
+    return 0;
+  }
 
-    getFunctions(*ptr_branch)->toString(getValue(*ptr_branch), valueString, 1);
-    printf("\n%s\n", valueString);
-
+  compare = strcmp(node->key, key);
+  if(compare < 0)
+  {
+    splitElement(getGreater(node), key, &branchLess, equal, greater, join);
+    *less = join(getLess(node), node, branchLess);
   }
-  else if(choice)
+  else if(compare > 0)
   {
-    printf("\nERROR: INPUT NOT FOUND\n");
+    splitElement(getLess(node), key, less, equal, &branchGreater, join);
+    *greater = join(branchGreater, node, getGreater(node));
+  }
+  else
+  {
+    //equal keys may sit on either side of a matching node, the
+    //lesser branch holds no greater keys and the greater no lesser
+    NODE* greaterEqual;
+    splitElement(getLess(node), key, less, &branchEqual, &branchGreater, join);
+    splitElement(getGreater(node), key, &branchLess, &greaterEqual, greater, join);
+    *equal = join(branchEqual, node, greaterEqual);
   }
-  valueString[0] = '\0';
   return 0;
 }
 
-
 /*
-  printTree
+  unionElement
   description
-    prints formatted tree in tabular form using the criteria provided.
+    merges two branches. Nodes of the second branch with keys
+    found in the first are deleted. The two halves of large
+    branches are merged on separate threads.
   params:
-    tree      tree being printed.
-    type      the type of comparison being carried out (if any).
-    target    the value being searched for.
+    a         branch whose nodes are kept.
+    b         branch being merged in.
+    depth     depth of the branches in the recursion.
+    join      join of the tree's BALANCE_POLICY.
   return: 
-    NULL      0 value indicating successful exicution.
+    node      root of the merged branch.
 */
-int printTree(TREE* tree, FIND_BY type, void* target)
+NODE* unionElement(NODE* a, NODE* b, int depth, JOIN_FUNCTION join)
 {
-  char* headString = valueBufferA;
-  char* titleString = valueBufferB;
-
-  int i;
-  int ws;
+  NODE *less, *equal, *greater, *aLess, *aGreater;
+  UnionTask task;
+  THREAD thread;
+  int threaded = 0;
 
-  NODE* node = tree->root;
-  int count = 0;
+  if(a == NULL) return b;
+  if(b == NULL) return a;
 
-  tree->treeDataPointers->tableHeader(headString);
-  CLEAR
-  
-  createTitleString(tree, type, titleString);
+  aLess = getLess(a);
+  aGreater = getGreater(a);
+  splitElement(b, a->key, &less, &equal, &greater, join);
+  deleteNode(equal, 1);
 
-  ws = strlen(headString)/2 + 5 - strlen(titleString)/2;
-  for(i = 0; i < ws; i++)
+  task.a = aLess;
+  task.b = less;
+  task.depth = depth + 1;
+  task.join = join;
+  if(depth < 31 && (1 << depth) < processorCount() && elementWeight(aLess) + elementWeight(less) > PARALLEL_GRAIN)
   {
-    printf(" ");
+    threaded = !startThread(&thread, &unionThread, &task);
   }
-  printf("%s\n\n", titleString);
+  if(!threaded) unionThread(&task);
 
-  printf("index     %s\n", headString);
+  greater = unionElement(aGreater, greater, depth + 1, join);
+  if(threaded) joinThread(thread);
 
-  headString[0] = '\0';
-  titleString[0] = '\0';
+  return join(task.result, a, greater);
+}
 
-  count = printElement(tree->root, type, target);
-  printf((type == BY_KEY ? "%d record(s) fit your description.\n\n" : "you have %d contact(s).\n\n"), count);
+/*
+  unionThread
+  description
+    thread entry point merging the branches of a UnionTask.
+  params:
+    argument  the UnionTask being carried out.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+THREAD_RETURN THREAD_CALL unionThread(void* argument)
+{
+  UnionTask* task = (UnionTask*) argument;
+  task->result = unionElement(task->a, task->b, task->depth, task->join);
   return 0;
 }
 
 /*
-  printElement
+  reindexElement
   description
-    prints a given element.
+    gives the nodes of a branch holding a key new indexes, in
+    order, greater than that of any node yet created. Only the
+    path to them is followed.
   params:
-    node      node to be printed.
-    type      the type of comparison being carried out (if any).
-    target    the value being searched for.
+    node      root of the branch, which holds no lesser key.
+    key       the key.
   return: 
     NULL      0 value indicating successful exicution.
 */
-int printElement(NODE* node, FIND_BY type, void* target)
+int reindexElement(NODE* node, char* key)
 {
-  char* string = valueBufferA;
-  int count = 0;
   if(node == NULL) return 0;
+  if(strcmp(node->key, key) > 0) return reindexElement(getLess(node), key);
+  reindexElement(getLess(node), key);
+  setIndex(node, atomicAdd(&nodeIndex, 1));
+  return reindexElement(getGreater(node), key);
+}
 
-  count += printElement(node->less,type,target);
-  
-  if(type == BY_KEY || (type != -1 && !nodeCompareFind(node,type,target)) || (type == -1 && (node->greater == NULL && node->less == NULL)))
+/*
+  compareElements
+  description
+    qsort comparison of two node pointers.
+  params:
+    a         pointer to the first node pointer.
+    b         pointer to the second node pointer.
+  return: 
+    comparison
+              the ordinal comparison of the nodes.
+*/
+int compareElements(const void* a, const void* b)
+{
+  return nodeCompareSort(*((NODE**) a), *((NODE**) b));
+}
+
+/*
+  compareKeys
+  description
+    qsort comparison of two key strings.
+  params:
+    a         pointer to the first key.
+    b         pointer to the second key.
+  return: 
+    comparison
+              the ordinal comparison of the keys.
+*/
+int compareKeys(const void* a, const void* b)
+{
+  return strcmp(*((char**) a), *((char**) b));
+}
+
+/*
+  getElementP
+  description
+    function is used to prompt for an element discription, 
+    and find sed element.
+  params:
+    tree      tree to be searched.
+    ptr_branch
+              nodes are represented as pointers to nodes,
+              each node is connected to its children by pointers
+              to them, and this parameter is a pointer to one
+              such child pointer. the parameter takes the form of
+              a triple pointer so that the aforementioned pointer 
+              can be changed in this method and such changes will
+              be reflected in the calling function.
+  return: 
+    choice    the type of comparison carried to determine which
+              element is desired
+*/
+int getElementP(TREE* tree, int** ptr_branch)
+{
+
+  char* input = valueBufferC;
+  NODE* node;
+  FIND_BY choice = (FIND_BY) tree->treeDataPointers->findMenu();
+  if(choice != 1 && choice != 0)
   {
-    string[0] = '\0';
-    nodeToString(node, string);
-    printf("%s\n", string);
-    count++;
+    tree->treeDataPointers->prompt(choice, (void*) input);
   }
-  
-  
-  count+=printElement(node->greater, type, target);
-  return count;
+  else if(choice == 1)
+  {
+    *((int*) input) = getIndexIn();
+  }
+  else if(choice == 0)
+  {
+    input[0] = '\0';
+    return NULL;
+  }
+
+  //a search the values are looked up by finds its node in the
+  //lookup table, and then the node's slot by key
+  switch(lookupTree(tree, choice, (void*) input, &node, 1))
+  {
+    case -1: *ptr_branch = tree->engine->find(tree, choice, (void*) input); break;
+    case  0: *ptr_branch = NULL; break;
+    default: *ptr_branch = tree->engine->find(tree, BY_KEY, node);
+  }
+  input[0] = '\0';
+  return choice;
 }
 
 /*
-  createTitleString
+  getElement
   description
-    generates a table heading based on the name of the file from which 
-    initial records have been read in.
+    function is used to retrieve an element fitting its parameters.
   params:
-    tree      tree being printed.
-    type      the type of comparison being carried out.
-    titleString
-              the buffer to which the title is being printed
+    ptr_branch
+              the slot holding the handle connecting the node
+              being currently inspected with its parent.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared
+
   return: 
-    NULL      0 value indicating successful exicution.
+    ptr_branch
+              the slot holding the branch referencing the desired
+              node.
 */
-int createTitleString(TREE* tree, FIND_BY type, char titleString[])
+int* getElement(int* ptr_branch, FIND_BY type, void* value)
 {
-  int i = 0;
-  int titleLength;
-  char c[1];
-  char* address = tree->treeDataPointers->fileAddress;
   
-  titleString[0] = '\0';
-  sprintf(titleString, "%s TREE OF ", type == BY_KEY ? "COMPLETE" : "PARTIAL");
-  titleLength = strlen(titleString);
-  while(address[i] != '.' && address[i] != '\0')
+  int compare;
+  int* ptr_branch_temp = NULL;
+  if(type == BY_KEY) compare = nodeCompareSort(nodeAt(*ptr_branch), ((NODE*) value));
+  else if(*ptr_branch != NODE_NONE)
+  { 
+    compare = nodeCompareFind(nodeAt(*ptr_branch), type, value);
+  }
+  else return NULL;
+
+  if(compare == 0)
   {
-    c[0] = address[i++];
-    if(c[0] == '_' || (c[0] > 64 && c[0] < 91))
+    return ptr_branch;
+  }
+
+  if(type != BY_KEY || compare > 0)
+  {
+    ptr_branch_temp = &nodeAt(*ptr_branch)->less;
+    ptr_branch_temp = getElement(ptr_branch_temp, type, value);
+	if(ptr_branch_temp) return ptr_branch_temp;
+  }
+
+  if(type != BY_KEY || compare < 0)
+  {
+    ptr_branch_temp = &nodeAt(*ptr_branch)->greater;
+    ptr_branch_temp = getElement(ptr_branch_temp, type, value);
+	if(ptr_branch_temp) return ptr_branch_temp;
+  }
+  return ptr_branch_temp;
+
+}
+
+/*
+  findMany
+  description
+    looks up a batch of keys. Searches are carried out in groups
+    which descend the tree together, one level at a time, with the
+    next node of every search prefetched before it is compared. 
+    The memory latency of one search is hidden behind the work on
+    the others.
+  params:
+    tree      tree to be searched.
+    keys      the keys being searched for.
+    n         the number of keys.
+    results   filled with the node found for each key, or NULL
+              where the key is not in the tree.
+  return: 
+    found     the number of keys found.
+*/
+int findMany(TREE* tree, char** keys, size_t n, NODE** results)
+{
+  NODE* cursor[FIND_GROUP];
+  int* ptr_branch;
+  size_t group, i, size;
+  int active, compare, found = 0;
+
+  if(tree->engine != &binaryEngine)
+  {
+    for(i = 0; i < n; i++)
     {
+      ptr_branch = tree->engine->search(tree, keys[i]);
+      results[i] = ptr_branch != NULL ? nodeAt(*ptr_branch) : NULL;
+      found += ptr_branch != NULL;
+    }
+    return found;
+  }
 
-      titleString[titleLength++] = ' ';
+  lockTree(tree);
+  for(group = 0; group < n; group += FIND_GROUP)
+  {
+    size = n - group < FIND_GROUP ? n - group : FIND_GROUP;
+    for(i = 0; i < size; i++)
+    {
+      cursor[i] = nodeAt(tree->root);
+      results[group + i] = NULL;
+    }
 
-      if(c[0] == '_') continue;
+    active = tree->root != NODE_NONE;
+    while(active)
+    {
+      active = 0;
+      for(i = 0; i < size; i++)
+      {
+        if(cursor[i] == NULL) continue;
+
+        compare = strcmp(cursor[i]->key, keys[group + i]);
+        if(compare == 0)
+        {
+          results[group + i] = cursor[i];
+          cursor[i] = NULL;
+          found++;
+          continue;
+        }
+
+        cursor[i] = compare > 0 ? getLess(cursor[i]) : getGreater(cursor[i]);
+        if(cursor[i] != NULL)
+        {
+          PREFETCH(cursor[i]);
+          PREFETCH(cursor[i]->key);
+          active++;
+        }
+      }
     }
-    //capitalizing every char
-    titleString[titleLength++] = (c[0] > 96 && c[0] < 123) ? c[0] - 32 : c[0];
   }
-  titleString[titleLength++] = '\0';
+  unlockTree(tree);
+  return found;
+}
+
+/*
+  freezeTree
+  description
+    takes a new snapshot of the tree, replacing any existing one.
+  params:
+    tree      tree being frozen.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int freezeTree(TREE* tree)
+{
+  CollectContext context;
+
+  context.nodes = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  context.count = 0;
+  if(context.nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to freeze tree");
+    PAUSE
+    exit(0);
+  }
+  tree->engine->walk(tree, &collectVisit, (void*) &context);
+  deleteSnapshot(tree->snapshot);
+  tree->snapshot = newSnapshot(context.nodes, context.count);
+  tree->writeCount = 0;
+  free(context.nodes);
   return 0;
-}
\ No newline at end of file
+}
+
+/*
+  getSnapshotElement
+  description
+    finds a node by key using the tree's snapshot, which is
+    (re)built first if there is none or if more than 
+    SNAPSHOT_THRESHOLD writes have been made since it was taken.
+    Nodes added since then are found by searching the tree.
+    Intended for read mostly periods; removing or modifying an
+    element discards the snapshot.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    node      a node with the key, or NULL if none exists.
+*/
+NODE* getSnapshotElement(TREE* tree, char* key)
+{
+  NODE* node;
+
+  if(tree->snapshot == NULL || tree->writeCount >= SNAPSHOT_THRESHOLD)
+  {
+    freezeTree(tree);
+  }
+  node = findSnapshot(tree->snapshot, key);
+  if(node == NULL && tree->writeCount > 0)
+  {
+    findMany(tree, &key, 1, &node);
+  }
+  return node;
+}
+
+/*
+  recordWrite
+  description
+    counts writes made to the tree against its snapshot.
+  params:
+    tree      tree written to.
+    count     the number of elements written.
+    reordered whether elements were removed or moved, in which
+              case the snapshot can no longer be trusted and is
+              discarded.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int recordWrite(TREE* tree, int count, int reordered)
+{
+  atomicAdd(&tree->writeCount, count);
+  atomicAdd(&tree->churn, count);
+  if(count > 0 || reordered) tree->columnsStale = 1;
+  if(reordered && tree->snapshot != NULL)
+  {
+    deleteSnapshot(tree->snapshot);
+    tree->snapshot = NULL;
+  }
+  return 0;
+}
+
+/*
+  compactTree
+  description
+    moves the nodes of a BINARY_ENGINE tree, with their values,
+    into fresh memory in the order a search visits them (each
+    node followed by its lesser and then its greater branch), 
+    so that the top of the tree and each small branch sit in a
+    few blocks. Blocks left empty are released. Nodes taken from
+    the tree before it is compacted must not be used after.
+  params:
+    tree      tree being compacted.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int compactTree(TREE* tree)
+{
+  if(tree->engine != &binaryEngine)
+  {
+    printf("\nERROR: OPERATION NOT SUPPORTED BY TREE ENGINE\n");
+    return 0;
+  }
+  lockTree(tree);
+  tree->root = getHandle(compactElement(nodeAt(tree->root)));
+  unlockTree(tree);
+  //the snapshot and lookup table point at the nodes moved
+  recordWrite(tree, 0, 1);
+  tree->lookupStale = 1;
+  tree->bitmapsStale = 1;
+  releaseBlocks(tree->arena);
+  tree->churn = 0;
+  return 0;
+}
+
+/*
+  compactElement
+  description
+    moves a branch into fresh memory, see compactTree.
+  params:
+    node      root of the branch being moved.
+  return: 
+    node      the new location of the root.
+*/
+NODE* compactElement(NODE* node)
+{
+  NODE* moved;
+  if(node == NULL) return NULL;
+
+  moved = moveNode(node);
+  setLess(moved, compactElement(getLess(moved)));
+  setGreater(moved, compactElement(getGreater(moved)));
+  return moved;
+}
+
+/*
+  maintainLayout
+  description
+    compacts a tree once enough writes have been made to it for 
+    its nodes to have become scattered, and the share of its 
+    branches leading from one block to another is found to be 
+    above COMPACT_THRESHOLD.
+  params:
+    tree      tree being maintained.
+  return: 
+    compacted whether the tree was compacted.
+*/
+int maintainLayout(TREE* tree)
+{
+  int branches, scattered = 0;
+
+  if(!tree->treeDataPointers->compact || tree->engine != &binaryEngine) return 0;
+  //a tree which fits in a block cannot be scattered
+  if(tree->size <= NODE_BLOCK_SIZE || tree->churn < tree->size / COMPACT_INTERVAL) return 0;
+
+  tree->churn = 0;
+  lockTree(tree);
+  branches = measureLayout(nodeAt(tree->root), &scattered);
+  unlockTree(tree);
+  if(branches == 0 || scattered * 100 / branches <= COMPACT_THRESHOLD) return 0;
+
+  compactTree(tree);
+  return 1;
+}
+
+/*
+  measureLayout
+  description
+    counts the branches of a tree, and those leading to a node 
+    in a different block than their parent.
+  params:
+    node      root of the branch being measured.
+    scattered incremented for each branch leading to another
+              block.
+  return: 
+    count     the number of branches below the node.
+*/
+int measureLayout(NODE* node, int* scattered)
+{
+  int count = 0;
+  if(node == NULL) return 0;
+
+  if(getLess(node) != NULL)
+  {
+    *scattered += getLess(node)->handle >> NODE_BLOCK_BITS != node->handle >> NODE_BLOCK_BITS;
+    count += 1 + measureLayout(getLess(node), scattered);
+  }
+  if(getGreater(node) != NULL)
+  {
+    *scattered += getGreater(node)->handle >> NODE_BLOCK_BITS != node->handle >> NODE_BLOCK_BITS;
+    count += 1 + measureLayout(getGreater(node), scattered);
+  }
+  return count;
+}
+
+/*
+  getIndexIn
+  description
+    prompts for and gets the index of the desired element.
+  params:
+    void
+  return: 
+    index     the index of the desired element.
+*/
+int getIndexIn(void)
+{
+  int index; 
+  printf("please enter the index number of the desired contact.");
+  scanf("%d", &index);
+  return index;
+}
+
+
+/*
+  printEntry
+  description
+    request an element discription from the user then print
+    the value's info at full size.
+  params:
+    tree      tree in which the element is located.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int printEntry(TREE* tree)
+{
+  char* valueString = valueBufferC;
+
+
+  
+  int* ptr_branch = &(tree->root);
+  int choice = getElementP(tree, &ptr_branch);
+
+
+  if(ptr_branch != NULL && *ptr_branch != NODE_NONE && choice != 0)
+  {
+
+    getFunctions(nodeAt(*ptr_branch))->toString(getValue(nodeAt(*ptr_branch)), valueString, 1);
+    printf("\n%s\n", valueString);
+
+  }
+  else if(choice)
+  {
+    printf("\nERROR: INPUT NOT FOUND\n");
+  }
+  valueString[0] = '\0';
+  return 0;
+}
+
+
+/*
+  printTree
+  description
+    prints formatted tree in tabular form using the criteria provided,
+    clearing the screen first when the tree is interactive.
+  params:
+    tree      tree being printed.
+    type      the type of comparison being carried out (if any).
+    target    the value being searched for.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int printTree(TREE* tree, FIND_BY type, void* target)
+{
+  if(tree->treeDataPointers->interactive) CLEAR
+  return renderTree(tree, type, target, stdout);
+}
+
+/*
+  renderTree
+  description
+    writes formatted tree in tabular form to a file using the
+    criteria provided. Rows are rendered into the buffer of a
+    renderer and written out in large blocks, so that large
+    tables are bound by the writes rather than by formatting.
+  params:
+    tree      tree being printed.
+    type      the type of comparison being carried out (if any).
+    target    the value being searched for.
+    file      the file written to.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int renderTree(TREE* tree, FIND_BY type, void* target, FILE* file)
+{
+  char* headString = valueBufferA;
+  char* titleString = valueBufferB;
+
+  int i;
+  int ws;
+
+  PrintContext context;
+
+  tree->treeDataPointers->tableHeader(headString);
+  createTitleString(tree, type, titleString);
+  context.renderer = newRenderer(file);
+
+  ws = strlen(headString)/2 + 5 - strlen(titleString)/2;
+  renderSpaces(context.renderer, ws);
+  renderText(context.renderer, titleString);
+  renderText(context.renderer, "\n\nindex     ");
+  renderText(context.renderer, headString);
+  renderChar(context.renderer, '\n');
+
+  headString[0] = '\0';
+  titleString[0] = '\0';
+
+  context.type = type;
+  context.target = target;
+  context.count = 0;
+  context.nodes = NULL;
+  //nodes found by searches through the column store, or which 
+  //the values have their own order for, are collected and sorted
+  //before they are printed
+  if(type != BY_KEY && (tree->functionPointers->sortKey != NULL || tree->functionPointers->scanColumns != NULL))
+  {
+    context.nodes = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+    if(context.nodes == NULL)
+    {
+      printf("sufficient memory could not be allocated to print tree");
+      PAUSE
+      exit(0);
+    }
+  }
+  if(context.nodes == NULL || (context.count = scanTree(tree, type, target, context.nodes)) < 0)
+  {
+    context.count = 0;
+    tree->engine->walk(tree, &printVisit, (void*) &context);
+  }
+  if(context.nodes != NULL)
+  {
+    if(tree->functionPointers->sortKey != NULL) radixSortElements(context.nodes, context.count, type);
+    for(i = 0; i < context.count; i++) renderNode(context.nodes[i], context.renderer);
+    free(context.nodes);
+  }
+  deleteRenderer(context.renderer);
+  fprintf(file, (type == BY_KEY ? "%d record(s) fit your description.\n\n" : "you have %d contact(s).\n\n"), context.count);
+  return 0;
+}
+
+/*
+  renderElement
+  description
+    adds the row of a given element to the output of a renderer
+    if it fits the criteria provided.
+  params:
+    node      node to be printed.
+    type      the type of comparison being carried out (if any).
+    target    the value being searched for.
+    renderer  renderer the row is added to.
+  return: 
+    printed   1 if the element was printed, otherwise 0.
+*/
+int renderElement(NODE* node, FIND_BY type, void* target, RENDERER* renderer)
+{
+  if(fitsElement(node, type, target))
+  {
+    renderNode(node, renderer);
+    return 1;
+  }
+  return 0;
+}
+
+/*
+  fitsElement
+  description
+    tests whether an element fits the criteria of printTree.
+  params:
+    node      node being tested.
+    type      the type of comparison being carried out (if any).
+    target    the value being searched for.
+  return: 
+    fits      1 if the element fits, otherwise 0.
+*/
+int fitsElement(NODE* node, FIND_BY type, void* target)
+{
+  if(node == NULL) return 0;
+  return type == BY_KEY || (type != LEAVES && !nodeCompareFind(node,type,target)) || (type == LEAVES && (getGreater(node) == NULL && getLess(node) == NULL));
+}
+
+/*
+  scanTree
+  description
+    finds every node whose value compareFind finds equal to a
+    target, through the lookup table or a bitmap index of the
+    field searched if it has one, otherwise by scanning the 
+    column store of the tree (which is rebuilt first if there
+    is none or if writes have been made since it was built) 
+    rather than walking the tree.
+  params:
+    tree      tree being searched.
+    type      the type of comparison being carried out.
+    target    the value being searched for.
+    results   filled with the nodes found, in key order. It
+              must have room for one more node than the tree
+              holds.
+  return: 
+    count     the number of nodes found, or -1 if the values of
+              the tree cannot be searched this way.
+*/
+int scanTree(TREE* tree, FIND_BY type, void* target, NODE** results)
+{
+  BITMAP* bitmap;
+  int *handles, i, count;
+
+  if(type == BY_KEY || type == LEAVES) return -1;
+  if((count = lookupTree(tree, type, target, results, tree->size + 1)) >= 0)
+  {
+    qsort(results, count, sizeof(NODE*), &compareElements);
+    return count;
+  }
+  if((bitmap = bitmapTree(tree, type, target)) != NULL)
+  {
+    count = bitmapElements(bitmap, results);
+    qsort(results, count, sizeof(NODE*), &compareElements);
+    return count;
+  }
+  if(tree->functionPointers->scanColumns == NULL) return -1;
+  if(tree->columns == NULL || tree->columnsStale) buildColumns(tree);
+
+  handles = (int*) malloc((tree->size + 1) * sizeof(int));
+  if(handles == NULL)
+  {
+    printf("sufficient memory could not be allocated to scan tree");
+    PAUSE
+    exit(0);
+  }
+  count = tree->functionPointers->scanColumns(tree->columns, type, target, handles);
+  for(i = 0; i < count; i++) results[i] = nodeAt(handles[i]);
+  free(handles);
+  return count;
+}
+
+/*
+  completeTree
+  description
+    finds the values of a field beginning with a prefix which
+    are held by the most nodes, through the column store of 
+    the tree (which is rebuilt first if it is stale). The time
+    taken depends on the length of the prefix, not the size 
+    of the tree, once the store is built.
+  params:
+    tree      tree being searched.
+    type      the field being completed.
+    prefix    the beginning of the values being completed.
+    k         the most values to return.
+    names     filled with the values found, most held first.
+    counts    filled with the number of nodes holding each 
+              value found.
+  return: 
+    count     the number of values found, or -1 if the field
+              cannot be completed.
+*/
+int completeTree(TREE* tree, FIND_BY type, char* prefix, int k, char** names, int* counts)
+{
+  if(tree->functionPointers->completeColumns == NULL || type == BY_KEY || type == LEAVES) return -1;
+  if(tree->columns == NULL || tree->columnsStale) buildColumns(tree);
+  return tree->functionPointers->completeColumns(tree->columns, type, prefix, k, names, counts);
+}
+
+/*
+  printCompletions
+  description
+    prints the COMPLETION_COUNT values of a field beginning
+    with a prefix which are held by the most nodes.
+  params:
+    tree      tree being searched.
+    type      the field being completed.
+    prefix    the beginning of the values being completed.
+  return: 
+    count     the number of values printed.
+*/
+int printCompletions(TREE* tree, FIND_BY type, char* prefix)
+{
+  char* names[COMPLETION_COUNT];
+  int counts[COMPLETION_COUNT];
+  int i, count = completeTree(tree, type, prefix, COMPLETION_COUNT, names, counts);
+
+  if(count < 0)
+  {
+    printf("\nERROR: FIELD CANNOT BE COMPLETED\n");
+    return 0;
+  }
+  printf("\n%-10s%s\n", "count", "completion");
+  for(i = 0; i < count; i++) printf("%-10d%s\n", counts[i], names[i]);
+  printf("%d completion(s) begin with \"%s\".\n\n", count, prefix);
+  return count;
+}
+
+/*
+  buildColumns
+  description
+    (re)builds the column store of a tree from its values, in
+    key order.
+  params:
+    tree      tree whose values are being copied.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int buildColumns(TREE* tree)
+{
+  CollectContext context;
+  void** values;
+  int* handles;
+  int i;
+
+  context.nodes = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  values = (void**) malloc((tree->size + 1) * sizeof(void*));
+  handles = (int*) malloc((tree->size + 1) * sizeof(int));
+  if(context.nodes == NULL || values == NULL || handles == NULL)
+  {
+    printf("sufficient memory could not be allocated to build columns");
+    PAUSE
+    exit(0);
+  }
+  //writes made while the tree is walked leave the store stale
+  tree->columnsStale = 0;
+  context.count = 0;
+  tree->engine->walk(tree, &collectVisit, (void*) &context);
+  for(i = 0; i < context.count; i++)
+  {
+    values[i] = getValue(context.nodes[i]);
+    handles[i] = getHandle(context.nodes[i]);
+  }
+  if(tree->columns != NULL) tree->functionPointers->deleteColumns(tree->columns);
+  tree->columns = tree->functionPointers->newColumns(values, handles, context.count);
+
+  free(context.nodes);
+  free(values);
+  free(handles);
+  return 0;
+}
+
+/*
+  lookupTree
+  description
+    finds the nodes a search looks up through the lookup table
+    of the tree, building the table if there is none or if it
+    is stale. The time taken does not depend on the size of
+    the tree.
+  params:
+    tree      tree being searched.
+    type      the type of search.
+    target    the value being searched for.
+    results   filled with the nodes found.
+    limit     the most nodes to return.
+  return:
+    count     the number of nodes found, or -1 if the search is
+              not looked up.
+*/
+int lookupTree(TREE* tree, FIND_BY type, void* target, NODE** results, int limit)
+{
+  int group[FIND_GROUP], *handles = group;
+  long long key;
+  int count, i;
+
+  if(tree->functionPointers->lookupTarget == NULL || type == BY_KEY || type == LEAVES) return -1;
+  if((key = tree->functionPointers->lookupTarget(type, target)) < 0) return -1;
+  if(tree->lookup == NULL || tree->lookupStale) buildLookup(tree);
+
+  //a single lookup needs no allocation
+  if(limit > FIND_GROUP) handles = (int*) malloc(limit * sizeof(int));
+  if(handles == NULL)
+  {
+    printf("sufficient memory could not be allocated to look up tree");
+    PAUSE
+    exit(0);
+  }
+  count = lookupFind(tree->lookup, key, handles, limit);
+  for(i = 0; i < count; i++) results[i] = nodeAt(handles[i]);
+  if(handles != group) free(handles);
+  return count;
+}
+
+/*
+  buildLookup
+  description
+    (re)builds the lookup table of a tree from its values.
+  params:
+    tree      tree whose values are being looked up.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int buildLookup(TREE* tree)
+{
+  CollectContext context;
+  long long key;
+  int i;
+
+  context.nodes = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  if(context.nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to build lookup table");
+    PAUSE
+    exit(0);
+  }
+  context.count = 0;
+  tree->engine->walk(tree, &collectVisit, (void*) &context);
+  deleteLookupTable(tree->lookup);
+  tree->lookup = newLookupTable(context.count);
+  tree->lookupStale = 0;
+  for(i = 0; i < context.count; i++)
+  {
+    if((key = nodeLookupKey(context.nodes[i])) >= 0) lookupInsert(tree->lookup, key, getHandle(context.nodes[i]));
+  }
+  free(context.nodes);
+  return 0;
+}
+
+/*
+  indexElement
+  description
+    records a node added to a tree in the tree's lookup table
+    and bitmaps, those which it has and which are up to date.
+  params:
+    tree      tree the node is being added to.
+    node      node being added.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int indexElement(TREE* tree, NODE* node)
+{
+  BITMAP_INDEX* index;
+  long long key;
+  int bitmapKey;
+
+  if(tree->lookup != NULL && !tree->lookupStale && (key = nodeLookupKey(node)) >= 0)
+  {
+    lookupInsert(tree->lookup, key, getHandle(node));
+  }
+  if(tree->everyBitmap != NULL && !tree->bitmapsStale)
+  {
+    lockMutex(&tree->bitmapLock);
+    bitmapAdd(tree->everyBitmap, (unsigned int) getHandle(node));
+    for(index = tree->bitmaps; index != NULL; index = index->next)
+    {
+      if((bitmapKey = nodeBitmapKey(node, index->type)) >= 0) bitmapAdd(indexBitmap(index, bitmapKey, 1), (unsigned int) getHandle(node));
+    }
+    unlockMutex(&tree->bitmapLock);
+  }
+  return 0;
+}
+
+/*
+  unindexElement
+  description
+    removes a node from a tree's lookup table and bitmaps, 
+    before it is removed from the tree or its value is changed.
+  params:
+    tree      tree the node is being removed from.
+    node      node being removed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int unindexElement(TREE* tree, NODE* node)
+{
+  BITMAP_INDEX* index;
+  long long key;
+  int bitmapKey;
+
+  if(tree->lookup != NULL && !tree->lookupStale && (key = nodeLookupKey(node)) >= 0)
+  {
+    lookupRemove(tree->lookup, key, getHandle(node));
+  }
+  if(tree->everyBitmap != NULL && !tree->bitmapsStale)
+  {
+    lockMutex(&tree->bitmapLock);
+    bitmapRemove(tree->everyBitmap, (unsigned int) getHandle(node));
+    for(index = tree->bitmaps; index != NULL; index = index->next)
+    {
+      if((bitmapKey = nodeBitmapKey(node, index->type)) >= 0) bitmapRemove(indexBitmap(index, bitmapKey, 1), (unsigned int) getHandle(node));
+    }
+    unlockMutex(&tree->bitmapLock);
+  }
+  return 0;
+}
+
+/*
+  bitmapTree
+  description
+    finds the bitmap of the handles of the nodes a search is
+    for, through the bitmap index of the field searched. The
+    index is created the first time the field is searched. 
+    Bitmaps of several searches can be combined with 
+    bitmapAnd, bitmapOr and bitmapAndNot (against bitmapTreeAll
+    for the nodes a search is not for).
+  params:
+    tree      tree being searched.
+    type      the type of search.
+    target    the value being searched for.
+  return:
+    bitmap*   the bitmap, which belongs to the tree and must
+              not be changed. It is kept up to date as the tree
+              is written, under tree->bitmapLock, which is held
+              while it is read if the tree may be written at
+              the same time. NULL if the search has no index.
+*/
+BITMAP* bitmapTree(TREE* tree, FIND_BY type, void* target)
+{
+  BITMAP_INDEX* index;
+  BITMAP* bitmap;
+  int key;
+
+  if(tree->functionPointers->bitmapTarget == NULL || type == BY_KEY) return NULL;
+  if((key = tree->functionPointers->bitmapTarget(type, target)) < 0) return NULL;
+  if((index = getBitmapIndex(tree, type)) == NULL) return NULL;
+  lockMutex(&tree->bitmapLock);
+  //a value no node holds has an empty bitmap
+  bitmap = indexBitmap(index, key, 1);
+  unlockMutex(&tree->bitmapLock);
+  return bitmap;
+}
+
+/*
+  bitmapTreeAll
+  description
+    finds the bitmap of the handles of every node of a tree.
+  params:
+    tree      tree being searched.
+  return:
+    bitmap*   the bitmap, which belongs to the tree and must
+              not be changed.
+*/
+BITMAP* bitmapTreeAll(TREE* tree)
+{
+  if(tree->everyBitmap == NULL || tree->bitmapsStale) buildBitmaps(tree);
+  return tree->everyBitmap;
+}
+
+/*
+  bitmapElements
+  description
+    finds the nodes whose handles a bitmap holds.
+  params:
+    bitmap    the bitmap.
+    results   filled with the nodes, in the order of their
+              handles. It must have room for bitmapCount nodes.
+  return:
+    count     the number of nodes.
+*/
+int bitmapElements(BITMAP* bitmap, NODE** results)
+{
+  unsigned int* handles = (unsigned int*) malloc((bitmapCount(bitmap) + 1) * sizeof(unsigned int));
+  int count, i;
+
+  if(handles == NULL)
+  {
+    printf("sufficient memory could not be allocated to list bitmap");
+    PAUSE
+    exit(0);
+  }
+  count = bitmapValues(bitmap, handles);
+  for(i = 0; i < count; i++) results[i] = nodeAt((int) handles[i]);
+  free(handles);
+  return count;
+}
+
+/*
+  countTree
+  description
+    counts the nodes a search is for through the bitmap index
+    of the field searched, without visiting them.
+  params:
+    tree      tree being searched.
+    type      the type of search.
+    target    the value being searched for.
+  return:
+    count     the number of nodes, or -1 if the search has no
+              index.
+*/
+int countTree(TREE* tree, FIND_BY type, void* target)
+{
+  BITMAP* bitmap = bitmapTree(tree, type, target);
+  return bitmap == NULL ? -1 : bitmapCount(bitmap);
+}
+
+/*
+  getBitmapIndex
+  description
+    finds the bitmap index of a field, creating it from the
+    values of the tree if there is none, and rebuilding the
+    bitmaps if they are stale.
+  params:
+    tree      tree being indexed.
+    type      the type of search answered by the index.
+  return:
+    index*    the index, or NULL if the values have no bitmap
+              indexes.
+*/
+BITMAP_INDEX* getBitmapIndex(TREE* tree, FIND_BY type)
+{
+  BITMAP_INDEX* index;
+
+  if(tree->functionPointers->bitmapKey == NULL) return NULL;
+  if(tree->everyBitmap == NULL || tree->bitmapsStale) buildBitmaps(tree);
+  for(index = tree->bitmaps; index != NULL && index->type != type; index = index->next);
+  if(index != NULL) return index;
+
+  index = newBitmapIndex(type);
+  index->next = tree->bitmaps;
+  tree->bitmaps = index;
+  buildBitmaps(tree);
+  return index;
+}
+
+/*
+  buildBitmaps
+  description
+    (re)builds every bitmap of a tree from its values.
+  params:
+    tree      tree whose values are being indexed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int buildBitmaps(TREE* tree)
+{
+  CollectContext context;
+  BITMAP_INDEX* index;
+  int i, key;
+
+  context.nodes = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  if(context.nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to build bitmaps");
+    PAUSE
+    exit(0);
+  }
+  context.count = 0;
+  tree->engine->walk(tree, &collectVisit, (void*) &context);
+
+  lockMutex(&tree->bitmapLock);
+  deleteBitmap(tree->everyBitmap);
+  tree->everyBitmap = newBitmap();
+  for(i = 0; i < context.count; i++) bitmapAdd(tree->everyBitmap, (unsigned int) getHandle(context.nodes[i]));
+  for(index = tree->bitmaps; index != NULL; index = index->next)
+  {
+    for(key = 0; key < index->keyCount; key++)
+    {
+      deleteBitmap(index->bitmaps[key]);
+      index->bitmaps[key] = NULL;
+    }
+    for(i = 0; i < context.count; i++)
+    {
+      if((key = nodeBitmapKey(context.nodes[i], index->type)) >= 0) bitmapAdd(indexBitmap(index, key, 1), (unsigned int) getHandle(context.nodes[i]));
+    }
+  }
+  tree->bitmapsStale = 0;
+  unlockMutex(&tree->bitmapLock);
+  free(context.nodes);
+  return 0;
+}
+
+/*
+  rangeTree
+  description
+    visits the nodes whose keys begin with a prefix, in order.
+    A BINARY_ENGINE tree is descended only into the branches 
+    which can hold such keys, other engines are walked from 
+    their first node until a key past the prefix is reached.
+    As with walkBinaryElement, visit must not look up or write
+    to a RELAXED_BALANCE tree it is walking.
+  params:
+    tree      tree being walked.
+    prefix    the beginning of the keys visited.
+    visit     function called with the branch referencing
+              each node, returning nonzero stops the walk.
+    context   passed on to visit.
+  return: 
+    stop      nonzero if the walk was stopped by visit.
+*/
+int rangeTree(TREE* tree, char* prefix, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  RangeContext range;
+  int stopped;
+
+  range.prefix = prefix;
+  range.length = strlen(prefix);
+  range.visit = visit;
+  range.context = context;
+  if(tree->engine != &binaryEngine)
+  {
+    tree->engine->walk(tree, &rangeVisit, (void*) &range);
+    //the walk is also stopped when the range is passed
+    return range.prefix == NULL;
+  }
+  lockTree(tree);
+  stopped = rangeElement(&(tree->root), prefix, range.length, visit, context);
+  unlockTree(tree);
+  return stopped;
+}
+
+/*
+  rangeElement
+  description
+    visits the nodes of a branch whose keys begin with a
+    prefix, in order.
+  params:
+    ptr_branch
+              the branch being walked.
+    prefix    the beginning of the keys visited.
+    length    the length of the prefix.
+    visit     function called with the branch referencing
+              each node, returning nonzero stops the walk.
+    context   passed on to visit.
+  return: 
+    stop      nonzero if the walk was stopped.
+*/
+int rangeElement(int* ptr_branch, char* prefix, int length, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  int comp;
+
+  if(*ptr_branch == NODE_NONE) return 0;
+  comp = strncmp(nodeAt(*ptr_branch)->key, prefix, length);
+  if(comp >= 0 && rangeElement(&nodeAt(*ptr_branch)->less, prefix, length, visit, context)) return 1;
+  if(comp == 0 && visit(ptr_branch, context)) return 1;
+  if(comp <= 0) return rangeElement(&nodeAt(*ptr_branch)->greater, prefix, length, visit, context);
+  return 0;
+}
+
+/*
+  rangeVisit
+  description
+    walk visitor which passes on the nodes whose keys begin
+    with the prefix held in a RangeContext, and stops the walk 
+    at the first key past them.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the RangeContext, whose prefix is set to NULL if
+              the walk is stopped by its visitor.
+  return: 
+    stop      1 once the range has been passed, otherwise 0.
+*/
+int rangeVisit(int* ptr_branch, void* context)
+{
+  RangeContext* range = (RangeContext*) context;
+  int comp = strncmp(nodeAt(*ptr_branch)->key, range->prefix, range->length);
+
+  if(comp < 0) return 0;
+  if(comp > 0) return 1;
+  if(range->visit(ptr_branch, range->context))
+  {
+    range->prefix = NULL;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+  countRange
+  description
+    counts the nodes whose keys begin with a prefix. A 
+    BINARY_ENGINE tree keeps the weight of each branch, so
+    that whole branches inside the range are counted without
+    being visited, and the time taken depends on the height
+    of the tree rather than the size of the range.
+  params:
+    tree      tree being counted.
+    prefix    the beginning of the keys counted.
+  return: 
+    count     the number of nodes, or -1 if the tree does not
+              keep the weights of its branches.
+*/
+int countRange(TREE* tree, char* prefix)
+{
+  NODE* node;
+  int length = strlen(prefix), comp, count;
+
+  if(tree->engine != &binaryEngine) return -1;
+  lockTree(tree);
+  //the first node inside the range splits it between its branches
+  for(node = nodeAt(tree->root); node != NULL; node = comp < 0 ? getGreater(node) : getLess(node))
+  {
+    comp = strncmp(node->key, prefix, length);
+    if(comp == 0) break;
+  }
+  if(node == NULL) count = 0;
+  else count = countFromElement(getLess(node), prefix, length) + 1 + countToElement(getGreater(node), prefix, length);
+  unlockTree(tree);
+  return count;
+}
+
+/*
+  countFromElement
+  description
+    counts the nodes of a branch whose keys are not before
+    the keys beginning with a prefix.
+  params:
+    node      root of the branch.
+    prefix    the beginning of the keys of the range.
+    length    the length of the prefix.
+  return: 
+    count     the number of nodes.
+*/
+int countFromElement(NODE* node, char* prefix, int length)
+{
+  int count = 0;
+
+  while(node != NULL)
+  {
+    if(strncmp(node->key, prefix, length) >= 0)
+    {
+      count += elementWeight(getGreater(node)) + 1;
+      node = getLess(node);
+    }
+    else node = getGreater(node);
+  }
+  return count;
+}
+
+/*
+  countToElement
+  description
+    counts the nodes of a branch whose keys are not after
+    the keys beginning with a prefix.
+  params:
+    node      root of the branch.
+    prefix    the beginning of the keys of the range.
+    length    the length of the prefix.
+  return: 
+    count     the number of nodes.
+*/
+int countToElement(NODE* node, char* prefix, int length)
+{
+  int count = 0;
+
+  while(node != NULL)
+  {
+    if(strncmp(node->key, prefix, length) <= 0)
+    {
+      count += elementWeight(getLess(node)) + 1;
+      node = getGreater(node);
+    }
+    else node = getLess(node);
+  }
+  return count;
+}
+
+/*
+  radixSortElements
+  description
+    sorts nodes by the sort key of their values (see the sortKey
+    function pointer) for a type of search, RADIX_BITS of the 
+    key at a time from the lowest. Nodes with equal keys keep 
+    their order. Nothing is done if the values are not sorted 
+    for the search.
+  params:
+    nodes     array of nodes being sorted.
+    count     the number of nodes.
+    type      the type of search which found the nodes.
+  return: 
+    passes    the number of passes made.
+*/
+int radixSortElements(NODE** nodes, int count, FIND_BY type)
+{
+  long long *keys, *sortedKeys, *swapKeys, highest = 0;
+  NODE **sorted, **swapNodes;
+  int *buckets, i, shift, passes = 0;
+
+  if(count < 2 || getFunctions(nodes[0])->sortKey(getValue(nodes[0]), type) < 0) return 0;
+
+  keys = (long long*) malloc(count * 2 * sizeof(long long));
+  sorted = (NODE**) malloc(count * sizeof(NODE*));
+  buckets = (int*) malloc(((1 << RADIX_BITS) + 1) * sizeof(int));
+  if(keys == NULL || sorted == NULL || buckets == NULL)
+  {
+    printf("sufficient memory could not be allocated to sort tree");
+    PAUSE
+    exit(0);
+  }
+  sortedKeys = keys + count;
+  for(i = 0; i < count; i++)
+  {
+    keys[i] = getFunctions(nodes[i])->sortKey(getValue(nodes[i]), type);
+    if(keys[i] > highest) highest = keys[i];
+  }
+
+  //only the passes needed to cover the highest key are made
+  for(shift = 0; shift < 64 && (highest >> shift) != 0; shift += RADIX_BITS)
+  {
+    memset(buckets, 0, ((1 << RADIX_BITS) + 1) * sizeof(int));
+    for(i = 0; i < count; i++) buckets[((keys[i] >> shift) & ((1 << RADIX_BITS) - 1)) + 1]++;
+    for(i = 0; i < 1 << RADIX_BITS; i++) buckets[i + 1] += buckets[i];
+    for(i = 0; i < count; i++)
+    {
+      int position = buckets[(keys[i] >> shift) & ((1 << RADIX_BITS) - 1)]++;
+      sortedKeys[position] = keys[i];
+      sorted[position] = nodes[i];
+    }
+    swapKeys = keys;
+    keys = sortedKeys;
+    sortedKeys = swapKeys;
+    swapNodes = nodes;
+    nodes = sorted;
+    sorted = swapNodes;
+    passes++;
+  }
+  //an odd number of passes leaves the result in the spare array
+  if(passes % 2) memcpy(sorted, nodes, count * sizeof(NODE*));
+
+  free(keys < sortedKeys ? keys : sortedKeys);
+  free(passes % 2 ? nodes : sorted);
+  free(buckets);
+  return passes;
+}
+
+/*
+  createTitleString
+  description
+    generates a table heading based on the name of the file from which 
+    initial records have been read in.
+  params:
+    tree      tree being printed.
+    type      the type of comparison being carried out.
+    titleString
+              the buffer to which the title is being printed
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int createTitleString(TREE* tree, FIND_BY type, char titleString[])
+{
+  int i = 0;
+  int titleLength;
+  char c[1];
+  char* address = tree->treeDataPointers->fileAddress;
+  
+  titleString[0] = '\0';
+  sprintf(titleString, "%s TREE OF ", type == BY_KEY ? "COMPLETE" : "PARTIAL");
+  titleLength = strlen(titleString);
+  while(address[i] != '.' && address[i] != '\0')
+  {
+    c[0] = address[i++];
+    if(c[0] == '_' || (c[0] > 64 && c[0] < 91))
+    {
+
+      titleString[titleLength++] = ' ';
+
+      if(c[0] == '_') continue;
+    }
+    //capitalizing every char
+    titleString[titleLength++] = (c[0] > 96 && c[0] < 123) ? c[0] - 32 : c[0];
+  }
+  titleString[titleLength++] = '\0';
+  return 0;
+}
+/*
+  getEngine
+  description
+    returns the operations of a TREE_ENGINE.
+  params:
+    engine    the engine requested.
+  return: 
+    engine    the engine's function pointers, the BINARY_ENGINE
+              if the engine is not recognised.
+*/
+TreeEnginePointers* getEngine(TREE_ENGINE engine)
+{
+  switch(engine)
+  {
+    case BTREE_ENGINE:  return &bTreeEngine;
+    case ART_ENGINE:    return &artEngine;
+    case SKIPLIST_ENGINE:
+                        return &skipEngine;
+    default:            return &binaryEngine;
+  }
+}
+
+/*
+  getBalance
+  description
+    returns the operations of a BALANCE_POLICY.
+  params:
+    policy    the policy requested.
+  return: 
+    balance   the policy's function pointers, ADHOC_BALANCE 
+              if the policy is not recognised.
+*/
+BalancePointers* getBalance(BALANCE_POLICY policy)
+{
+  switch(policy)
+  {
+    case AVL_BALANCE:   return &avlBalance;
+    case RED_BLACK_BALANCE:
+                        return &redBlackBalance;
+    case TREAP_BALANCE: return &treapBalance;
+    case SCAPEGOAT_BALANCE:
+                        return &scapegoatBalance;
+    case SPLAY_BALANCE: return &splayBalance;
+    case RELAXED_BALANCE:
+                        return &relaxedBalance;
+    default:            return &adhocBalance;
+  }
+}
+
+/*
+  scanElement
+  description
+    finds the first node, in order, which fits a FIND_BY 
+    comparison by walking the whole tree.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the slot holding the node, or NULL if none fits.
+*/
+int* scanElement(TREE* tree, FIND_BY type, void* value)
+{
+  MatchContext context;
+  context.type = type;
+  context.value = value;
+  context.result = NULL;
+  tree->engine->walk(tree, &matchVisit, (void*) &context);
+  return context.result;
+}
+
+/*
+  matchVisit
+  description
+    walk visitor which stops at the first node fitting the
+    comparison held in a MatchContext.
+  params:
+    ptr_branch
+              slot of the node being visited.
+    context   the MatchContext.
+  return: 
+    stop      1 once a node has been found.
+*/
+int matchVisit(int* ptr_branch, void* context)
+{
+  MatchContext* match = (MatchContext*) context;
+  if(nodeCompareFind(nodeAt(*ptr_branch), match->type, match->value)) return 0;
+  match->result = ptr_branch;
+  return 1;
+}
+
+/*
+  collectVisit
+  description
+    walk visitor which writes each node into a CollectContext.
+  params:
+    ptr_branch
+              slot of the node being visited.
+    context   the CollectContext.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int collectVisit(int* ptr_branch, void* context)
+{
+  CollectContext* collect = (CollectContext*) context;
+  collect->nodes[collect->count++] = nodeAt(*ptr_branch);
+  return 0;
+}
+
+/*
+  printVisit
+  description
+    walk visitor which prints each node fitting the criteria
+    held in a PrintContext, or collects it to be sorted.
+  params:
+    ptr_branch
+              slot of the node being visited.
+    context   the PrintContext.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int printVisit(int* ptr_branch, void* context)
+{
+  PrintContext* print = (PrintContext*) context;
+  if(print->nodes == NULL) print->count += renderElement(nodeAt(*ptr_branch), print->type, print->target, print->renderer);
+  else if(fitsElement(nodeAt(*ptr_branch), print->type, print->target)) print->nodes[print->count++] = nodeAt(*ptr_branch);
+  return 0;
+}
+
+/*
+  saveVisit
+  description
+    walk visitor which writes each node to a file.
+  params:
+    ptr_branch
+              slot of the node being visited.
+    context   the file being written to.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int saveVisit(int* ptr_branch, void* context)
+{
+  getFunctions(nodeAt(*ptr_branch))->saveValue((FILE*) context, getValue(nodeAt(*ptr_branch)));
+  return 0;
+}
+
+/*
+  insertBinaryElement
+  description
+    BINARY_ENGINE insert, links the node into the tree under
+    the tree's BALANCE_POLICY.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertBinaryElement(TREE* tree, NODE* node)
+{
+  return tree->balance->insert(tree, node);
+}
+
+/*
+  removeBinaryElement
+  description
+    BINARY_ENGINE remove, unlinks a node from the tree under
+    the tree's BALANCE_POLICY.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the branch referencing the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeBinaryElement(TREE* tree, int* ptr_branch)
+{
+  return tree->balance->remove(tree, ptr_branch);
+}
+
+/*
+  findBinaryElement
+  description
+    BINARY_ENGINE find, carried out by the tree's 
+    BALANCE_POLICY.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the branch referencing the node, or NULL.
+*/
+int* findBinaryElement(TREE* tree, FIND_BY type, void* value)
+{
+  return tree->balance->find(tree, type, value);
+}
+
+/*
+  searchBinaryElement
+  description
+    BINARY_ENGINE search, carried out by the tree's 
+    BALANCE_POLICY.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    ptr_branch
+              the branch referencing a node with the key, 
+              or NULL.
+*/
+int* searchBinaryElement(TREE* tree, char* key)
+{
+  return tree->balance->search(tree, key);
+}
+
+/*
+  walkBinaryElement
+  description
+    BINARY_ENGINE walk. A RELAXED_BALANCE tree is locked for
+    the whole walk, and its lock is not recursive, so visit 
+    must not add, remove or look up nodes of the same tree.
+  params:
+    tree      tree being walked.
+    visit     function called with the branch referencing
+              each node, returning nonzero stops the walk.
+    context   passed on to visit.
+  return: 
+    stop      nonzero if the walk was stopped.
+*/
+int walkBinaryElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  int stopped;
+  lockTree(tree);
+  stopped = walkElement(&(tree->root), visit, context);
+  unlockTree(tree);
+  return stopped;
+}
+
+/*
+  walkElement
+  description
+    visits every node of a branch in order.
+  params:
+    ptr_branch
+              the branch being walked.
+    visit     function called with the branch referencing
+              each node, returning nonzero stops the walk.
+    context   passed on to visit.
+  return: 
+    stop      nonzero if the walk was stopped.
+*/
+int walkElement(int* ptr_branch, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  if(*ptr_branch == NODE_NONE) return 0;
+  if(walkElement(&nodeAt(*ptr_branch)->less, visit, context)) return 1;
+  if(visit(ptr_branch, context)) return 1;
+  return walkElement(&nodeAt(*ptr_branch)->greater, visit, context);
+}
+
+/*
+  clearBinaryElement
+  description
+    BINARY_ENGINE clear.
+  params:
+    tree      tree being cleared.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int clearBinaryElement(TREE* tree)
+{
+  deleteNode(nodeAt(tree->root), 1);
+  tree->root = NODE_NONE;
+  return 0;
+}
+
+/*
+  insertBTreeElement
+  description
+    BTREE_ENGINE insert.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertBTreeElement(TREE* tree, NODE* node)
+{
+  setLess(node, NULL);
+  setGreater(node, NULL);
+  return insertBTree(&(tree->bTree), node);
+}
+
+/*
+  removeBTreeElement
+  description
+    BTREE_ENGINE remove.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the slot holding the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeBTreeElement(TREE* tree, int* ptr_branch)
+{
+  removeBTree(&(tree->bTree), nodeAt(*ptr_branch));
+  return 0;
+}
+
+/*
+  findBTreeElement
+  description
+    BTREE_ENGINE find, comparisons other than BY_KEY are
+    carried out by walking the tree.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the slot holding the node, or NULL.
+*/
+int* findBTreeElement(TREE* tree, FIND_BY type, void* value)
+{
+  if(type == BY_KEY) return findBTree(tree->bTree, (NODE*) value);
+  return scanElement(tree, type, value);
+}
+
+/*
+  searchBTreeElement
+  description
+    BTREE_ENGINE search.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    ptr_branch
+              the slot holding a node with the key, or NULL.
+*/
+int* searchBTreeElement(TREE* tree, char* key)
+{
+  return searchBTree(tree->bTree, key);
+}
+
+/*
+  walkBTreeElement
+  description
+    BTREE_ENGINE walk.
+  params:
+    tree      tree being walked.
+    visit     function called with the slot holding each 
+              node, returning nonzero stops the walk.
+    context   passed on to visit.
+  return: 
+    stop      nonzero if the walk was stopped.
+*/
+int walkBTreeElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  return walkBTree(tree->bTree, visit, context);
+}
+
+/*
+  clearBTreeElement
+  description
+    BTREE_ENGINE clear.
+  params:
+    tree      tree being cleared.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int clearBTreeElement(TREE* tree)
+{
+  deleteBTree(tree->bTree, 1);
+  tree->bTree = NULL;
+  return 0;
+}
+
+/*
+  insertArtElement
+  description
+    ART_ENGINE insert.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertArtElement(TREE* tree, NODE* node)
+{
+  return insertArt(&(tree->radixTree), node, 0);
+}
+
+/*
+  removeArtElement
+  description
+    ART_ENGINE remove.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the slot holding the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeArtElement(TREE* tree, int* ptr_branch)
+{
+  removeArt(&(tree->radixTree), nodeAt(*ptr_branch), 0);
+  return 0;
+}
+
+/*
+  findArtElement
+  description
+    ART_ENGINE find, comparisons other than BY_KEY are
+    carried out by walking the tree.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the slot holding the node, or NULL.
+*/
+int* findArtElement(TREE* tree, FIND_BY type, void* value)
+{
+  if(type == BY_KEY) return findArt(tree->radixTree, (NODE*) value);
+  return scanElement(tree, type, value);
+}
+
+/*
+  searchArtElement
+  description
+    ART_ENGINE search.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    ptr_branch
+              the slot holding a node with the key, or NULL.
+*/
+int* searchArtElement(TREE* tree, char* key)
+{
+  return searchArt(tree->radixTree, key);
+}
+
+/*
+  walkArtElement
+  description
+    ART_ENGINE walk.
+  params:
+    tree      tree being walked.
+    visit     function called with the slot holding each 
+              node, returning nonzero stops the walk.
+    context   passed on to visit.
+  return: 
+    stop      nonzero if the walk was stopped.
+*/
+int walkArtElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  return walkArt(tree->radixTree, visit, context);
+}
+
+/*
+  clearArtElement
+  description
+    ART_ENGINE clear.
+  params:
+    tree      tree being cleared.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int clearArtElement(TREE* tree)
+{
+  deleteArt(tree->radixTree, 1);
+  tree->radixTree = NULL;
+  return 0;
+}
+
+/*
+  insertSkipElement
+  description
+    SKIPLIST_ENGINE insert, safe to call from several threads.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertSkipElement(TREE* tree, NODE* node)
+{
+  return insertSkipList(tree->skipList, node);
+}
+
+/*
+  removeSkipElement
+  description
+    SKIPLIST_ENGINE remove, safe to call from several threads.
+    The slot holding a node is also the address of its tower.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the slot holding the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeSkipElement(TREE* tree, int* ptr_branch)
+{
+  removeSkipList(tree->skipList, (SKIP_NODE*) ptr_branch);
+  return 0;
+}
+
+/*
+  findSkipElement
+  description
+    SKIPLIST_ENGINE find, comparisons other than BY_KEY are
+    carried out by walking the list.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the slot holding the node, or NULL.
+*/
+int* findSkipElement(TREE* tree, FIND_BY type, void* value)
+{
+  if(type == BY_KEY) return findSkipList(tree->skipList, (NODE*) value);
+  return scanElement(tree, type, value);
+}
+
+/*
+  searchSkipElement
+  description
+    SKIPLIST_ENGINE search.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    ptr_branch
+              the slot holding a node with the key, or NULL.
+*/
+int* searchSkipElement(TREE* tree, char* key)
+{
+  return searchSkipList(tree->skipList, key);
+}
+
+/*
+  walkSkipElement
+  description
+    SKIPLIST_ENGINE walk.
+  params:
+    tree      tree being walked.
+    visit     function called with the slot holding each 
+              node, returning nonzero stops the walk.
+    context   passed on to visit.
+  return: 
+    stop      nonzero if the walk was stopped.
+*/
+int walkSkipElement(TREE* tree, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  return walkSkipList(tree->skipList, visit, context);
+}
+
+/*
+  clearSkipElement
+  description
+    SKIPLIST_ENGINE clear, no other thread may be using the tree.
+  params:
+    tree      tree being cleared.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int clearSkipElement(TREE* tree)
+{
+  deleteSkipList(tree->skipList, 1);
+  tree->skipList = NULL;
+  return 0;
+}
+
+/*
+  insertAdhocElement
+  description
+    ADHOC_BALANCE insert, links the node in below the last
+    node it passes and rebalances the tree.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertAdhocElement(TREE* tree, NODE* node)
+{
+  *getElement(&(tree->root), BY_KEY, node) = node->handle;
+  balanceTree(tree, &(tree->root));
+  measureElement(tree, nodeAt(tree->root));
+  return 0;
+}
+
+/*
+  removeAdhocElement
+  description
+    ADHOC_BALANCE remove, unlinks a node by putting its
+    greater branch in its place (with its less branch hung
+    below the least node of the greater branch) and 
+    rebalances the tree.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the branch referencing the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeAdhocElement(TREE* tree, int* ptr_branch)
+{
+  NODE* node = nodeAt(*ptr_branch);
+  NODE* temp;
+
+  if(getGreater(node) != NULL)
+  {
+    *ptr_branch = node->greater;
+    temp = getGreater(node);
+    while(getLess(temp) != NULL) temp = getLess(temp);
+    setLess(temp, getLess(node));
+  }
+  else *ptr_branch = node->less;
+
+  setGreater(node, NULL);
+  setLess(node, NULL);
+  measureElement(tree, nodeAt(tree->root));
+  balanceTree(tree, &(tree->root));
+  return 0;
+}
+
+/*
+  findBalancedElement
+  description
+    find of the policies which do not reshape the tree on 
+    lookup.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the branch referencing the node, or NULL.
+*/
+int* findBalancedElement(TREE* tree, FIND_BY type, void* value)
+{
+  return getElement(&(tree->root), type, value);
+}
+
+/*
+  searchBalancedElement
+  description
+    search of the policies which do not reshape the tree on
+    lookup, descends the tree by key.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    ptr_branch
+              the branch referencing a node with the key, 
+              or NULL.
+*/
+int* searchBalancedElement(TREE* tree, char* key)
+{
+  int* ptr_branch = &(tree->root);
+  int compare;
+
+  while(*ptr_branch != NODE_NONE)
+  {
+    compare = strcmp(nodeAt(*ptr_branch)->key, key);
+    if(compare == 0) return ptr_branch;
+    ptr_branch = compare > 0 ? &nodeAt(*ptr_branch)->less : &nodeAt(*ptr_branch)->greater;
+  }
+  return NULL;
+}
+
+/*
+  insertAvlElement
+  description
+    AVL_BALANCE insert.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertAvlElement(TREE* tree, NODE* node)
+{
+  tree->root = getHandle(insertAvl(nodeAt(tree->root), node));
+  return 0;
+}
+
+/*
+  removeAvlElement
+  description
+    AVL_BALANCE remove.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the branch referencing the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeAvlElement(TREE* tree, int* ptr_branch)
+{
+  tree->root = getHandle(removeAvl(nodeAt(tree->root), nodeAt(*ptr_branch)));
+  return 0;
+}
+
+/*
+  insertRedBlackElement
+  description
+    RED_BLACK_BALANCE insert.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertRedBlackElement(TREE* tree, NODE* node)
+{
+  tree->root = getHandle(insertRedBlack(nodeAt(tree->root), node));
+  nodeAt(tree->root)->balance = BLACK_NODE;
+  return 0;
+}
+
+/*
+  removeRedBlackElement
+  description
+    RED_BLACK_BALANCE remove.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the branch referencing the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeRedBlackElement(TREE* tree, int* ptr_branch)
+{
+  if(!isRed(getLess(nodeAt(tree->root))) && !isRed(getGreater(nodeAt(tree->root)))) nodeAt(tree->root)->balance = RED_NODE;
+  tree->root = getHandle(removeRedBlack(nodeAt(tree->root), nodeAt(*ptr_branch)));
+  if(tree->root != NODE_NONE) nodeAt(tree->root)->balance = BLACK_NODE;
+  return 0;
+}
+
+/*
+  insertTreapElement
+  description
+    TREAP_BALANCE insert, the node is given a new priority.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertTreapElement(TREE* tree, NODE* node)
+{
+  node->balance = treapPriority();
+  tree->root = getHandle(insertTreap(nodeAt(tree->root), node));
+  return 0;
+}
+
+/*
+  removeTreapElement
+  description
+    TREAP_BALANCE remove.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the branch referencing the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeTreapElement(TREE* tree, int* ptr_branch)
+{
+  tree->root = getHandle(removeTreap(nodeAt(tree->root), nodeAt(*ptr_branch)));
+  return 0;
+}
+
+/*
+  insertScapegoatElement
+  description
+    SCAPEGOAT_BALANCE insert. The tree has already been counted
+    as holding the new node.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertScapegoatElement(TREE* tree, NODE* node)
+{
+  int unbalanced = 0;
+
+  if(tree->size > tree->maxSize) tree->maxSize = tree->size;
+  tree->root = getHandle(insertScapegoat(nodeAt(tree->root), node, 0, scapegoatLimit(tree->maxSize), &unbalanced));
+  return 0;
+}
+
+/*
+  removeScapegoatElement
+  description
+    SCAPEGOAT_BALANCE remove. Once a third of the most nodes 
+    the tree has held have been removed, the whole tree is 
+    rebuilt. The tree has already been counted as not holding
+    the node.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the branch referencing the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeScapegoatElement(TREE* tree, int* ptr_branch)
+{
+  tree->root = getHandle(removeScapegoat(nodeAt(tree->root), nodeAt(*ptr_branch)));
+  if(3 * tree->size < 2 * tree->maxSize)
+  {
+    tree->root = getHandle(rebuildElement(nodeAt(tree->root)));
+    tree->maxSize = tree->size;
+  }
+  return 0;
+}
+
+/*
+  insertSplayElement
+  description
+    SPLAY_BALANCE insert, the node becomes the root.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertSplayElement(TREE* tree, NODE* node)
+{
+  tree->root = getHandle(insertSplay(nodeAt(tree->root), node));
+  return 0;
+}
+
+/*
+  removeSplayElement
+  description
+    SPLAY_BALANCE remove.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              the branch referencing the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeSplayElement(TREE* tree, int* ptr_branch)
+{
+  tree->root = getHandle(removeSplay(nodeAt(tree->root), nodeAt(*ptr_branch)));
+  return 0;
+}
+
+/*
+  findSplayElement
+  description
+    SPLAY_BALANCE find, the node found becomes the root. Nodes
+    are splayed to by key in a single descent, other types of 
+    comparison search the whole tree first.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the root of the tree, or NULL if no node fits.
+*/
+int* findSplayElement(TREE* tree, FIND_BY type, void* value)
+{
+  int* ptr_branch;
+
+  if(tree->root == NODE_NONE) return NULL;
+  if(type == BY_KEY)
+  {
+    tree->root = getHandle(splayElement(nodeAt(tree->root), &compareSplayNode, value));
+    return compareSplayNode(nodeAt(tree->root), value) == 0 ? &(tree->root) : NULL;
+  }
+  ptr_branch = getElement(&(tree->root), type, value);
+  if(ptr_branch == NULL) return NULL;
+  tree->root = getHandle(splayElement(nodeAt(tree->root), &compareSplayNode, nodeAt(*ptr_branch)));
+  return &(tree->root);
+}
+
+/*
+  searchSplayElement
+  description
+    SPLAY_BALANCE search, the node found (or the last node on
+    the way to it) becomes the root.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    ptr_branch
+              the root of the tree, or NULL if no node has 
+              the key.
+*/
+int* searchSplayElement(TREE* tree, char* key)
+{
+  if(tree->root == NODE_NONE) return NULL;
+  tree->root = getHandle(splayElement(nodeAt(tree->root), &compareSplayKey, key));
+  return strcmp(nodeAt(tree->root)->key, key) == 0 ? &(tree->root) : NULL;
+}
+
+/*
+  insertRelaxedElement
+  description
+    RELAXED_BALANCE insert, the node is linked in and the fix
+    up is left to the maintenance thread. Only if the node is
+    placed twice as deep as the tree is allowed to grow, as the
+    thread has fallen behind, is the tree fixed up at once.
+  params:
+    tree      tree to be added to.
+    node      node to be added.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int insertRelaxedElement(TREE* tree, NODE* node)
+{
+  int depth = 0;
+
+  lockTree(tree);
+  tree->root = getHandle(insertRelaxed(nodeAt(tree->root), node, 1, &depth));
+  tree->relaxed->writes++;
+  tree->relaxed->pending = 1;
+  if(depth > 2 * relaxedLimit(tree->size))
+  {
+    tree->root = getHandle(fixRelaxed(nodeAt(tree->root)));
+    tree->relaxed->pending = 0;
+  }
+  else if(depth > relaxedLimit(tree->size)) tree->relaxed->urgent = 1;
+  unlockTree(tree);
+  return 0;
+}
+
+/*
+  removeRelaxedElement
+  description
+    RELAXED_BALANCE remove, the node is unlinked and the fix up
+    is left to the maintenance thread.
+  params:
+    tree      tree to be removed from.
+    ptr_branch
+              slot holding the node.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int removeRelaxedElement(TREE* tree, int* ptr_branch)
+{
+  lockTree(tree);
+  tree->root = getHandle(removeRelaxed(nodeAt(tree->root), nodeAt(*ptr_branch)));
+  tree->relaxed->writes++;
+  tree->relaxed->pending = 1;
+  unlockTree(tree);
+  return 0;
+}
+
+/*
+  findRelaxedElement
+  description
+    RELAXED_BALANCE find.
+  params:
+    tree      tree being searched.
+    type      the type of comparison to be carried out.
+    value     the value with which nodes are being compared.
+  return: 
+    ptr_branch
+              the node's own slot (see getSlot), or NULL.
+*/
+int* findRelaxedElement(TREE* tree, FIND_BY type, void* value)
+{
+  int* ptr_branch;
+
+  lockTree(tree);
+  ptr_branch = findBalancedElement(tree, type, value);
+  //the slot in the tree may be moved by a fix up once the lock
+  //is given up, the node's own slot is handed out instead
+  if(ptr_branch != NULL) ptr_branch = getSlot(nodeAt(*ptr_branch));
+  unlockTree(tree);
+  return ptr_branch;
+}
+
+/*
+  searchRelaxedElement
+  description
+    RELAXED_BALANCE search.
+  params:
+    tree      tree being searched.
+    key       key being searched for.
+  return: 
+    ptr_branch
+              the own slot (see getSlot) of a node with the
+              key, or NULL.
+*/
+int* searchRelaxedElement(TREE* tree, char* key)
+{
+  int* ptr_branch;
+
+  lockTree(tree);
+  ptr_branch = searchBalancedElement(tree, key);
+  //the slot in the tree may be moved by a fix up once the lock
+  //is given up, the node's own slot is handed out instead
+  if(ptr_branch != NULL) ptr_branch = getSlot(nodeAt(*ptr_branch));
+  unlockTree(tree);
+  return ptr_branch;
+}
+
+/*
+  initRelaxed
+  description
+    creates the maintenance state of a RELAXED_BALANCE tree and
+    starts its maintenance thread.
+  params:
+    tree      tree being maintained.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int initRelaxed(TREE* tree)
+{
+  RELAXED* relaxed = (RELAXED*) malloc(sizeof(RELAXED));
+
+  if(relaxed == NULL)
+  {
+    printf("sufficient memory could not be allocated to create tree");
+    PAUSE
+    exit(0);
+  }
+  initMutex(&relaxed->lock);
+  relaxed->running = 1;
+  relaxed->pending = 0;
+  relaxed->urgent = 0;
+  relaxed->writes = 0;
+  tree->relaxed = relaxed;
+  if(startThread(&relaxed->thread, &maintenanceThread, tree))
+  {
+    printf("maintenance thread could not be started");
+    PAUSE
+    exit(0);
+  }
+  return 0;
+}
+
+/*
+  deleteRelaxed
+  description
+    stops the maintenance thread of a tree, if it has one, and
+    frees its maintenance state.
+  params:
+    tree      tree being maintained.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int deleteRelaxed(TREE* tree)
+{
+  RELAXED* relaxed = tree->relaxed;
+
+  if(relaxed == NULL) return 0;
+  lockMutex(&relaxed->lock);
+  relaxed->running = 0;
+  unlockMutex(&relaxed->lock);
+  joinThread(relaxed->thread);
+
+  deleteMutex(&relaxed->lock);
+  free(relaxed);
+  tree->relaxed = NULL;
+  return 0;
+}
+
+/*
+  maintenanceThread
+  description
+    thread entry point fixing up a RELAXED_BALANCE tree. Every
+    RELAXED_INTERVAL the tree is fixed up if nodes have been 
+    marked and either no writes were made since the last check
+    or the tree has grown past its slack.
+  params:
+    argument  the tree being maintained.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+THREAD_RETURN THREAD_CALL maintenanceThread(void* argument)
+{
+  TREE* tree = (TREE*) argument;
+  RELAXED* relaxed = tree->relaxed;
+  int writes = -1, running = 1;
+
+  while(running)
+  {
+    lockMutex(&relaxed->lock);
+    running = relaxed->running;
+    if(running && relaxed->pending && (relaxed->urgent || relaxed->writes == writes))
+    {
+      tree->root = getHandle(fixRelaxed(nodeAt(tree->root)));
+      relaxed->pending = 0;
+      relaxed->urgent = 0;
+    }
+    writes = relaxed->writes;
+    unlockMutex(&relaxed->lock);
+    if(running) sleepThread(RELAXED_INTERVAL);
+  }
+  return 0;
+}
+
+/*
+  lockTree
+  description
+    takes the lock on the branches of a RELAXED_BALANCE tree, 
+    so that they are not fixed up while in use. Other trees 
+    have no lock. The lock is not recursive, a thread holding 
+    it must not take it again.
+  params:
+    tree      tree being locked.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int lockTree(TREE* tree)
+{
+  if(tree->relaxed != NULL) lockMutex(&tree->relaxed->lock);
+  return 0;
+}
+
+/*
+  unlockTree
+  description
+    gives up the lock taken by lockTree.
+  params:
+    tree      tree being unlocked.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int unlockTree(TREE* tree)
+{
+  if(tree->relaxed != NULL) unlockMutex(&tree->relaxed->lock);
+  return 0;
+}
@@ -0,0 +1,815 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+#include"CommonHeader.h"
+
+//values a container holds as a sorted array, past which it holds
+//a bit for each of its 65536 values (the array would be larger)
+#define BITMAP_ARRAY_LIMIT 4096
+//64 bit words of a container holding a bit for each value
+#define BITMAP_WORDS 1024
+
+typedef struct BITMAP_P BITMAP;
+typedef struct BITMAP_CONTAINER_P BITMAP_CONTAINER;
+typedef struct BITMAP_INDEX_P BITMAP_INDEX;
+
+BITMAP* newBitmap(void);
+int deleteBitmap(BITMAP* bitmap);
+int bitmapAdd(BITMAP* bitmap, unsigned int value);
+int bitmapRemove(BITMAP* bitmap, unsigned int value);
+int bitmapContains(BITMAP* bitmap, unsigned int value);
+int bitmapCount(BITMAP* bitmap);
+int bitmapValues(BITMAP* bitmap, unsigned int* values);
+BITMAP* bitmapAnd(BITMAP* a, BITMAP* b);
+BITMAP* bitmapOr(BITMAP* a, BITMAP* b);
+BITMAP* bitmapAndNot(BITMAP* a, BITMAP* b);
+  BITMAP_CONTAINER* findContainer(BITMAP* bitmap, unsigned short high, int add);
+  int containerContains(BITMAP_CONTAINER* container, unsigned short low);
+  int containerWords(BITMAP_CONTAINER* container, unsigned long long* words);
+  int containerFromWords(BITMAP_CONTAINER* container, unsigned long long* words);
+  int appendContainer(BITMAP* bitmap, BITMAP_CONTAINER* container);
+  int countBits(unsigned long long word);
+
+BITMAP_INDEX* newBitmapIndex(int type);
+int deleteBitmapIndex(BITMAP_INDEX* index);
+BITMAP* indexBitmap(BITMAP_INDEX* index, int key, int add);
+
+/*
+  BITMAP_CONTAINER
+  description
+    the values of a bitmap sharing their high 16 bits. Few
+    values are held as a sorted array of their low bits, many
+    as a bit for each of the 65536 values they could be.
+  data:
+    high        the high 16 bits of the values.
+    count       the number of values.
+    values      the low bits of the values, ascending, when
+                words is NULL.
+    capacity    the number of values there is room for.
+    words       a bit for each value, once there are more than
+                BITMAP_ARRAY_LIMIT values and until they fall
+                to half that, otherwise NULL.
+*/
+struct BITMAP_CONTAINER_P
+{
+  unsigned short high;
+  int count;
+  unsigned short* values;
+  int capacity;
+  unsigned long long* words;
+};
+
+/*
+  BITMAP
+  description
+    a compressed set of 32 bit values (a roaring bitmap), split
+    into containers by their high 16 bits. Sets are intersected,
+    joined and subtracted container by container, and hold
+    their size, so that it is known without counting.
+  data:
+    containers  the containers, ascending by their high bits.
+    containerCount
+                the number of containers.
+    capacity    the number of containers there is room for.
+    count       the number of values in the bitmap.
+*/
+struct BITMAP_P
+{
+  BITMAP_CONTAINER* containers;
+  int containerCount;
+  int capacity;
+  int count;
+};
+
+/*
+  BITMAP_INDEX
+  description
+    a bitmap for each value a field holds, of the handles of
+    the nodes holding it. Suited to fields with few values,
+    whose values are small non negative integers.
+  data:
+    type        the type of search the index answers.
+    bitmaps     the bitmap of each value, NULL where no node
+                has held it.
+    keyCount    the number of values there is room for.
+    next        the next index of the tree.
+*/
+struct BITMAP_INDEX_P
+{
+  int type;
+  BITMAP** bitmaps;
+  int keyCount;
+  BITMAP_INDEX* next;
+};
+
+/*
+  newBitmap
+  description
+    creates an empty bitmap.
+  params:
+    void
+  return:
+    bitmap*   bitmap created.
+*/
+BITMAP* newBitmap(void)
+{
+  BITMAP* bitmap = (BITMAP*) calloc(1, sizeof(BITMAP));
+
+  if(bitmap == NULL)
+  {
+    printf("sufficient memory could not be allocated to create bitmap");
+    PAUSE
+    exit(0);
+  }
+  return bitmap;
+}
+
+/*
+  deleteBitmap
+  description
+    frees a bitmap.
+  params:
+    bitmap    bitmap being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteBitmap(BITMAP* bitmap)
+{
+  int i;
+
+  if(bitmap == NULL) return 0;
+  for(i = 0; i < bitmap->containerCount; i++)
+  {
+    free(bitmap->containers[i].values);
+    free(bitmap->containers[i].words);
+  }
+  free(bitmap->containers);
+  free(bitmap);
+  return 0;
+}
+
+/*
+  bitmapAdd
+  description
+    adds a value to a bitmap.
+  params:
+    bitmap    bitmap being added to.
+    value     the value.
+  return:
+    added     1 if the value was added, 0 if it was held.
+*/
+int bitmapAdd(BITMAP* bitmap, unsigned int value)
+{
+  BITMAP_CONTAINER* container = findContainer(bitmap, (unsigned short) (value >> 16), 1);
+  unsigned short low = (unsigned short) value;
+  unsigned long long* words;
+  int bottom, top, middle;
+
+  if(container->words != NULL)
+  {
+    if(container->words[low >> 6] & (1ULL << (low & 63))) return 0;
+    container->words[low >> 6] |= 1ULL << (low & 63);
+  }
+  else
+  {
+    //the place of the value is found by binary search
+    bottom = 0;
+    top = container->count;
+    while(bottom < top)
+    {
+      middle = (bottom + top) / 2;
+      if(container->values[middle] < low) bottom = middle + 1;
+      else top = middle;
+    }
+    if(bottom < container->count && container->values[bottom] == low) return 0;
+
+    if(container->count == BITMAP_ARRAY_LIMIT)
+    {
+      //a full array becomes a bit for each value
+      words = (unsigned long long*) calloc(BITMAP_WORDS, sizeof(unsigned long long));
+      if(words == NULL)
+      {
+        printf("sufficient memory could not be allocated to grow bitmap");
+        PAUSE
+        exit(0);
+      }
+      containerWords(container, words);
+      words[low >> 6] |= 1ULL << (low & 63);
+      free(container->values);
+      container->values = NULL;
+      container->capacity = 0;
+      container->words = words;
+    }
+    else
+    {
+      if(container->count == container->capacity)
+      {
+        container->capacity = container->capacity ? container->capacity * 2 : 4;
+        container->values = (unsigned short*) realloc(container->values, container->capacity * sizeof(unsigned short));
+        if(container->values == NULL)
+        {
+          printf("sufficient memory could not be allocated to grow bitmap");
+          PAUSE
+          exit(0);
+        }
+      }
+      memmove(container->values + bottom + 1, container->values + bottom, (container->count - bottom) * sizeof(unsigned short));
+      container->values[bottom] = low;
+    }
+  }
+  container->count++;
+  bitmap->count++;
+  return 1;
+}
+
+/*
+  bitmapRemove
+  description
+    removes a value from a bitmap. Containers left empty are
+    removed, and those left small enough become arrays again.
+  params:
+    bitmap    bitmap being removed from.
+    value     the value.
+  return:
+    removed   1 if the value was removed, 0 if it was not held.
+*/
+int bitmapRemove(BITMAP* bitmap, unsigned int value)
+{
+  BITMAP_CONTAINER* container = findContainer(bitmap, (unsigned short) (value >> 16), 0);
+  unsigned short low = (unsigned short) value;
+  int i;
+
+  if(container == NULL || !containerContains(container, low)) return 0;
+  if(container->words != NULL)
+  {
+    container->words[low >> 6] &= ~(1ULL << (low & 63));
+    //a container only becomes an array well below the limit, so
+    //that values added and removed at the limit do not convert
+    //it back and forth
+    if(container->count - 1 <= BITMAP_ARRAY_LIMIT / 2) containerFromWords(container, container->words);
+    else container->count--;
+  }
+  else
+  {
+    for(i = 0; container->values[i] != low; i++);
+    memmove(container->values + i, container->values + i + 1, (container->count - i - 1) * sizeof(unsigned short));
+    container->count--;
+  }
+  bitmap->count--;
+
+  if(container->count == 0)
+  {
+    i = (int) (container - bitmap->containers);
+    free(container->values);
+    free(container->words);
+    memmove(bitmap->containers + i, bitmap->containers + i + 1, (bitmap->containerCount - i - 1) * sizeof(BITMAP_CONTAINER));
+    bitmap->containerCount--;
+  }
+  return 1;
+}
+
+/*
+  bitmapContains
+  description
+    tests whether a bitmap holds a value.
+  params:
+    bitmap    bitmap being tested.
+    value     the value.
+  return:
+    contains  1 if the value is held, otherwise 0.
+*/
+int bitmapContains(BITMAP* bitmap, unsigned int value)
+{
+  BITMAP_CONTAINER* container = findContainer(bitmap, (unsigned short) (value >> 16), 0);
+  return container != NULL && containerContains(container, (unsigned short) value);
+}
+
+/*
+  bitmapCount
+  description
+    returns the number of values a bitmap holds.
+  params:
+    bitmap    bitmap being counted.
+  return:
+    count     the number of values.
+*/
+int bitmapCount(BITMAP* bitmap)
+{
+  return bitmap == NULL ? 0 : bitmap->count;
+}
+
+/*
+  bitmapValues
+  description
+    lists the values of a bitmap.
+  params:
+    bitmap    bitmap being listed.
+    values    filled with the values, ascending. It must have
+              room for bitmapCount values.
+  return:
+    count     the number of values.
+*/
+int bitmapValues(BITMAP* bitmap, unsigned int* values)
+{
+  BITMAP_CONTAINER* container;
+  unsigned long long word;
+  unsigned int high;
+  int count = 0, i, j;
+
+  for(i = 0; i < bitmap->containerCount; i++)
+  {
+    container = &bitmap->containers[i];
+    high = (unsigned int) container->high << 16;
+    if(container->words == NULL)
+    {
+      for(j = 0; j < container->count; j++) values[count++] = high | container->values[j];
+      continue;
+    }
+    for(j = 0; j < BITMAP_WORDS; j++)
+    {
+      //the lowest bit set is taken off until none are left
+      for(word = container->words[j]; word != 0; word &= word - 1)
+      {
+        values[count++] = high | (j << 6) | countBits((word & (0 - word)) - 1);
+      }
+    }
+  }
+  return count;
+}
+
+/*
+  bitmapAnd
+  description
+    finds the values held by both of two bitmaps. Only the
+    containers of high bits held by both are compared, an
+    array by testing each of its values, and two sets of bits
+    a word at a time.
+  params:
+    a         the first bitmap.
+    b         the second bitmap.
+  return:
+    bitmap*   new bitmap of the values held by both.
+*/
+BITMAP* bitmapAnd(BITMAP* a, BITMAP* b)
+{
+  BITMAP* result = newBitmap();
+  BITMAP_CONTAINER container, *left, *right, *swap;
+  unsigned long long words[BITMAP_WORDS];
+  int i = 0, j = 0, k;
+
+  while(i < a->containerCount && j < b->containerCount)
+  {
+    left = &a->containers[i];
+    right = &b->containers[j];
+    if(left->high < right->high) i++;
+    else if(left->high > right->high) j++;
+    else
+    {
+      memset(&container, 0, sizeof(BITMAP_CONTAINER));
+      container.high = left->high;
+      if(left->words != NULL && right->words != NULL)
+      {
+        for(k = 0; k < BITMAP_WORDS; k++) words[k] = left->words[k] & right->words[k];
+        containerFromWords(&container, words);
+      }
+      else
+      {
+        //the smaller array is tested against the other container
+        if(left->words != NULL || (right->words == NULL && right->count < left->count))
+        {
+          swap = left;
+          left = right;
+          right = swap;
+        }
+        container.values = (unsigned short*) malloc((left->count + 1) * sizeof(unsigned short));
+        if(container.values == NULL)
+        {
+          printf("sufficient memory could not be allocated to intersect bitmaps");
+          PAUSE
+          exit(0);
+        }
+        container.capacity = left->count + 1;
+        for(k = 0; k < left->count; k++)
+        {
+          if(containerContains(right, left->values[k])) container.values[container.count++] = left->values[k];
+        }
+      }
+      appendContainer(result, &container);
+      i++;
+      j++;
+    }
+  }
+  return result;
+}
+
+/*
+  bitmapOr
+  description
+    finds the values held by either of two bitmaps.
+  params:
+    a         the first bitmap.
+    b         the second bitmap.
+  return:
+    bitmap*   new bitmap of the values held by either.
+*/
+BITMAP* bitmapOr(BITMAP* a, BITMAP* b)
+{
+  BITMAP* result = newBitmap();
+  BITMAP_CONTAINER container, *only;
+  unsigned long long words[BITMAP_WORDS], other[BITMAP_WORDS];
+  int i = 0, j = 0, k;
+
+  while(i < a->containerCount || j < b->containerCount)
+  {
+    memset(&container, 0, sizeof(BITMAP_CONTAINER));
+    only = NULL;
+    if(j == b->containerCount || (i < a->containerCount && a->containers[i].high < b->containers[j].high))
+    {
+      only = &a->containers[i++];
+    }
+    else if(i == a->containerCount || b->containers[j].high < a->containers[i].high)
+    {
+      only = &b->containers[j++];
+    }
+
+    if(only != NULL)
+    {
+      //a container held by one bitmap is copied
+      container.high = only->high;
+      containerWords(only, words);
+    }
+    else
+    {
+      container.high = a->containers[i].high;
+      containerWords(&a->containers[i++], words);
+      containerWords(&b->containers[j++], other);
+      for(k = 0; k < BITMAP_WORDS; k++) words[k] |= other[k];
+    }
+    containerFromWords(&container, words);
+    appendContainer(result, &container);
+  }
+  return result;
+}
+
+/*
+  bitmapAndNot
+  description
+    finds the values held by one bitmap and not another. The
+    values a set does not hold are those held by a bitmap of
+    every value less those it holds.
+  params:
+    a         the bitmap whose values are kept.
+    b         the bitmap whose values are taken away.
+  return:
+    bitmap*   new bitmap of the values of a not held by b.
+*/
+BITMAP* bitmapAndNot(BITMAP* a, BITMAP* b)
+{
+  BITMAP* result = newBitmap();
+  BITMAP_CONTAINER container, *left, *right;
+  unsigned long long words[BITMAP_WORDS];
+  int i, j = 0, k;
+
+  for(i = 0; i < a->containerCount; i++)
+  {
+    left = &a->containers[i];
+    while(j < b->containerCount && b->containers[j].high < left->high) j++;
+    right = j < b->containerCount && b->containers[j].high == left->high ? &b->containers[j] : NULL;
+
+    memset(&container, 0, sizeof(BITMAP_CONTAINER));
+    container.high = left->high;
+    if(left->words == NULL)
+    {
+      container.values = (unsigned short*) malloc((left->count + 1) * sizeof(unsigned short));
+      if(container.values == NULL)
+      {
+        printf("sufficient memory could not be allocated to subtract bitmaps");
+        PAUSE
+        exit(0);
+      }
+      container.capacity = left->count + 1;
+      for(k = 0; k < left->count; k++)
+      {
+        if(right == NULL || !containerContains(right, left->values[k])) container.values[container.count++] = left->values[k];
+      }
+    }
+    else
+    {
+      memcpy(words, left->words, sizeof(words));
+      if(right != NULL && right->words != NULL)
+      {
+        for(k = 0; k < BITMAP_WORDS; k++) words[k] &= ~right->words[k];
+      }
+      else if(right != NULL)
+      {
+        for(k = 0; k < right->count; k++) words[right->values[k] >> 6] &= ~(1ULL << (right->values[k] & 63));
+      }
+      containerFromWords(&container, words);
+    }
+    appendContainer(result, &container);
+  }
+  return result;
+}
+
+/*
+  findContainer
+  description
+    finds the container of a bitmap holding values with some
+    high bits, by binary search.
+  params:
+    bitmap    bitmap being searched.
+    high      the high 16 bits of the values.
+    add       1 if an empty container should be added when
+              there is none.
+  return:
+    container the container, or NULL if there is none and
+              none was added.
+*/
+BITMAP_CONTAINER* findContainer(BITMAP* bitmap, unsigned short high, int add)
+{
+  int low = 0, top = bitmap->containerCount, middle;
+
+  while(low < top)
+  {
+    middle = (low + top) / 2;
+    if(bitmap->containers[middle].high < high) low = middle + 1;
+    else top = middle;
+  }
+  if(low < bitmap->containerCount && bitmap->containers[low].high == high) return &bitmap->containers[low];
+  if(!add) return NULL;
+
+  if(bitmap->containerCount == bitmap->capacity)
+  {
+    bitmap->capacity = bitmap->capacity ? bitmap->capacity * 2 : 4;
+    bitmap->containers = (BITMAP_CONTAINER*) realloc(bitmap->containers, bitmap->capacity * sizeof(BITMAP_CONTAINER));
+    if(bitmap->containers == NULL)
+    {
+      printf("sufficient memory could not be allocated to grow bitmap");
+      PAUSE
+      exit(0);
+    }
+  }
+  memmove(bitmap->containers + low + 1, bitmap->containers + low, (bitmap->containerCount - low) * sizeof(BITMAP_CONTAINER));
+  memset(&bitmap->containers[low], 0, sizeof(BITMAP_CONTAINER));
+  bitmap->containers[low].high = high;
+  bitmap->containerCount++;
+  return &bitmap->containers[low];
+}
+
+/*
+  containerContains
+  description
+    tests whether a container holds a value.
+  params:
+    container the container.
+    low       the low 16 bits of the value.
+  return:
+    contains  1 if the value is held, otherwise 0.
+*/
+int containerContains(BITMAP_CONTAINER* container, unsigned short low)
+{
+  int bottom = 0, top = container->count - 1, middle;
+
+  if(container->words != NULL) return (int) ((container->words[low >> 6] >> (low & 63)) & 1);
+  while(bottom <= top)
+  {
+    middle = (bottom + top) / 2;
+    if(container->values[middle] < low) bottom = middle + 1;
+    else if(container->values[middle] > low) top = middle - 1;
+    else return 1;
+  }
+  return 0;
+}
+
+/*
+  containerWords
+  description
+    writes the values of a container as a bit for each value.
+  params:
+    container the container.
+    words     filled with BITMAP_WORDS words of bits.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int containerWords(BITMAP_CONTAINER* container, unsigned long long* words)
+{
+  int i;
+
+  if(container->words != NULL)
+  {
+    if(words != container->words) memcpy(words, container->words, BITMAP_WORDS * sizeof(unsigned long long));
+    return 0;
+  }
+  memset(words, 0, BITMAP_WORDS * sizeof(unsigned long long));
+  for(i = 0; i < container->count; i++) words[container->values[i] >> 6] |= 1ULL << (container->values[i] & 63);
+  return 0;
+}
+
+/*
+  containerFromWords
+  description
+    sets the values of a container from a bit for each value,
+    holding them as an array if there are few enough.
+  params:
+    container the container, whose high bits are set. Its
+              values are replaced.
+    words     BITMAP_WORDS words of bits, which may be the
+              container's own.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int containerFromWords(BITMAP_CONTAINER* container, unsigned long long* words)
+{
+  unsigned short* values = NULL;
+  unsigned long long* copy = NULL;
+  unsigned long long word;
+  int count = 0, i;
+
+  for(i = 0; i < BITMAP_WORDS; i++) count += countBits(words[i]);
+  if(count > BITMAP_ARRAY_LIMIT)
+  {
+    if(words != container->words)
+    {
+      copy = (unsigned long long*) malloc(BITMAP_WORDS * sizeof(unsigned long long));
+      if(copy == NULL)
+      {
+        printf("sufficient memory could not be allocated to build bitmap");
+        PAUSE
+        exit(0);
+      }
+      memcpy(copy, words, BITMAP_WORDS * sizeof(unsigned long long));
+      free(container->words);
+      container->words = copy;
+    }
+    free(container->values);
+    container->values = NULL;
+    container->capacity = 0;
+    container->count = count;
+    return 0;
+  }
+
+  values = (unsigned short*) malloc((count + 1) * sizeof(unsigned short));
+  if(values == NULL)
+  {
+    printf("sufficient memory could not be allocated to build bitmap");
+    PAUSE
+    exit(0);
+  }
+  count = 0;
+  for(i = 0; i < BITMAP_WORDS; i++)
+  {
+    for(word = words[i]; word != 0; word &= word - 1)
+    {
+      values[count++] = (unsigned short) ((i << 6) | countBits((word & (0 - word)) - 1));
+    }
+  }
+  free(container->values);
+  free(container->words);
+  container->words = NULL;
+  container->values = values;
+  container->capacity = count + 1;
+  container->count = count;
+  return 0;
+}
+
+/*
+  appendContainer
+  description
+    places a container after the last of a bitmap, or frees it
+    if it is empty.
+  params:
+    bitmap    bitmap being built, in ascending order of high
+              bits.
+    container the container, which the bitmap takes.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int appendContainer(BITMAP* bitmap, BITMAP_CONTAINER* container)
+{
+  if(container->count == 0)
+  {
+    free(container->values);
+    free(container->words);
+    return 0;
+  }
+  if(bitmap->containerCount == bitmap->capacity)
+  {
+    bitmap->capacity = bitmap->capacity ? bitmap->capacity * 2 : 4;
+    bitmap->containers = (BITMAP_CONTAINER*) realloc(bitmap->containers, bitmap->capacity * sizeof(BITMAP_CONTAINER));
+    if(bitmap->containers == NULL)
+    {
+      printf("sufficient memory could not be allocated to build bitmap");
+      PAUSE
+      exit(0);
+    }
+  }
+  bitmap->containers[bitmap->containerCount++] = *container;
+  bitmap->count += container->count;
+  return 0;
+}
+
+/*
+  countBits
+  description
+    counts the bits set in a word, with the processor's own
+    instruction where the compiler offers it.
+  params:
+    word      the word.
+  return:
+    count     the number of bits set.
+*/
+int countBits(unsigned long long word)
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll(word);
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/*
+  newBitmapIndex
+  description
+    creates an empty bitmap index.
+  params:
+    type      the type of search the index answers.
+  return:
+    index*    index created.
+*/
+BITMAP_INDEX* newBitmapIndex(int type)
+{
+  BITMAP_INDEX* index = (BITMAP_INDEX*) calloc(1, sizeof(BITMAP_INDEX));
+
+  if(index == NULL)
+  {
+    printf("sufficient memory could not be allocated to create bitmap index");
+    PAUSE
+    exit(0);
+  }
+  index->type = type;
+  return index;
+}
+
+/*
+  deleteBitmapIndex
+  description
+    frees a bitmap index and the indexes after it.
+  params:
+    index     the first index being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteBitmapIndex(BITMAP_INDEX* index)
+{
+  BITMAP_INDEX* next;
+  int i;
+
+  while(index != NULL)
+  {
+    next = index->next;
+    for(i = 0; i < index->keyCount; i++) deleteBitmap(index->bitmaps[i]);
+    free(index->bitmaps);
+    free(index);
+    index = next;
+  }
+  return 0;
+}
+
+/*
+  indexBitmap
+  description
+    finds the bitmap of a value of an index's field.
+  params:
+    index     the index.
+    key       the value, which must not be negative.
+    add       1 if an empty bitmap should be added when there
+              is none.
+  return:
+    bitmap*   the bitmap, or NULL if there is none and none
+              was added.
+*/
+BITMAP* indexBitmap(BITMAP_INDEX* index, int key, int add)
+{
+  int keyCount = index->keyCount;
+
+  if(key >= keyCount)
+  {
+    if(!add) return NULL;
+    while(keyCount <= key) keyCount = keyCount ? keyCount * 2 : 1024;
+    index->bitmaps = (BITMAP**) realloc(index->bitmaps, keyCount * sizeof(BITMAP*));
+    if(index->bitmaps == NULL)
+    {
+      printf("sufficient memory could not be allocated to grow bitmap index");
+      PAUSE
+      exit(0);
+    }
+    memset(index->bitmaps + index->keyCount, 0, (keyCount - index->keyCount) * sizeof(BITMAP*));
+    index->keyCount = keyCount;
+  }
+  if(index->bitmaps[key] == NULL && add) index->bitmaps[key] = newBitmap();
+  return index->bitmaps[key];
+}
+
+#endif
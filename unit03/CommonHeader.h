@@ -1,7 +1,15 @@
+//nanosleep (see sleepThread) is left out of the headers by the
+//strict c standards unless POSIX is asked for, before anything
+//is included
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 199309L
+#endif
 //so that visual studios will stop telling me that 
 //there is something wrong with string functions 
 
 #define BUFFER 300
+//size of the key each node holds for its value
+#define KEY_SIZE 100
 //standard windows specific system commands
 #ifdef _WIN32
   #define PAUSE system("pause");
@@ -16,6 +24,15 @@
 			          FLUSH
   #define CLEAR system("clear");
 #endif
+//hint that the memory at an address will soon be read
+#if defined(__GNUC__)
+  #define PREFETCH(address) __builtin_prefetch((const void*) (address))
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  #include<xmmintrin.h>
+  #define PREFETCH(address) _mm_prefetch((const char*) (address), _MM_HINT_T0)
+#else
+  #define PREFETCH(address)
+#endif
 #include<stdlib.h>
 #include<stdio.h>
 #include<string.h>
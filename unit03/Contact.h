@@ -1,9 +1,34 @@
-
+#ifndef CONTACT_H
+#define CONTACT_H
 #include"CommonHeader.h"
-//size of first and last names as they will be stored
+#include"StringKernels.h"
+#include"NameTable.h"
+#include"TrigramIndex.h"
+#include"Renderer.h"
+#include"RowCache.h"
+//characters of a name held in a contact record, longer names
+//continue after the record (see saveContact)
 #define NAME_SIZE 20
+//longest name a contact holds, so that a contact's full string 
+//fits in a BUFFER. longer names are cut short with a '+' marker
+#define NAME_LIMIT 128
+//characters of each name which order contacts by their keys
+#define KEY_NAME_SIZE 40
+//marks a name in a contact record as continuing after the record
+#define NAME_CONTINUED 1
+//a phone number is packed as area * PHONE_AREA_SCALE + prefix 
+//* PHONE_PREFIX_SCALE + line, so that it orders like its digits
+#define PHONE_AREA_SCALE ((long long) 10000000)
+#define PHONE_PREFIX_SCALE ((long long) 10000)
+//"(xxx) xxx-xxxx" and its terminator
+#define PHONE_STRING_SIZE 15
+//area codes are below this, so that contacts are counted in this
+//many groups by area code
+#define AREA_CODE_LIMIT 1000
 
 typedef struct CONTACT_P CONTACT;
+typedef struct CONTACT_RECORD_P CONTACT_RECORD;
+typedef struct NAME_PATTERN_P NAME_PATTERN;
 
 typedef enum CONTACT_FIELD_P CONTACT_FIELD;
 typedef enum PRINT_TYPE_P PRINT_TYPE;
@@ -14,26 +39,42 @@ CONTACT* newContact(char* key);
 
 int deleteContact(CONTACT* contact);
   int saveContact(FILE* file, CONTACT* contact);
+  int loadName(FILE* file, char* field, char* name);
+  int saveNameRest(FILE* file, char* name);
+  CONTACT* moveContact(CONTACT* contact, char* key);
+  long long contactSortKey(CONTACT* contact, CONTACT_FIELD type);
+  long long contactLookupKey(CONTACT* contact);
+  long long contactLookupTarget(CONTACT_FIELD type, void* target);
+  int contactBitmapKey(CONTACT* contact, CONTACT_FIELD type);
+  int contactBitmapTarget(CONTACT_FIELD type, void* target);
+  int contactKeyPrefix(CONTACT_FIELD type, void* target, char* prefix);
+  int contactTargetToString(CONTACT_FIELD type, void* target, char* string);
+  int contactGroupToString(CONTACT_FIELD type, int group, char* string);
 
 int prompt(CONTACT_FIELD type, void* input);
   int promptFirstName(char* firstName);
   int promptLastName(char* lastName);
   int promptPhoneNumber(short* phoneNumber);
   int promptAreaCode(short* areaCode);
+  int promptPattern(NAME_PATTERN* pattern, int similar);
 
 int setFirstNameP(CONTACT* contact);
   int setFirstName(CONTACT* contact, char* firstName);
+  NAME_ID contactNameId(char* name, int add);
 char* getFirstName(CONTACT* contact);
+NAME_ID getFirstNameId(CONTACT* contact);
 
 
 int setLastNameP(CONTACT* contact);
   int setLastName(CONTACT* contact, char* lastName);
 char* getLastName(CONTACT* contact);
+NAME_ID getLastNameId(CONTACT* contact);
 
 
 int setPhoneNumberP(CONTACT* contact);
   int setPhoneNumber(CONTACT* contact, short* phoneNumber);
-short* getPhoneNumberNum(CONTACT* contact);
+  long long packPhoneNumber(short* phoneNumber);
+long long getPhoneNumberNum(CONTACT* contact);
 
 int getPhoneNumberString(CONTACT* contact, char* number);
 
@@ -43,15 +84,26 @@ int editContact(CONTACT* contact);
 int contactCompareFind(CONTACT* contact, CONTACT_FIELD type, void* target);
   CONTACT_FIELD printByMenu(void);
   CONTACT_FIELD findMenu(void);
-  int compareFirstName(CONTACT* contact, char* name);
-  int compareLastName(CONTACT* contact, char* name);
-  int compareNumber(CONTACT* contact, short* number);
+  CONTACT_FIELD completeMenu(void);
+  CONTACT_FIELD groupMenu(void);
+  int promptPrefix(char* prefix);
+  int compareFirstName(CONTACT* contact, NAME_ID name);
+  int compareLastName(CONTACT* contact, NAME_ID name);
+  int compareNumber(CONTACT* contact, long long number);
+  int compareAreaCode(CONTACT* contact, short areaCode);
+  int compareNamePattern(CONTACT* contact, CONTACT_FIELD type, NAME_PATTERN* pattern);
+  int compareNamePrefix(CONTACT* contact, CONTACT_FIELD type, char* prefix);
+  int comparePhoneRange(CONTACT* contact, long long* range);
 
 int contactCompareSort(CONTACT* contact, CONTACT* input);
   int genKey(CONTACT* contact);
+  int updateKey(CONTACT* contact);
+  int getKeyStale(CONTACT* contact);
   char* getKey(CONTACT* contact);
 
 int contactToString(CONTACT* contact, char* string, PRINT_TYPE type);
+int contactRender(CONTACT* contact, RENDERER* renderer);
+int contactRenderRow(CONTACT* contact, RENDERER* renderer);
 int contactTableHeader(char* string);
 
 /*
@@ -72,6 +124,21 @@ int contactTableHeader(char* string);
                 take actions on the phone number field.
     AREA_CODE   input indicating that contacts are to be printed
                 by area code.
+    NAME_CONTAINS
+                input indicating that contacts are to be found by
+                part of either name.
+    NAME_SIMILAR
+                input indicating that contacts are to be found by
+                a name spelt within a few characters of either.
+    LAST_NAME_PREFIX
+                input indicating that contacts are to be found by
+                the beginning of their last name (queries only).
+    FIRST_NAME_PREFIX
+                input indicating that contacts are to be found by
+                the beginning of their first name (queries only).
+    PHONE_RANGE input indicating that contacts are to be found by
+                a range of phone numbers, the lowest and highest
+                packed numbers (queries only).
 
 */
 enum CONTACT_FIELD_P 
@@ -80,7 +147,12 @@ enum CONTACT_FIELD_P
   LAST_NAME    = 2,
   FIRST_NAME   = 3, 
   PHONE_NUMBER = 4,
-  AREA_CODE    = 5
+  AREA_CODE    = 5,
+  NAME_CONTAINS = 6,
+  NAME_SIMILAR = 7,
+  LAST_NAME_PREFIX = 8,
+  FIRST_NAME_PREFIX = 9,
+  PHONE_RANGE  = 10
 };
 
 /*
@@ -107,22 +179,80 @@ enum PRINT_TYPE_P
     Designed to interact with the structure 
     defined in the LinkedList header file.
   data:
-    firstName   contact first name.
-    lastName    contact last name.
-    phoneNumber an array of 3 shorts containing 
-                area code, prefix, and line
-                number respectively
+    firstName   id of the contact's first name in
+                the name table.
+    lastName    id of the contact's last name in
+                the name table.
+    phoneNumber the area code, prefix, and line 
+                number packed into a single value
+                (see packPhoneNumber).
+    phoneString the phone number formatted for 
+                printing.
+    rowStale    whether the fields have changed
+                since the row was formatted (see 
+                contactRenderRow).
     key         string containing the contacts
                 'hash' value. It is used for
                 sorting a list of contacts.
+    keyStale    whether the fields have changed
+                since the key was generated, in
+                which case it is generated again
+                when next needed (see updateKey).
+    row         handle of the contact's shortened
+                string in the row cache, ROW_NONE
+                until it is first rendered.
 */
 struct CONTACT_P{
+  NAME_ID firstName;
+  NAME_ID lastName;
+  long long phoneNumber;
+  char phoneString[PHONE_STRING_SIZE];
+  char rowStale;
+  char* key;
+  int keyStale;
+  int row;
+};
+
+/*
+  CONTACT_RECORD
+  description
+    a contact as it is written to file, which keeps 
+    the layout contacts have always been saved in.
+  data:
+    firstName   contact first name, of which NAME_SIZE
+                characters are held. If the name is 
+                longer, the character after them is
+                NAME_CONTINUED and the rest of the name
+                follows the record.
+    lastName    contact last name, held as the first
+                name is.
+    phoneNumber an array of 3 shorts containing 
+                area code, prefix, and line
+                number respectively
+    key         unused, kept for the layout.
+*/
+struct CONTACT_RECORD_P{
   char firstName[NAME_SIZE+1];
   char lastName[NAME_SIZE+1];
   short phoneNumber[3];
   char* key;
 };
 
+/*
+  NAME_PATTERN
+  description
+    text searched for in contacts' names, ignoring case.
+  data:
+    distance    the most characters a similar name may differ
+                by, at most TRIGRAM_DISTANCE_LIMIT.
+    text        the text searched for.
+*/
+struct NAME_PATTERN_P
+{
+  int distance;
+  char text[NAME_LIMIT + 1];
+};
+
 /*
 
   newContact
@@ -152,6 +282,11 @@ CONTACT* newContact(char* key)
   }
   contact->key = key;
   contact->key[0] = '\0';
+  contact->keyStale = 1;
+  contact->firstName = NAME_EMPTY;
+  contact->lastName = NAME_EMPTY;
+  contact->phoneString[0] = '\0';
+  contact->row = ROW_NONE;
   setPhoneNumber(contact, phoneNumber);
   setFirstName(contact, emptyName);
   setLastName(contact, emptyName);
@@ -190,14 +325,23 @@ int initContact(CONTACT* contact)
 CONTACT* loadContact(FILE* file, char* key)
 {
   CONTACT* contact = (CONTACT*) malloc(sizeof(CONTACT));
-	fread(contact, sizeof(CONTACT), 1, file);
-  contact->key = key;
-  genKey(contact);
+  CONTACT_RECORD record;
+  char name[NAME_LIMIT + 1];
+	fread(&record, sizeof(CONTACT_RECORD), 1, file);
   if(feof(file))
   {
     free(contact);
-    contact = NULL;
+    return NULL;
   }
+  memset(contact, 0, sizeof(CONTACT));
+  //the rest of each name follows the record, first name first
+  loadName(file, record.firstName, name);
+  contact->firstName = contactNameId(name, 1);
+  loadName(file, record.lastName, name);
+  contact->lastName = contactNameId(name, 1);
+  contact->key = key;
+  contact->keyStale = 1;
+  setPhoneNumber(contact, record.phoneNumber);
   return contact;
 }
 
@@ -212,10 +356,218 @@ CONTACT* loadContact(FILE* file, char* key)
 */
 int deleteContact(CONTACT* contact)
 {
+  freeRow(contact->row);
   free(contact);
   return 0;
 }
 
+/*
+  moveContact
+  description
+    copies a contact to freshly allocated memory, so that the
+    contacts of nodes moved one after another are allocated 
+    one after another, and frees the original.
+  params:
+    contact*  pointer to the contact being moved.
+    key       key of the contact's node in its new location.
+  return: 
+    contact*  pointer to the moved contact.
+*/
+CONTACT* moveContact(CONTACT* contact, char* key)
+{
+  CONTACT* moved = (CONTACT*) malloc(sizeof(CONTACT));
+
+  if(moved == NULL)
+  {
+    printf("sufficient memory could not be allocated to move contact");
+    PAUSE
+    exit(0);
+  }
+  *moved = *contact;
+  moved->key = key;
+  free(contact);
+  return moved;
+}
+
+/*
+  contactSortKey
+  description
+    returns the position of a contact in the order contacts
+    found by phone number or area code are printed, that of 
+    their phone numbers.
+  params:
+    contact*  pointer to the contact being ordered.
+    type      the type of search which found the contact.
+  return: 
+    key       the contact's packed phone number, or -1 if 
+              contacts found by the search are printed in
+              the order of their keys.
+*/
+long long contactSortKey(CONTACT* contact, CONTACT_FIELD type)
+{
+  if(type == PHONE_NUMBER || type == AREA_CODE) return contact->phoneNumber;
+  return -1;
+}
+
+/*
+  contactLookupKey
+  description
+    the key a contact is looked up by, so that a contact is
+    found by its phone number without searching the tree.
+  params:
+    contact   the contact being keyed.
+  return: 
+    key       the packed phone number (see packPhoneNumber).
+*/
+long long contactLookupKey(CONTACT* contact)
+{
+  return contact->phoneNumber;
+}
+
+/*
+  contactLookupTarget
+  description
+    the key a search for contacts looks up.
+  params:
+    type      the field being searched.
+    target    the value being searched for, as returned by 
+              prompt.
+  return: 
+    key       the packed phone number searched for, or -1 if
+              the field is not looked up.
+*/
+long long contactLookupTarget(CONTACT_FIELD type, void* target)
+{
+  return type == PHONE_NUMBER ? *((long long*) target) : -1;
+}
+
+/*
+  contactBitmapKey
+  description
+    the key a contact is held under in the bitmap index of a
+    field, so that the contacts of an area code are known 
+    without searching the tree.
+  params:
+    contact   the contact being keyed.
+    type      the field indexed.
+  return: 
+    key       the contact's area code, or -1 if the field has
+              no index.
+*/
+int contactBitmapKey(CONTACT* contact, CONTACT_FIELD type)
+{
+  return type == AREA_CODE ? (int) (contact->phoneNumber / PHONE_AREA_SCALE) : -1;
+}
+
+/*
+  contactBitmapTarget
+  description
+    the key a search for contacts finds in a bitmap index.
+  params:
+    type      the field being searched.
+    target    the value being searched for, as returned by 
+              prompt.
+  return: 
+    key       the area code searched for, or -1 if the field
+              has no index.
+*/
+int contactBitmapTarget(CONTACT_FIELD type, void* target)
+{
+  return type == AREA_CODE ? *((short*) target) : -1;
+}
+
+/*
+  contactKeyPrefix
+  description
+    the beginning of the keys of the contacts a search is for.
+    Keys begin with the last name, so contacts found by their 
+    last name, or its beginning, lie in one range of keys.
+  params:
+    type      the field being searched.
+    target    the value being searched for.
+    prefix    filled with the beginning of the keys, at most
+              KEY_NAME_SIZE characters.
+  return: 
+    found     1 if the keys share a prefix, otherwise 0.
+*/
+int contactKeyPrefix(CONTACT_FIELD type, void* target, char* prefix)
+{
+  switch(type)
+  {
+    case        LAST_NAME: sprintf(prefix, "%.*s", KEY_NAME_SIZE, nameText(*((NAME_ID*) target)));
+                           return 1;
+    case LAST_NAME_PREFIX: sprintf(prefix, "%.*s", KEY_NAME_SIZE, (char*) target);
+                           return 1;
+    default:               return 0;
+  }
+}
+
+/*
+  contactTargetToString
+  description
+    describes a search for contacts, as printed in query plans.
+  params:
+    type      the field being searched.
+    target    the value being searched for.
+    string    filled with the description.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int contactTargetToString(CONTACT_FIELD type, void* target, char* string)
+{
+  long long* range = (long long*) target;
+
+  switch(type)
+  {
+    case         LAST_NAME: sprintf(string, "last name is %s", nameText(*((NAME_ID*) target)));
+                            break;
+    case        FIRST_NAME: sprintf(string, "first name is %s", nameText(*((NAME_ID*) target)));
+                            break;
+    case      PHONE_NUMBER: sprintf(string, "phone number is (%03d) %03d-%04d", 
+                              (int) (range[0] / PHONE_AREA_SCALE), (int) (range[0] / PHONE_PREFIX_SCALE % 1000), 
+                              (int) (range[0] % PHONE_PREFIX_SCALE));
+                            break;
+    case         AREA_CODE: sprintf(string, "area code is %d", *((short*) target));
+                            break;
+    case     NAME_CONTAINS: sprintf(string, "a name contains %s", ((NAME_PATTERN*) target)->text);
+                            break;
+    case      NAME_SIMILAR: sprintf(string, "a name is within %d of %s", ((NAME_PATTERN*) target)->distance, 
+                              ((NAME_PATTERN*) target)->text);
+                            break;
+    case  LAST_NAME_PREFIX: sprintf(string, "last name begins %.*s", NAME_LIMIT, (char*) target);
+                            break;
+    case FIRST_NAME_PREFIX: sprintf(string, "first name begins %.*s", NAME_LIMIT, (char*) target);
+                            break;
+    case       PHONE_RANGE: sprintf(string, "phone number from (%03d) %03d-%04d to (%03d) %03d-%04d", 
+                              (int) (range[0] / PHONE_AREA_SCALE), (int) (range[0] / PHONE_PREFIX_SCALE % 1000), 
+                              (int) (range[0] % PHONE_PREFIX_SCALE), (int) (range[1] / PHONE_AREA_SCALE), 
+                              (int) (range[1] / PHONE_PREFIX_SCALE % 1000), (int) (range[1] % PHONE_PREFIX_SCALE));
+                            break;
+    default:                sprintf(string, "field %d", type);
+  }
+  return 0;
+}
+
+/*
+  contactGroupToString
+  description
+    describes the value shared by a group of contacts, as 
+    counted by groupContactColumns.
+  params:
+    type      the field the contacts are grouped by.
+    group     the group, the id of a name or an area code.
+    string    filled with the value.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int contactGroupToString(CONTACT_FIELD type, int group, char* string)
+{
+  if(type == AREA_CODE) sprintf(string, "%03d", group);
+  else if(type == LAST_NAME || type == FIRST_NAME) sprintf(string, "%.*s", NAME_LIMIT, nameText((NAME_ID) group));
+  else sprintf(string, "%d", group);
+  return 0;
+}
+
 /*
   saveContact
   description
@@ -228,12 +580,77 @@ int deleteContact(CONTACT* contact)
 */
 int saveContact(FILE* file, CONTACT* contact)
 {
-	
-  fwrite(contact, sizeof(CONTACT), 1, file);
+  CONTACT_RECORD record;
+
+  memset(&record, 0, sizeof(CONTACT_RECORD));
+  strncpy(record.firstName, getFirstName(contact), NAME_SIZE);
+  strncpy(record.lastName, getLastName(contact), NAME_SIZE);
+  if(strlen(getFirstName(contact)) > NAME_SIZE) record.firstName[NAME_SIZE] = NAME_CONTINUED;
+  if(strlen(getLastName(contact)) > NAME_SIZE) record.lastName[NAME_SIZE] = NAME_CONTINUED;
+  record.phoneNumber[0] = (short) (contact->phoneNumber / PHONE_AREA_SCALE);
+  record.phoneNumber[1] = (short) (contact->phoneNumber / PHONE_PREFIX_SCALE % 1000);
+  record.phoneNumber[2] = (short) (contact->phoneNumber % PHONE_PREFIX_SCALE);
+  fwrite(&record, sizeof(CONTACT_RECORD), 1, file);
+  saveNameRest(file, getFirstName(contact));
+  saveNameRest(file, getLastName(contact));
   
   return 0;
 }
 
+/*
+  loadName
+  description
+    reads a name held in a contact record, along with the 
+    rest of the name if it continues after the record.
+  params:
+    file*     pointer to the file being loaded, at the rest
+              of the name if there is one.
+    field     the name as it is held in the record.
+    name      string of at least NAME_LIMIT + 1 characters 
+              which will hold the name.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int loadName(FILE* file, char* field, char* name)
+{
+  short length = 0;
+
+  memcpy(name, field, NAME_SIZE);
+  name[NAME_SIZE] = '\0';
+  if(field[NAME_SIZE] == NAME_CONTINUED)
+  {
+    fread(&length, sizeof(short), 1, file);
+    if(length < 0 || length > NAME_LIMIT - NAME_SIZE) length = 0;
+    fread(name + NAME_SIZE, 1, length, file);
+    name[NAME_SIZE + length] = '\0';
+  }
+  return 0;
+}
+
+/*
+  saveNameRest
+  description
+    writes the characters of a name which do not fit in a 
+    contact record, preceded by their number, after the 
+    record.
+  params:
+    file*     pointer to the file being saved to.
+    name      the name being saved.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int saveNameRest(FILE* file, char* name)
+{
+  short length = (short) strlen(name) - NAME_SIZE;
+
+  if(length > 0)
+  {
+    fwrite(&length, sizeof(short), 1, file);
+    fwrite(name + NAME_SIZE, 1, length, file);
+  }
+  return 0;
+}
+
 
 /*
   prompt
@@ -245,20 +662,34 @@ int saveContact(FILE* file, CONTACT* contact)
               prompted for.
     input*    a void pointer to a BUFFER byte char array
               allowing different datatypes to be 
-              returned.
+              returned. A phone number is returned 
+              packed (see packPhoneNumber), and a name
+              as its NAME_ID (NAME_NONE if no contact
+              has held it).
   return: 
     NULL      0 value indicating successful exicution.
 */
 int prompt(CONTACT_FIELD type, void* input)
 {
+  short phoneNumber[3];
 
   switch(type)
   {
     case           -1:   return NULL;
-    case    LAST_NAME:   return promptLastName((char*) input);
-    case   FIRST_NAME:   return promptFirstName((char*) input);
-    case PHONE_NUMBER:   return promptPhoneNumber((short*) input);
+    //names are searched for by their ids
+    case    LAST_NAME:   promptLastName((char*) input);
+                         *((NAME_ID*) input) = contactNameId((char*) input, 0);
+                         return 0;
+    case   FIRST_NAME:   promptFirstName((char*) input);
+                         *((NAME_ID*) input) = contactNameId((char*) input, 0);
+                         return 0;
+    //phone numbers are searched for in their packed form
+    case PHONE_NUMBER:   promptPhoneNumber(phoneNumber);
+                         *((long long*) input) = packPhoneNumber(phoneNumber);
+                         return 0;
     case    AREA_CODE:   return promptAreaCode((short*) input);
+    case NAME_CONTAINS:  return promptPattern((NAME_PATTERN*) input, 0);
+    case NAME_SIMILAR:   return promptPattern((NAME_PATTERN*) input, 1);
     default: 
             printf("invalid input");
             PAUSE
@@ -279,7 +710,7 @@ int prompt(CONTACT_FIELD type, void* input)
 */
 int promptFirstName(char* firstName)
 {
-  printf("please enter (in %d charicters or less) the contact's first name.", NAME_SIZE);
+  printf("please enter (in %d charicters or less) the contact's first name.", NAME_LIMIT);
   FLUSH
   scanf("%s", firstName);
 
@@ -300,7 +731,7 @@ int promptFirstName(char* firstName)
 */
 int promptLastName(char* lastName)
 {
-  printf("please enter (in %d charicters or less) the contact's last name.", NAME_SIZE);
+  printf("please enter (in %d charicters or less) the contact's last name.", NAME_LIMIT);
   FLUSH
   scanf("%s", lastName);
   FLUSH
@@ -367,6 +798,43 @@ int promptAreaCode(short* areaCode)
   return 0;
 }
 
+/*
+  promptPattern
+  description
+    prompts the user for and collects text to search names
+    for.
+  params:
+    pattern   the pattern which will hold the input.
+    similar   1 if names spelt similarly are being searched
+              for, when the number of characters they may
+              differ by is also collected, otherwise 0.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int promptPattern(NAME_PATTERN* pattern, int similar)
+{
+  char text[BUFFER];
+
+  printf("please enter (in %d charicters or less) %s.", NAME_LIMIT,
+    similar ? "the name as it might be spelt" : "part of the name");
+  FLUSH
+  scanf("%s", text);
+  FLUSH
+  strncpy(pattern->text, text, NAME_LIMIT);
+  pattern->text[NAME_LIMIT] = '\0';
+  pattern->distance = 0;
+  while(similar)
+  {
+    printf("please enter how many charicters (0 to %d) it may differ by.", TRIGRAM_DISTANCE_LIMIT);
+    FLUSH
+    scanf("%d", &pattern->distance);
+    FLUSH
+    if(pattern->distance >= 0 && pattern->distance <= TRIGRAM_DISTANCE_LIMIT) break;
+    printf("invalid number of charicters");
+  }
+  return 0;
+}
+
 /*
   setFirstNameP
   description
@@ -403,16 +871,44 @@ int setFirstNameP(CONTACT* contact)
 */
 int setFirstName(CONTACT* contact, char* firstName)
 {
-  strncpy(getFirstName(contact), firstName, NAME_SIZE);
-  if(strlen(firstName)>NAME_SIZE)
+  NAME_ID id = contactNameId(firstName, 1);
+
+  if(id != contact->firstName)
   {
-    getFirstName(contact)[NAME_SIZE] = '\0';
-    getFirstName(contact)[NAME_SIZE-1] = '+';
+    contact->firstName = id;
+    contact->keyStale = 1;
+    contact->rowStale = 1;
   }
-  genKey(contact);
   return 0;
 }
 
+/*
+  contactNameId
+  description
+    returns the id of a name as a contact holds it, cut 
+    short with a '+' marker if it is longer than NAME_LIMIT.
+  params:
+    name      the name whose id is required.
+    add       1 if the name should be interned when it is
+              not yet held, 0 if it should not.
+  return: 
+    id        the name's id, or NAME_NONE if it is not held
+              and was not added.
+*/
+NAME_ID contactNameId(char* name, int add)
+{
+  char limited[NAME_LIMIT + 1];
+
+  if(strlen(name) > NAME_LIMIT)
+  {
+    strncpy(limited, name, NAME_LIMIT);
+    limited[NAME_LIMIT] = '\0';
+    limited[NAME_LIMIT-1] = '+';
+    name = limited;
+  }
+  return add ? internName(name) : findName(name);
+}
+
 /*
   getFirstName
   description
@@ -424,6 +920,21 @@ int setFirstName(CONTACT* contact, char* firstName)
     firstName pointer to the contacts first name.
 */
 char* getFirstName(CONTACT* contact)
+{
+  return nameText(contact->firstName);
+}
+
+/*
+  getFirstNameId
+  description
+    returns the id of contacts first name.
+  params:
+    contact*  the contact who's first name is being
+              retrieved.    
+  return: 
+    id        the id of the contacts first name.
+*/
+NAME_ID getFirstNameId(CONTACT* contact)
 {
   return contact->firstName;
 }
@@ -465,14 +976,14 @@ int setLastNameP(CONTACT* contact)
 */
 int setLastName(CONTACT* contact, char* lastName)
 {
-  strncpy(getLastName(contact), lastName, NAME_SIZE);
-  if(strlen(lastName)>NAME_SIZE)
+  NAME_ID id = contactNameId(lastName, 1);
+
+  if(id != contact->lastName)
   {
-    getLastName(contact)[NAME_SIZE] = '\0';
-    getLastName(contact)[NAME_SIZE-1] = '+';
+    contact->lastName = id;
+    contact->keyStale = 1;
+    contact->rowStale = 1;
   }
-
-  genKey(contact);
   return 0;
 }
 
@@ -487,6 +998,21 @@ int setLastName(CONTACT* contact, char* lastName)
     firstName pointer to the contacts first name.
 */
 char* getLastName(CONTACT* contact)
+{
+  return nameText(contact->lastName);
+}
+
+/*
+  getLastNameId
+  description
+    returns the id of contacts last name.
+  params:
+    contact*  the contact who's last name is being
+              retrieved.    
+  return: 
+    id        the id of the contacts last name.
+*/
+NAME_ID getLastNameId(CONTACT* contact)
 {
   return contact->lastName;
 }
@@ -525,26 +1051,58 @@ int setPhoneNumberP(CONTACT* contact)
 */
 int setPhoneNumber(CONTACT* contact, short* phoneNumber)
 {
-  contact->phoneNumber[0] = phoneNumber[0];
-  contact->phoneNumber[1] = phoneNumber[1];
-  contact->phoneNumber[2] = phoneNumber[2];
-
-  genKey(contact);
+  short parts[3];
+  long long number;
+
+  //parts too long for their places, as read from a damaged or 
+  //foreign file, are cut to them so that they cannot overrun the
+  //formatted string
+  parts[0] = (short) ((unsigned short) phoneNumber[0] % 1000);
+  parts[1] = (short) ((unsigned short) phoneNumber[1] % 1000);
+  parts[2] = (short) ((unsigned short) phoneNumber[2] % 10000);
+  phoneNumber = parts;
+  number = packPhoneNumber(phoneNumber);
+
+  //a number which has already been formatted is left alone
+  if(number == contact->phoneNumber && contact->phoneString[0] != '\0') return 0;
+  contact->phoneNumber = number;
+  //formatted once here rather than each time it is printed
+  sprintf(contact->phoneString, "(%.3hu) %.3hu-%.4hu", phoneNumber[0], phoneNumber[1], phoneNumber[2]);
+
+  contact->keyStale = 1;
+  contact->rowStale = 1;
   return 0;
 }
 
+/*
+  packPhoneNumber
+  description
+    packs the parts of a phone number into a single value,
+    which compares as a whole number would.
+  params:
+    phoneNumber
+              short int array with 3 elements holding the 
+              area code, prefix and line number respectively. 
+  return: 
+    number    the packed phone number.
+*/
+long long packPhoneNumber(short* phoneNumber)
+{
+  return phoneNumber[0] * PHONE_AREA_SCALE + phoneNumber[1] * PHONE_PREFIX_SCALE + phoneNumber[2];
+}
+
 /*
   getPhoneNumberNum
   description
-    returns a pointer to contacts phone number.
+    returns contacts phone number.
   params:
     contact*  the contact who's phone number is being
               retrieved.    
   return: 
     phoneNumber
-              pointer to the contacts phone number field.
+              the contacts packed phone number.
 */
-short* getPhoneNumberNum(CONTACT* contact)
+long long getPhoneNumberNum(CONTACT* contact)
 {
   return contact->phoneNumber;
 }
@@ -564,9 +1122,7 @@ short* getPhoneNumberNum(CONTACT* contact)
 */
 int getPhoneNumberString(CONTACT* contact, char* number)
 {
-  short* phoneNumber = getPhoneNumberNum(contact);
-
-  sprintf(number, "(%.3hu) %.3hu-%.4hu", contact->phoneNumber[0], contact->phoneNumber[1], contact->phoneNumber[2]);
+  strcpy(number, contact->phoneString);
   return 0;
 }
 
@@ -599,6 +1155,8 @@ int editContact(CONTACT* contact)
                          break;
       case PHONE_NUMBER: setPhoneNumberP(&tempContact);
                          break;
+      //the menu offers no other field to edit
+      default:           break;
     }
 
     choice = editContactMenu(*((CONTACT*) contact), tempContact);
@@ -622,7 +1180,7 @@ int editContact(CONTACT* contact)
 CONTACT_FIELD editContactMenu(CONTACT contact, CONTACT tempContact)
 {
   CONTACT_FIELD choice;
-  char string_contact[NAME_SIZE*2 + 25], string_temp[NAME_SIZE*2 + 25];
+  char string_contact[NAME_LIMIT*2 + 25], string_temp[NAME_LIMIT*2 + 25];
   contactToString(&contact, string_contact, PRINT_LONG);
   contactToString(&tempContact, string_temp, PRINT_LONG);
   CLEAR
@@ -681,10 +1239,15 @@ int contactCompareFind(CONTACT* contact, CONTACT_FIELD type, void* target)
   {
     //should never execute
 
-    case    LAST_NAME: return compareLastName(contact, (char*) target);
-    case   FIRST_NAME: return compareFirstName(contact, (char*) target);
-    case PHONE_NUMBER: return compareNumber(contact, (short*) target);
-		case    AREA_CODE: return compareNumber(contact, (short*) target) <= 1;
+    case    LAST_NAME: return compareLastName(contact, *((NAME_ID*) target));
+    case   FIRST_NAME: return compareFirstName(contact, *((NAME_ID*) target));
+    case PHONE_NUMBER: return compareNumber(contact, *((long long*) target));
+		case    AREA_CODE: return compareAreaCode(contact, *((short*) target));
+    case NAME_CONTAINS:
+    case NAME_SIMILAR: return compareNamePattern(contact, type, (NAME_PATTERN*) target);
+    case LAST_NAME_PREFIX:
+    case FIRST_NAME_PREFIX: return compareNamePrefix(contact, type, (char*) target);
+    case  PHONE_RANGE: return comparePhoneRange(contact, (long long*) target);
 
     //exit
     case 0: return 0;
@@ -716,9 +1279,11 @@ CONTACT_FIELD findMenu(void)
   printf("3. Locate contact by first name.\n");
   printf("4. Locate contact by phone number.\n");
   printf("5. Locate contact by area code.\n");
+  printf("6. Locate contact by part of a name.\n");
+  printf("7. Locate contact by a misspelt name.\n");
   printf("0. Exit (to Menu).\n");
   scanf("%d", &choice);
-  while(choice > 5 || choice < 0)
+  while(choice > 7 || choice < 0)
   {
     CLEAR
     printf("   input '%d' invalid; input must be among those listed.\n", choice);
@@ -727,6 +1292,8 @@ CONTACT_FIELD findMenu(void)
     printf("3. Locate contact by first name.\n");
     printf("4. Locate contact by phone number.\n");
     printf("5. Locate contact by area code.\n");
+    printf("6. Locate contact by part of a name.\n");
+    printf("7. Locate contact by a misspelt name.\n");
     printf("0. Exit (to Menu).\n");
     FLUSH
     scanf("%d", &choice);
@@ -753,9 +1320,11 @@ CONTACT_FIELD printByMenu(void)
   printf("3. Locate contacts by first name.\n");
   printf("4. Locate contacts by phone number.\n");
   printf("5. Locate contact by area code.\n");
+  printf("6. Locate contact by part of a name.\n");
+  printf("7. Locate contact by a misspelt name.\n");
   printf("0. Exit (to Menu).\n");
   scanf("%d", &choice);
-  while(choice > 5 || choice < 0)
+  while(choice > 7 || choice < 0)
   {
     CLEAR
     printf("   input '%d' invalid; input must be among those listed.\n", choice);
@@ -764,6 +1333,8 @@ CONTACT_FIELD printByMenu(void)
     printf("3. Locate contacts by first name.\n");
     printf("4. Locate contacts by phone number.\n");
     printf("5. Locate contact by area code.\n");
+    printf("6. Locate contact by part of a name.\n");
+    printf("7. Locate contact by a misspelt name.\n");
     printf("0. Exit (to Menu).\n");
     FLUSH
     scanf("%d", &choice);
@@ -776,22 +1347,105 @@ CONTACT_FIELD printByMenu(void)
 
 }
 
+/*
+  completeMenu
+  description
+    determine which name the user wishes to complete.
+  params:
+    void
+  return: 
+    choice    the users menu selection
+*/
+CONTACT_FIELD completeMenu(void)
+{
+  //read as an int, the type scanf fills, and only then
+  //converted to the field chosen
+  int choice;
+  printf("2. Complete a last name.\n");
+  printf("3. Complete a first name.\n");
+  printf("0. Exit (to Menu).\n");
+  scanf("%d", &choice);
+  while(choice != LAST_NAME && choice != FIRST_NAME && choice != 0)
+  {
+    CLEAR
+    printf("   input '%d' invalid; input must be among those listed.\n", choice);
+    printf("2. Complete a last name.\n");
+    printf("3. Complete a first name.\n");
+    printf("0. Exit (to Menu).\n");
+    FLUSH
+    scanf("%d", &choice);
+    FLUSH
+  }
+  return (CONTACT_FIELD) choice;
+
+}
+
+/*
+  groupMenu
+  description
+    determine which field the user wishes to count contacts by.
+  params:
+    void
+  return: 
+    choice    the users menu selection
+*/
+CONTACT_FIELD groupMenu(void)
+{
+  int choice;
+  printf("2. Count contacts by last name.\n");
+  printf("3. Count contacts by first name.\n");
+  printf("5. Count contacts by area code.\n");
+  printf("0. Exit (to Menu).\n");
+  scanf("%d", &choice);
+  while(choice != LAST_NAME && choice != FIRST_NAME && choice != AREA_CODE && choice != 0)
+  {
+    CLEAR
+    printf("   input '%d' invalid; input must be among those listed.\n", choice);
+    printf("2. Count contacts by last name.\n");
+    printf("3. Count contacts by first name.\n");
+    printf("5. Count contacts by area code.\n");
+    printf("0. Exit (to Menu).\n");
+    FLUSH
+    scanf("%d", &choice);
+    FLUSH
+  }
+  return (CONTACT_FIELD) choice;
+
+}
+
+/*
+  promptPrefix
+  description
+    prompts the user for the beginning of a name.
+  params:
+    prefix    string pointer which will hold the prefix.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int promptPrefix(char* prefix)
+{
+  printf("please enter the beginning of the name.");
+  FLUSH
+  scanf("%s", prefix);
+  FLUSH
+  return 0;
+}
+
 /*
   compareLastName
   description
     compare equality based on last name.
   params:
     contact   the contact to which a comparison is being made.
-    name      the name being compared against.
+    name      the id of the name being compared against.
   return: 
     comparison
-              the product of the comparison function.
+              0 if the contact has the name, otherwise 1.
 */
-int compareLastName(CONTACT* contact, char* name)
+int compareLastName(CONTACT* contact, NAME_ID name)
 {
-  int compare = strcmp( contact->lastName, (char*) name);
-
-  return compare;
+  //equal names share an id, so no text is compared
+  return contact->lastName != name;
 }
 
 /*
@@ -800,15 +1454,14 @@ int compareLastName(CONTACT* contact, char* name)
     compare equality based on first name.
   params:
     contact   the contact to which a comparison is being made.
-    name      the name being compared against.
+    name      the id of the name being compared against.
   return: 
     comparison
-              the product of the comparison function.
+              0 if the contact has the name, otherwise 1.
 */
-int compareFirstName(CONTACT* contact, char* name)
+int compareFirstName(CONTACT* contact, NAME_ID name)
 {
-  int compare = strcmp(contact->firstName, (char*) name);
-  return compare;
+  return contact->firstName != name;
 }
 
 /*
@@ -817,8 +1470,7 @@ int compareFirstName(CONTACT* contact, char* name)
     compare equality based on phone number or area code.
   params:
     contact   the contact to which a comparison is being made.
-    number    the phone number or area code being compared.
-              against.
+    number    the packed phone number being compared against.
   return: 
     comparison
               the first element in which the contact and input 
@@ -828,24 +1480,104 @@ int compareFirstName(CONTACT* contact, char* name)
                 3) difference only exist between line numbers.
                 0) they are identical.
 */
-int compareNumber(CONTACT* contact, short*  number)
+int compareNumber(CONTACT* contact, long long number)
 {
-  if(contact->phoneNumber[0] != number[0])
+  //the parts are only told apart when the numbers differ
+  if(contact->phoneNumber == number)
+  {
+    return 0;
+  }
+  else if(contact->phoneNumber / PHONE_AREA_SCALE != number / PHONE_AREA_SCALE)
   {
     return 1;
   }
-  else if(contact->phoneNumber[1] != number[1])
+  else if(contact->phoneNumber / PHONE_PREFIX_SCALE != number / PHONE_PREFIX_SCALE)
   {
     return 2;
   }
-  else if(contact->phoneNumber[2] != number[2])
+  else
   {
     return 3;
   }
-  else
+}
+
+/*
+  compareAreaCode
+  description
+    compare equality based on area code.
+  params:
+    contact   the contact to which a comparison is being made.
+    areaCode  the area code being compared against.
+  return: 
+    comparison
+              0 if the contact has the area code, otherwise 1.
+*/
+int compareAreaCode(CONTACT* contact, short areaCode)
+{
+  //numbers with the area code lie in a single range, which is 
+  //tested with one unsigned comparison
+  return (unsigned long long) (contact->phoneNumber - areaCode * PHONE_AREA_SCALE) >= (unsigned long long) PHONE_AREA_SCALE;
+}
+
+/*
+  compareNamePattern
+  description
+    compare a contact's names against a pattern, ignoring 
+    case. The contact matches if either name does.
+  params:
+    contact   the contact to which a comparison is being made.
+    type      NAME_CONTAINS if a name must hold the pattern,
+              NAME_SIMILAR if it must be spelt within the
+              pattern's distance of it.
+    pattern   the pattern being compared against.
+  return: 
+    comparison
+              0 if either name matches, otherwise 1.
+*/
+int compareNamePattern(CONTACT* contact, CONTACT_FIELD type, NAME_PATTERN* pattern)
+{
+  if(type == NAME_CONTAINS)
   {
-    return 0;
+    return !containsFolded(getLastName(contact), pattern->text)
+        && !containsFolded(getFirstName(contact), pattern->text);
   }
+  return editDistance(getLastName(contact), pattern->text, pattern->distance) > pattern->distance
+      && editDistance(getFirstName(contact), pattern->text, pattern->distance) > pattern->distance;
+}
+
+/*
+  compareNamePrefix
+  description
+    compare whether a name of a contact begins with a prefix.
+  params:
+    contact   the contact to which a comparison is being made.
+    type      LAST_NAME_PREFIX or FIRST_NAME_PREFIX.
+    prefix    the beginning being compared against.
+  return:
+    comparison
+              0 if the name begins with the prefix, otherwise 1.
+*/
+int compareNamePrefix(CONTACT* contact, CONTACT_FIELD type, char* prefix)
+{
+  char* name = type == LAST_NAME_PREFIX ? getLastName(contact) : getFirstName(contact);
+  return strncmp(name, prefix, strlen(prefix)) != 0;
+}
+
+/*
+  comparePhoneRange
+  description
+    compare whether the phone number of a contact lies in a 
+    range.
+  params:
+    contact   the contact to which a comparison is being made.
+    range     the lowest and highest packed numbers.
+  return:
+    comparison
+              0 if the number lies in the range, otherwise 1.
+*/
+int comparePhoneRange(CONTACT* contact, long long* range)
+{
+  return contact->phoneNumber < range[0] || contact->phoneNumber > range[1];
 }
 
 /*
@@ -863,7 +1595,8 @@ int contactCompareSort(CONTACT* contact, CONTACT* input)
 {
   char* contactKey = contact->key;
   char* inputKey = input->key;
-  int comp = strcmp(contactKey, inputKey);
+  //keys are held by nodes, in KEY_SIZE byte buffers
+  int comp = getStringKernels()->compareString(contactKey, inputKey, KEY_SIZE);
   return comp;
 }
 
@@ -881,15 +1614,58 @@ int genKey(CONTACT* contact)
   //key reset
 
   contact->key[0] = '\0';
-  //phone number area code followed by last name
-  sprintf(contact->key, "%s%s%d%d%d", contact->lastName, contact->firstName, contact->phoneNumber[0], contact->phoneNumber[1], contact->phoneNumber[2]);
+  //last name, first name and phone number, names are cut short
+  //so that the key fits in KEY_SIZE
+  sprintf(contact->key, "%.*s%.*s%d%d%d", KEY_NAME_SIZE, getLastName(contact), KEY_NAME_SIZE, getFirstName(contact), 
+    (int) (contact->phoneNumber / PHONE_AREA_SCALE), 
+    (int) (contact->phoneNumber / PHONE_PREFIX_SCALE % 1000), 
+    (int) (contact->phoneNumber % PHONE_PREFIX_SCALE));
   return 0;
 }
 
+/*
+  updateKey
+  description
+    generates contact hash key again if the fields it is 
+    generated from have changed since it last was. Setters 
+    only mark the key as stale, so that a contact whose 
+    fields are set one after another has its key generated
+    once, when it is placed in a tree.
+  params:
+    contact   contact who's key is being brought up to date.
+  return: 
+    updated   1 if the key was generated, 0 if it was up to
+              date.
+*/
+int updateKey(CONTACT* contact)
+{
+  if(!contact->keyStale) return 0;
+  genKey(contact);
+  contact->keyStale = 0;
+  return 1;
+}
+
+/*
+  getKeyStale
+  description
+    returns whether the contacts fields have changed since 
+    its key was generated.
+  params:
+    contact   contact who's key is being checked.
+  return: 
+    stale     1 if the key is stale, otherwise 0.
+*/
+int getKeyStale(CONTACT* contact)
+{
+  return contact->keyStale;
+}
+
 /*
   getKey
   description
-    returns hash key.
+    returns hash key, as it was last generated. A contact 
+    in a tree keeps the key it was placed by until it is 
+    placed again, even while it is being edited.
   params:
     contact   contact who's key is required.
   return: 
@@ -938,7 +1714,7 @@ int contactToString(CONTACT* contact, char* string, PRINT_TYPE type)
   //print table with untruncated data
 	else if(type == PRINT_LONG)
 	{
-    char name[NAME_SIZE*2 + 10];
+    char name[NAME_LIMIT*2 + 10];
 	  char number[25];
 
 	  getPhoneNumberString(contact, number);
@@ -949,6 +1725,62 @@ int contactToString(CONTACT* contact, char* string, PRINT_TYPE type)
   return 0;
 }
 
+/*
+  contactRender
+  description
+    adds the shortened string of a contact (see contactToString)
+    to the output of a renderer, without formatting it through
+    sprintf.
+  params:
+    contact   the contact being rendered.
+    renderer  renderer the contact is added to.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int contactRender(CONTACT* contact, RENDERER* renderer)
+{
+  renderField(renderer, getLastName(contact), 10, '+');
+  renderSpaces(renderer, 5);
+  renderField(renderer, getFirstName(contact), 10, '+');
+  renderSpaces(renderer, 5);
+  renderText(renderer, contact->phoneString);
+  return 0;
+}
+
+/*
+  contactRenderRow
+  description
+    adds the shortened string of a contact to the output of a
+    renderer as contactRender does, but copies it from the row
+    cache. The string is formatted into the cache the first
+    time, and again after a setter has changed the contact, so
+    that a contact printed over and over is formatted once.
+    Only the shortened string is cached, it is the one tables
+    are rendered with. The long string of a single contact is
+    formatted by contactToString each time, it runs to the
+    length of both names and would not fit a ROW_SIZE slot.
+  params:
+    contact   the contact being rendered.
+    renderer  renderer the contact is added to.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int contactRenderRow(CONTACT* contact, RENDERER* renderer)
+{
+  if(contact->row == ROW_NONE)
+  {
+    contact->row = newRow();
+    contact->rowStale = 1;
+  }
+  if(contact->rowStale)
+  {
+    contactToString(contact, rowText(contact->row), PRINT_SHORT);
+    contact->rowStale = 0;
+  }
+  renderText(renderer, rowText(contact->row));
+  return 0;
+}
+
 /*
   contactTableHeader
   description
@@ -963,4 +1795,6 @@ int contactTableHeader(char* string)
   sprintf(string, "%10.10s     %10.10s     %s", "Last Name", "First Name", "Phone Number");
 
   return 0;
-}
\ No newline at end of file
+}
+
+#endif
@@ -0,0 +1,663 @@
+#ifndef CONTACT_COLUMNS_H
+#define CONTACT_COLUMNS_H
+#include"CommonHeader.h"
+#include"Contact.h"
+#include"NameTrie.h"
+#include"TrigramIndex.h"
+#include"StringKernels.h"
+
+typedef struct CONTACT_COLUMNS_P CONTACT_COLUMNS;
+typedef struct NAME_COLUMN_INDEX_P NAME_COLUMN_INDEX;
+
+CONTACT_COLUMNS* newContactColumns(CONTACT** contacts, int* handles, int count);
+int deleteContactColumns(CONTACT_COLUMNS* columns);
+int scanContactColumns(CONTACT_COLUMNS* columns, CONTACT_FIELD type, void* target, int* handles);
+int completeContactColumns(CONTACT_COLUMNS* columns, CONTACT_FIELD type, char* prefix, int k, char** names, int* counts);
+int groupContactColumns(CONTACT_COLUMNS* columns, CONTACT_FIELD type, int first, int last, int* counts);
+  NAME_TRIE* newNameColumnTrie(CONTACT_COLUMNS* columns, NAME_ID* names);
+NAME_COLUMN_INDEX* newNameColumnIndex(CONTACT_COLUMNS* columns, NAME_ID* names);
+int deleteNameColumnIndex(NAME_COLUMN_INDEX* index);
+
+int scanNameColumn(CONTACT_COLUMNS* columns, NAME_ID* names, NAME_ID name, int* handles);
+int scanNumberColumn(CONTACT_COLUMNS* columns, long long number, int* handles);
+int scanAreaColumn(CONTACT_COLUMNS* columns, short areaCode, int* handles);
+int scanPhoneRange(CONTACT_COLUMNS* columns, long long* range, int* handles);
+int scanNamePrefix(CONTACT_COLUMNS* columns, NAME_ID* names, char* prefix, int* handles);
+int scanNamePattern(CONTACT_COLUMNS* columns, CONTACT_FIELD type, NAME_PATTERN* pattern, int* handles);
+  int gatherNameRows(CONTACT_COLUMNS* columns, NAME_COLUMN_INDEX** index, NAME_ID* names,
+                     CONTACT_FIELD type, NAME_PATTERN* pattern, int* rows);
+  int compareRows(const void* a, const void* b);
+
+/*
+  CONTACT_COLUMNS
+  description
+    a copy of the fields of many contacts, held field by field
+    rather than contact by contact, so that a search through
+    one field reads only that field from contiguous memory and
+    can compare many contacts at once.
+  data:
+    lastNames   ids of last names.
+    firstNames  ids of first names.
+    phoneNumbers
+                packed phone numbers (see packPhoneNumber).
+    areaCodes   area codes, split out of the phone numbers.
+    handles     the handle of each contact's node.
+    count       the number of contacts.
+    lastNameTrie
+                trie of the last names, built the first time
+                a last name is completed.
+    firstNameTrie
+                trie of the first names, built the first time
+                a first name is completed.
+    lastNameIndex
+                index of the last names, built the first time
+                last names are searched by a pattern.
+    firstNameIndex
+                index of the first names, built the first time
+                first names are searched by a pattern.
+*/
+struct CONTACT_COLUMNS_P
+{
+  NAME_ID* lastNames;
+  NAME_ID* firstNames;
+  long long* phoneNumbers;
+  short* areaCodes;
+  int* handles;
+  int count;
+  NAME_TRIE* lastNameTrie;
+  NAME_TRIE* firstNameTrie;
+  NAME_COLUMN_INDEX* lastNameIndex;
+  NAME_COLUMN_INDEX* firstNameIndex;
+};
+
+/*
+  NAME_COLUMN_INDEX
+  description
+    the trigrams of the names in a name column, and the rows
+    holding each name, so that the rows matching a pattern
+    are found from the names matching it without scanning
+    the column.
+  data:
+    grams       trigram index of the names held by any row.
+    starts      where the rows holding each name begin in
+                rows, indexed by id, with one more entry
+                marking where the last end.
+    rows        the rows holding each name, ascending within
+                each name.
+*/
+struct NAME_COLUMN_INDEX_P
+{
+  TRIGRAM_INDEX* grams;
+  int* starts;
+  int* rows;
+};
+
+/*
+  newContactColumns
+  description
+    copies the fields of contacts into columns.
+  params:
+    contacts  the contacts being copied, in the order their
+              handles should be returned by searches.
+    handles   the handle of each contact's node.
+    count     the number of contacts.
+  return:
+    columns*  columns created.
+*/
+CONTACT_COLUMNS* newContactColumns(CONTACT** contacts, int* handles, int count)
+{
+  CONTACT_COLUMNS* columns = (CONTACT_COLUMNS*) calloc(1, sizeof(CONTACT_COLUMNS));
+  int i;
+
+  if(columns != NULL)
+  {
+    //at least one row is allocated, so that no allocation is empty
+    columns->lastNames = (NAME_ID*) malloc((count + 1) * sizeof(NAME_ID));
+    columns->firstNames = (NAME_ID*) malloc((count + 1) * sizeof(NAME_ID));
+    columns->phoneNumbers = (long long*) malloc((count + 1) * sizeof(long long));
+    columns->areaCodes = (short*) malloc((count + 1) * sizeof(short));
+    columns->handles = (int*) malloc((count + 1) * sizeof(int));
+  }
+  if(columns == NULL || columns->lastNames == NULL || columns->firstNames == NULL
+    || columns->phoneNumbers == NULL || columns->areaCodes == NULL || columns->handles == NULL)
+  {
+    printf("sufficient memory could not be allocated to create contact columns");
+    PAUSE
+    exit(0);
+  }
+
+  for(i = 0; i < count; i++)
+  {
+    columns->lastNames[i] = getLastNameId(contacts[i]);
+    columns->firstNames[i] = getFirstNameId(contacts[i]);
+    columns->phoneNumbers[i] = getPhoneNumberNum(contacts[i]);
+    columns->areaCodes[i] = (short) (getPhoneNumberNum(contacts[i]) / PHONE_AREA_SCALE);
+    columns->handles[i] = handles[i];
+  }
+  columns->count = count;
+  return columns;
+}
+
+/*
+  deleteContactColumns
+  description
+    frees columns.
+  params:
+    columns   columns being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteContactColumns(CONTACT_COLUMNS* columns)
+{
+  if(columns == NULL) return 0;
+  free(columns->lastNames);
+  free(columns->firstNames);
+  free(columns->phoneNumbers);
+  free(columns->areaCodes);
+  free(columns->handles);
+  deleteNameTrie(columns->lastNameTrie);
+  deleteNameTrie(columns->firstNameTrie);
+  deleteNameColumnIndex(columns->lastNameIndex);
+  deleteNameColumnIndex(columns->firstNameIndex);
+  free(columns);
+  return 0;
+}
+
+/*
+  scanContactColumns
+  description
+    finds every contact which contactCompareFind would find
+    equal to the target.
+  params:
+    columns   columns being searched.
+    type      the field being searched.
+    target    the value being searched for, as returned by
+              prompt.
+    handles   filled with the handles of the contacts found,
+              in the order the contacts were copied. It must
+              have room for one more handle than there are 
+              contacts.
+  return:
+    count     the number of contacts found, or -1 if the field
+              cannot be searched through columns.
+*/
+int scanContactColumns(CONTACT_COLUMNS* columns, CONTACT_FIELD type, void* target, int* handles)
+{
+  switch(type)
+  {
+    case    LAST_NAME: return scanNameColumn(columns, columns->lastNames, *((NAME_ID*) target), handles);
+    case   FIRST_NAME: return scanNameColumn(columns, columns->firstNames, *((NAME_ID*) target), handles);
+    case PHONE_NUMBER: return scanNumberColumn(columns, *((long long*) target), handles);
+    case    AREA_CODE: return scanAreaColumn(columns, *((short*) target), handles);
+    case NAME_CONTAINS:
+    case NAME_SIMILAR: return scanNamePattern(columns, type, (NAME_PATTERN*) target, handles);
+    case  PHONE_RANGE: return scanPhoneRange(columns, (long long*) target, handles);
+    case LAST_NAME_PREFIX: 
+                       return scanNamePrefix(columns, columns->lastNames, (char*) target, handles);
+    case FIRST_NAME_PREFIX: 
+                       return scanNamePrefix(columns, columns->firstNames, (char*) target, handles);
+    default:           return -1;
+  }
+}
+
+/*
+  completeContactColumns
+  description
+    finds the names beginning with a prefix held by the most
+    contacts, building the trie of the names the first time
+    they are completed.
+  params:
+    columns   columns being searched.
+    type      LAST_NAME or FIRST_NAME.
+    prefix    the beginning of the names being completed.
+    k         the most names to return, at most TRIE_TOP.
+    names     filled with the names found, most held first.
+    counts    filled with the number of contacts holding 
+              each name found.
+  return:
+    count     the number of names found, or -1 if the field
+              cannot be completed.
+*/
+int completeContactColumns(CONTACT_COLUMNS* columns, CONTACT_FIELD type, char* prefix, int k, char** names, int* counts)
+{
+  NAME_ID ids[TRIE_TOP];
+  NAME_TRIE** trie;
+  int i, count;
+
+  if(type == LAST_NAME)
+  {
+    trie = &columns->lastNameTrie;
+    if(*trie == NULL) *trie = newNameColumnTrie(columns, columns->lastNames);
+  }
+  else if(type == FIRST_NAME)
+  {
+    trie = &columns->firstNameTrie;
+    if(*trie == NULL) *trie = newNameColumnTrie(columns, columns->firstNames);
+  }
+  else return -1;
+
+  count = completeNameTrie(*trie, prefix, k < TRIE_TOP ? k : TRIE_TOP, ids, counts);
+  for(i = 0; i < count; i++) names[i] = nameText(ids[i]);
+  return count;
+}
+
+/*
+  groupContactColumns
+  description
+    counts the contacts of a run of rows holding each name or
+    area code, reading only the column of the field. Runs of
+    rows are counted separately so that the counting can be 
+    split between threads.
+  params:
+    columns   columns being counted.
+    type      LAST_NAME, FIRST_NAME or AREA_CODE.
+    first     the first row counted.
+    last      the row after the last counted, rows past the 
+              last of the columns are ignored.
+    counts    added to, the number of contacts holding each 
+              value, indexed by name id or area code. It must
+              have room for as many counts as there are groups.
+              Not used if no rows are counted.
+  return:
+    groups    the number of groups, the names interned or 
+              AREA_CODE_LIMIT, or -1 if the field cannot be 
+              grouped.
+*/
+int groupContactColumns(CONTACT_COLUMNS* columns, CONTACT_FIELD type, int first, int last, int* counts)
+{
+  NAME_ID* names;
+  int i;
+
+  if(last > columns->count) last = columns->count;
+  if(type == AREA_CODE)
+  {
+    for(i = first; i < last; i++) counts[columns->areaCodes[i]]++;
+    return AREA_CODE_LIMIT;
+  }
+  if(type == LAST_NAME) names = columns->lastNames;
+  else if(type == FIRST_NAME) names = columns->firstNames;
+  else return -1;
+  for(i = first; i < last; i++) counts[names[i]]++;
+  return getNameTable()->count;
+}
+
+/*
+  newNameColumnTrie
+  description
+    builds a trie of the names in a name column, counting
+    the contacts holding each.
+  params:
+    columns   columns holding the name column.
+    names     the name column.
+  return:
+    trie*     root of the trie created.
+*/
+NAME_TRIE* newNameColumnTrie(CONTACT_COLUMNS* columns, NAME_ID* names)
+{
+  int nameCount = getNameTable()->count;
+  int* counts = (int*) calloc(nameCount, sizeof(int));
+  NAME_TRIE* trie;
+  int i;
+
+  if(counts == NULL)
+  {
+    printf("sufficient memory could not be allocated to count names");
+    PAUSE
+    exit(0);
+  }
+  for(i = 0; i < columns->count; i++) counts[names[i]]++;
+  trie = newNameTrie(counts, nameCount);
+  free(counts);
+  return trie;
+}
+
+/*
+  newNameColumnIndex
+  description
+    indexes the names in a name column, grouping the rows by
+    the name they hold.
+  params:
+    columns   columns holding the name column.
+    names     the name column.
+  return:
+    index*    index created.
+*/
+NAME_COLUMN_INDEX* newNameColumnIndex(CONTACT_COLUMNS* columns, NAME_ID* names)
+{
+  int nameCount = getNameTable()->count;
+  NAME_COLUMN_INDEX* index = (NAME_COLUMN_INDEX*) calloc(1, sizeof(NAME_COLUMN_INDEX));
+  NAME_ID* held = (NAME_ID*) malloc((nameCount + 1) * sizeof(NAME_ID));
+  int* next = (int*) malloc((nameCount + 1) * sizeof(int));
+  int heldCount = 0, i;
+
+  if(index != NULL)
+  {
+    index->starts = (int*) calloc(nameCount + 1, sizeof(int));
+    index->rows = (int*) malloc((columns->count + 1) * sizeof(int));
+  }
+  if(index == NULL || held == NULL || next == NULL || index->starts == NULL || index->rows == NULL)
+  {
+    printf("sufficient memory could not be allocated to index name column");
+    PAUSE
+    exit(0);
+  }
+
+  //the rows holding each name are counted, and each name's rows
+  //placed after those of the names before it
+  for(i = 0; i < columns->count; i++) index->starts[names[i] + 1]++;
+  for(i = 0; i < nameCount; i++)
+  {
+    if(index->starts[i + 1] > 0) held[heldCount++] = i;
+    index->starts[i + 1] += index->starts[i];
+  }
+  memcpy(next, index->starts, nameCount * sizeof(int));
+  for(i = 0; i < columns->count; i++) index->rows[next[names[i]]++] = i;
+
+  index->grams = newTrigramIndex(held, heldCount);
+  free(held);
+  free(next);
+  return index;
+}
+
+/*
+  deleteNameColumnIndex
+  description
+    frees a name column index.
+  params:
+    index     index being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteNameColumnIndex(NAME_COLUMN_INDEX* index)
+{
+  if(index == NULL) return 0;
+  deleteTrigramIndex(index->grams);
+  free(index->starts);
+  free(index->rows);
+  free(index);
+  return 0;
+}
+
+/*
+  scanNameColumn
+  description
+    finds the rows of a name column holding a name.
+  params:
+    columns   columns being searched.
+    names     the name column being searched.
+    name      the id of the name being searched for.
+    handles   filled with the handles of the rows found.
+  return:
+    count     the number of rows found.
+*/
+int scanNameColumn(CONTACT_COLUMNS* columns, NAME_ID* names, NAME_ID name, int* handles)
+{
+  int i = 0, count = 0;
+#ifdef KERNEL_SSE2
+  __m128i target;
+  int mask;
+#endif
+
+  //a name which has not been interned cannot be found
+  if(name == NAME_NONE) return 0;
+
+#ifdef KERNEL_SSE2
+  target = _mm_set1_epi32(name);
+  //four ids are compared at once, the mask holds four bits for
+  //each, and rows are only visited for groups with a match
+  for(; i + 4 <= columns->count; i += 4)
+  {
+    mask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((__m128i*) (names + i)), target));
+    while(mask != 0)
+    {
+      int bit = lowestBit(mask);
+      handles[count++] = columns->handles[i + bit / 4];
+      mask &= ~(15 << bit);
+    }
+  }
+#endif
+  for(; i < columns->count; i++)
+  {
+    //the handle is always written, and kept only if the row matched
+    handles[count] = columns->handles[i];
+    count += names[i] == name;
+  }
+  return count;
+}
+
+/*
+  scanNumberColumn
+  description
+    finds the rows of the phone number column equal to a
+    phone number.
+  params:
+    columns   columns being searched.
+    number    the packed phone number being searched for.
+    handles   filled with the handles of the rows found.
+  return:
+    count     the number of rows found.
+*/
+int scanNumberColumn(CONTACT_COLUMNS* columns, long long number, int* handles)
+{
+  long long* numbers = columns->phoneNumbers;
+  int i, count = 0;
+
+  for(i = 0; i < columns->count; i++)
+  {
+    handles[count] = columns->handles[i];
+    count += numbers[i] == number;
+  }
+  return count;
+}
+
+/*
+  scanAreaColumn
+  description
+    finds the rows of the area code column equal to an area
+    code.
+  params:
+    columns   columns being searched.
+    areaCode  the area code being searched for.
+    handles   filled with the handles of the rows found.
+  return:
+    count     the number of rows found.
+*/
+int scanAreaColumn(CONTACT_COLUMNS* columns, short areaCode, int* handles)
+{
+  short* areaCodes = columns->areaCodes;
+  int i = 0, count = 0;
+#ifdef KERNEL_SSE2
+  __m128i target = _mm_set1_epi16(areaCode);
+  int mask;
+
+  //eight area codes are compared at once, the mask holds two bits
+  //for each, and rows are only visited for groups with a match
+  for(; i + 8 <= columns->count; i += 8)
+  {
+    mask = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((__m128i*) (areaCodes + i)), target));
+    while(mask != 0)
+    {
+      int lowest = mask & -mask, bit = 0;
+      while(lowest >>= 1) bit++;
+      handles[count++] = columns->handles[i + bit / 2];
+      mask &= ~(3 << bit);
+    }
+  }
+#endif
+  for(; i < columns->count; i++)
+  {
+    handles[count] = columns->handles[i];
+    count += areaCodes[i] == areaCode;
+  }
+  return count;
+}
+
+/*
+  scanPhoneRange
+  description
+    finds the rows of the phone number column lying in a range.
+  params:
+    columns   columns being searched.
+    range     the lowest and highest packed phone numbers.
+    handles   filled with the handles of the rows found.
+  return:
+    count     the number of rows found.
+*/
+int scanPhoneRange(CONTACT_COLUMNS* columns, long long* range, int* handles)
+{
+  long long* numbers = columns->phoneNumbers;
+  unsigned long long width = (unsigned long long) (range[1] - range[0]);
+  int i, count = 0;
+
+  if(range[1] < range[0]) return 0;
+  for(i = 0; i < columns->count; i++)
+  {
+    //numbers below the range wrap around above its width, so one
+    //unsigned comparison tests both ends
+    handles[count] = columns->handles[i];
+    count += (unsigned long long) (numbers[i] - range[0]) <= width;
+  }
+  return count;
+}
+
+/*
+  scanNamePrefix
+  description
+    finds the rows of a name column whose names begin with a 
+    prefix. Each name is compared once, however many rows hold
+    it.
+  params:
+    columns   columns being searched.
+    names     the name column being searched.
+    prefix    the beginning of the names being searched for.
+    handles   filled with the handles of the rows found.
+  return:
+    count     the number of rows found.
+*/
+int scanNamePrefix(CONTACT_COLUMNS* columns, NAME_ID* names, char* prefix, int* handles)
+{
+  int nameCount = getNameTable()->count, length = strlen(prefix);
+  //0 while a name has not been compared, then 1 if it fits and 2 
+  //if it does not
+  char* fits = (char*) calloc(nameCount + 1, 1);
+  int i, count = 0;
+
+  if(fits == NULL)
+  {
+    printf("sufficient memory could not be allocated to scan names");
+    PAUSE
+    exit(0);
+  }
+  for(i = 0; i < columns->count; i++)
+  {
+    if(names[i] < 0 || names[i] >= nameCount) continue;
+    if(fits[names[i]] == 0) fits[names[i]] = strncmp(nameText(names[i]), prefix, length) == 0 ? 1 : 2;
+    handles[count] = columns->handles[i];
+    count += fits[names[i]] == 1;
+  }
+  free(fits);
+  return count;
+}
+
+/*
+  scanNamePattern
+  description
+    finds the rows either of whose names match a pattern,
+    ignoring case. The matching names are found through each
+    name column's trigram index, and only their rows are
+    visited.
+  params:
+    columns   columns being searched.
+    type      NAME_CONTAINS or NAME_SIMILAR (see 
+              compareNamePattern).
+    pattern   the pattern being searched for.
+    handles   filled with the handles of the rows found.
+  return:
+    count     the number of rows found.
+*/
+int scanNamePattern(CONTACT_COLUMNS* columns, CONTACT_FIELD type, NAME_PATTERN* pattern, int* handles)
+{
+  int* rows = (int*) malloc((2 * columns->count + 1) * sizeof(int));
+  int rowCount, count = 0, i;
+
+  if(rows == NULL)
+  {
+    printf("sufficient memory could not be allocated to search contact columns");
+    PAUSE
+    exit(0);
+  }
+  rowCount = gatherNameRows(columns, &columns->lastNameIndex, columns->lastNames, type, pattern, rows);
+  rowCount += gatherNameRows(columns, &columns->firstNameIndex, columns->firstNames, type, pattern, rows + rowCount);
+
+  //rows are returned in the order they were copied, once each,
+  //though both of their names may match
+  qsort(rows, rowCount, sizeof(int), &compareRows);
+  for(i = 0; i < rowCount; i++)
+  {
+    if(i == 0 || rows[i] != rows[i - 1]) handles[count++] = columns->handles[rows[i]];
+  }
+  free(rows);
+  return count;
+}
+
+/*
+  gatherNameRows
+  description
+    finds the rows of a name column whose names match a
+    pattern, building the column's index the first time it
+    is searched.
+  params:
+    columns   columns holding the name column.
+    index     the column's index, NULL if not yet built.
+    names     the name column.
+    type      NAME_CONTAINS or NAME_SIMILAR.
+    pattern   the pattern being searched for.
+    rows      filled with the rows found.
+  return:
+    count     the number of rows found.
+*/
+int gatherNameRows(CONTACT_COLUMNS* columns, NAME_COLUMN_INDEX** index, NAME_ID* names,
+                   CONTACT_FIELD type, NAME_PATTERN* pattern, int* rows)
+{
+  NAME_ID* matched;
+  int matchCount, count = 0, i, j;
+
+  if(*index == NULL) *index = newNameColumnIndex(columns, names);
+  matched = (NAME_ID*) malloc(((*index)->grams->nameCount + 1) * sizeof(NAME_ID));
+  if(matched == NULL)
+  {
+    printf("sufficient memory could not be allocated to search contact columns");
+    PAUSE
+    exit(0);
+  }
+  if(type == NAME_CONTAINS) matchCount = containingNames((*index)->grams, pattern->text, matched);
+  else matchCount = similarNames((*index)->grams, pattern->text, pattern->distance, matched);
+
+  for(i = 0; i < matchCount; i++)
+  {
+    for(j = (*index)->starts[matched[i]]; j < (*index)->starts[matched[i] + 1]; j++)
+    {
+      rows[count++] = (*index)->rows[j];
+    }
+  }
+  free(matched);
+  return count;
+}
+
+/*
+  compareRows
+  description
+    orders rows, for qsort.
+  params:
+    a         pointer to the first row.
+    b         pointer to the second row.
+  return:
+    comparison
+              the ordinal comparison of the rows.
+*/
+int compareRows(const void* a, const void* b)
+{
+  return *((int*) a) - *((int*) b);
+}
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef LOOKUP_TABLE_H
+#define LOOKUP_TABLE_H
+#include"CommonHeader.h"
+#include"Thread.h"
+
+//slots a lookup table starts with, always a power of 2
+#define LOOKUP_SLOTS 1024
+//key of an empty slot, keys looked up are never negative
+#define LOOKUP_EMPTY ((long long) -1)
+
+typedef struct LOOKUP_TABLE_P LOOKUP_TABLE;
+typedef struct LOOKUP_SLOT_P LOOKUP_SLOT;
+
+LOOKUP_TABLE* newLookupTable(int count);
+int deleteLookupTable(LOOKUP_TABLE* table);
+int lookupInsert(LOOKUP_TABLE* table, long long key, int handle);
+int lookupRemove(LOOKUP_TABLE* table, long long key, int handle);
+int lookupFind(LOOKUP_TABLE* table, long long key, int* handles, int limit);
+  unsigned int lookupHash(LOOKUP_TABLE* table, long long key);
+  int growLookupTable(LOOKUP_TABLE* table);
+
+/*
+  LOOKUP_SLOT
+  description
+    a slot of a lookup table.
+  data:
+    key         the key a node is found by, LOOKUP_EMPTY if the
+                slot is empty.
+    handle      the handle of the node.
+*/
+struct LOOKUP_SLOT_P
+{
+  long long key;
+  int handle;
+};
+
+/*
+  LOOKUP_TABLE
+  description
+    an open addressed hash table from keys to the handles of
+    the nodes holding them, several nodes may hold one key. A
+    key is found in constant time however many nodes there
+    are, and the table is kept at most half full.
+  data:
+    slots       the slots, placed by hash and probed linearly.
+    slotCount   the number of slots, a power of 2.
+    shift       bits the hash is shifted by to index the slots.
+    count       the number of slots in use.
+    lock        held while the table is read or written.
+*/
+struct LOOKUP_TABLE_P
+{
+  LOOKUP_SLOT* slots;
+  int slotCount;
+  int shift;
+  int count;
+  MUTEX lock;
+};
+
+/*
+  newLookupTable
+  description
+    creates an empty lookup table.
+  params:
+    count     the number of nodes the table should hold
+              without growing.
+  return:
+    table*    table created.
+*/
+LOOKUP_TABLE* newLookupTable(int count)
+{
+  LOOKUP_TABLE* table = (LOOKUP_TABLE*) malloc(sizeof(LOOKUP_TABLE));
+  int i;
+
+  if(table != NULL)
+  {
+    table->slotCount = LOOKUP_SLOTS;
+    table->shift = 64 - 10;
+    while(table->slotCount < count * 2)
+    {
+      table->slotCount *= 2;
+      table->shift--;
+    }
+    table->slots = (LOOKUP_SLOT*) malloc(table->slotCount * sizeof(LOOKUP_SLOT));
+  }
+  if(table == NULL || table->slots == NULL)
+  {
+    printf("sufficient memory could not be allocated to create lookup table");
+    PAUSE
+    exit(0);
+  }
+  for(i = 0; i < table->slotCount; i++) table->slots[i].key = LOOKUP_EMPTY;
+  table->count = 0;
+  initMutex(&table->lock);
+  return table;
+}
+
+/*
+  deleteLookupTable
+  description
+    frees a lookup table.
+  params:
+    table     table being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteLookupTable(LOOKUP_TABLE* table)
+{
+  if(table == NULL) return 0;
+  free(table->slots);
+  free(table);
+  return 0;
+}
+
+/*
+  lookupInsert
+  description
+    records that a node holds a key. Recording it again does
+    nothing.
+  params:
+    table     table being added to.
+    key       the key, which must not be negative.
+    handle    the handle of the node.
+  return:
+    inserted  1 if the node was recorded, 0 if it already was.
+*/
+int lookupInsert(LOOKUP_TABLE* table, long long key, int handle)
+{
+  unsigned int mask, i;
+
+  lockMutex(&table->lock);
+  mask = (unsigned int) table->slotCount - 1;
+  for(i = lookupHash(table, key); table->slots[i].key != LOOKUP_EMPTY; i = (i + 1) & mask)
+  {
+    if(table->slots[i].key == key && table->slots[i].handle == handle)
+    {
+      unlockMutex(&table->lock);
+      return 0;
+    }
+  }
+  table->slots[i].key = key;
+  table->slots[i].handle = handle;
+  if(++table->count * 2 > table->slotCount) growLookupTable(table);
+  unlockMutex(&table->lock);
+  return 1;
+}
+
+/*
+  lookupRemove
+  description
+    forgets that a node holds a key. The slots after it which
+    would be passed over to reach their own are moved back, so
+    that no slot is left marked as removed.
+  params:
+    table     table being removed from.
+    key       the key the node was recorded with.
+    handle    the handle of the node.
+  return:
+    removed   1 if the node was recorded, otherwise 0.
+*/
+int lookupRemove(LOOKUP_TABLE* table, long long key, int handle)
+{
+  unsigned int mask, i, j, home;
+
+  lockMutex(&table->lock);
+  mask = (unsigned int) table->slotCount - 1;
+  for(i = lookupHash(table, key); table->slots[i].key != LOOKUP_EMPTY; i = (i + 1) & mask)
+  {
+    if(table->slots[i].key == key && table->slots[i].handle == handle) break;
+  }
+  if(table->slots[i].key == LOOKUP_EMPTY)
+  {
+    unlockMutex(&table->lock);
+    return 0;
+  }
+
+  for(j = (i + 1) & mask; table->slots[j].key != LOOKUP_EMPTY; j = (j + 1) & mask)
+  {
+    //a slot stays put if its home lies after the gap, up to it
+    home = lookupHash(table, table->slots[j].key);
+    if(((j - home) & mask) >= ((j - i) & mask))
+    {
+      table->slots[i] = table->slots[j];
+      i = j;
+    }
+  }
+  table->slots[i].key = LOOKUP_EMPTY;
+  table->count--;
+  unlockMutex(&table->lock);
+  return 1;
+}
+
+/*
+  lookupFind
+  description
+    finds the nodes holding a key.
+  params:
+    table     table being searched.
+    key       the key being searched for.
+    handles   filled with the handles of the nodes found.
+    limit     the most handles to return.
+  return:
+    count     the number of handles returned.
+*/
+int lookupFind(LOOKUP_TABLE* table, long long key, int* handles, int limit)
+{
+  unsigned int mask, i;
+  int count = 0;
+
+  if(key < 0) return 0;
+  lockMutex(&table->lock);
+  mask = (unsigned int) table->slotCount - 1;
+  for(i = lookupHash(table, key); table->slots[i].key != LOOKUP_EMPTY && count < limit; i = (i + 1) & mask)
+  {
+    if(table->slots[i].key == key) handles[count++] = table->slots[i].handle;
+  }
+  unlockMutex(&table->lock);
+  return count;
+}
+
+/*
+  lookupHash
+  description
+    finds the slot a key would be placed in were it free
+    (Fibonacci hashing, the key's bits are mixed by one
+    multiplication and the highest are kept).
+  params:
+    table     table the key is placed in.
+    key       the key.
+  return:
+    slot      the index of the slot.
+*/
+unsigned int lookupHash(LOOKUP_TABLE* table, long long key)
+{
+  return (unsigned int) (((unsigned long long) key * 11400714819323198485ULL) >> table->shift);
+}
+
+/*
+  growLookupTable
+  description
+    doubles the number of slots, placing each key again.
+  params:
+    table     table being grown, which must be locked.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int growLookupTable(LOOKUP_TABLE* table)
+{
+  LOOKUP_SLOT* old = table->slots;
+  int oldCount = table->slotCount, k;
+  unsigned int mask, i;
+
+  table->slotCount *= 2;
+  table->shift--;
+  table->slots = (LOOKUP_SLOT*) malloc(table->slotCount * sizeof(LOOKUP_SLOT));
+  if(table->slots == NULL)
+  {
+    printf("sufficient memory could not be allocated to grow lookup table");
+    PAUSE
+    exit(0);
+  }
+  mask = (unsigned int) table->slotCount - 1;
+  for(k = 0; k < table->slotCount; k++) table->slots[k].key = LOOKUP_EMPTY;
+  for(k = 0; k < oldCount; k++)
+  {
+    if(old[k].key == LOOKUP_EMPTY) continue;
+    for(i = lookupHash(table, old[k].key); table->slots[i].key != LOOKUP_EMPTY; i = (i + 1) & mask);
+    table->slots[i] = old[k];
+  }
+  free(old);
+  return 0;
+}
+
+#endif
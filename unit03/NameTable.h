@@ -0,0 +1,412 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+#include"CommonHeader.h"
+#include"Thread.h"
+
+//id of a name which has not been interned
+#define NAME_NONE -1
+//id of the empty name, interned when the table is created so
+//that zeroed memory holds empty names
+#define NAME_EMPTY 0
+//names are stored zero padded to a multiple of this many bytes
+#define NAME_ALIGN 16
+//bytes of name text allocated at once
+#define NAME_CHUNK_SIZE 65536
+//slots the hash table starts with, always a power of 2
+#define NAME_SLOTS 1024
+//names are held in pages of 1 << NAME_PAGE_BITS, a name's id
+//holds its page in the upper bits and its place in the lower
+#define NAME_PAGE_BITS 10
+#define NAME_PAGE_SIZE (1 << NAME_PAGE_BITS)
+#define NAME_PAGE_LIMIT 16384
+
+typedef int NAME_ID;
+typedef struct NAME_ENTRY_P NAME_ENTRY;
+typedef struct NAME_TABLE_P NAME_TABLE;
+
+NAME_TABLE* getNameTable(void);
+NAME_ID internName(char* name);
+NAME_ID findName(char* name);
+  NAME_ID addName(NAME_TABLE* table, NAME_ID* slot, char* name, int length, unsigned int hash);
+  NAME_ID* findNameSlot(NAME_TABLE* table, char* name, int length, unsigned int hash);
+  NAME_ENTRY* nameEntry(NAME_TABLE* table, NAME_ID id);
+  unsigned int hashName(char* name, int length);
+  char* storeName(NAME_TABLE* table, char* name, int length);
+  int growNameSlots(NAME_TABLE* table);
+char* nameText(NAME_ID id);
+int nameLength(NAME_ID id);
+
+/*
+  NAME_ENTRY
+  description
+    a name held by the name table.
+  data:
+    text        the text of the name.
+    length      the length of the name.
+    hash        the hash of the name (see hashName), kept so
+                the slots can be grown without rehashing text.
+*/
+struct NAME_ENTRY_P
+{
+  char* text;
+  int length;
+  unsigned int hash;
+};
+
+/*
+  NAME_TABLE
+  description
+    every name held by a contact, each stored once no matter
+    how many contacts hold it, and referred to by its id. Two
+    contacts hold the same name exactly when they hold the
+    same id. Names are never removed, so an id stays valid
+    for as long as the program runs.
+  data:
+    pages       the entry of each name, in pages indexed by the
+                upper bits of its id. Pages are never moved or
+                freed once published, so that names are read
+                without the lock while others are added.
+    count       the number of names.
+    slots       open addressed hash table of ids, NAME_NONE
+                where empty.
+    slotCount   the number of slots, a power of 2 kept at least
+                twice the number of names.
+    chunk       the block of text names are being added to.
+    chunkUsed   bytes of the chunk in use.
+    chunkSize   bytes in the chunk.
+    bytes       bytes of text allocated.
+    lock        held while a name is looked up or added.
+*/
+struct NAME_TABLE_P
+{
+  NAME_ENTRY* volatile pages[NAME_PAGE_LIMIT];
+  int count;
+  NAME_ID* slots;
+  int slotCount;
+  char* chunk;
+  int chunkUsed;
+  int chunkSize;
+  long bytes;
+  MUTEX lock;
+};
+
+//table every contact's names are interned in, created by
+//getNameTable the first time it is needed
+NAME_TABLE* volatile nameTable = NULL;
+
+/*
+  getNameTable
+  description
+    returns the name table, creating it if it does not yet
+    exist. Threads may ask for it at once, only one table is
+    ever published.
+  params:
+    void
+  return:
+    table     the name table.
+*/
+NAME_TABLE* getNameTable(void)
+{
+  NAME_TABLE* table;
+  int i;
+
+  if(nameTable != NULL) return nameTable;
+  table = (NAME_TABLE*) calloc(1, sizeof(NAME_TABLE));
+  if(table != NULL)
+  {
+    table->slots = (NAME_ID*) malloc(NAME_SLOTS * sizeof(NAME_ID));
+  }
+  if(table == NULL || table->slots == NULL)
+  {
+    printf("sufficient memory could not be allocated to create name table");
+    PAUSE
+    exit(0);
+  }
+  for(i = 0; i < NAME_SLOTS; i++) table->slots[i] = NAME_NONE;
+  table->slotCount = NAME_SLOTS;
+  initMutex(&table->lock);
+  //the empty name is added before the table is published, so
+  //that no other name can be given its id
+  addName(table, findNameSlot(table, "", 0, hashName("", 0)), "", 0, hashName("", 0));
+
+  //the first table published is kept, one built alongside it
+  //holds nothing else yet and is freed
+  if(!compareAndSwap((void* volatile*) &nameTable, NULL, table))
+  {
+    free(table->pages[0]);
+    free(table->slots);
+    free(table->chunk);
+    deleteMutex(&table->lock);
+    free(table);
+  }
+  return nameTable;
+}
+
+/*
+  internName
+  description
+    returns the id of a name, adding the name to the table
+    if it is not already held.
+  params:
+    name      the name being interned.
+  return:
+    id        the name's id.
+*/
+NAME_ID internName(char* name)
+{
+  NAME_TABLE* table = getNameTable();
+  int length = (int) strlen(name);
+  unsigned int hash = hashName(name, length);
+  NAME_ID* slot;
+  NAME_ID id;
+
+  lockMutex(&table->lock);
+  slot = findNameSlot(table, name, length, hash);
+  id = *slot == NAME_NONE ? addName(table, slot, name, length, hash) : *slot;
+  unlockMutex(&table->lock);
+  return id;
+}
+
+/*
+  addName
+  description
+    adds a name to the table, starting a new page of entries
+    when the last is full. A page is published with an atomic
+    store once it is allocated, and is never moved, so that
+    threads reading other names (see nameText) do not need the
+    lock.
+  params:
+    table     the name table, which must be locked.
+    slot      the empty slot the name is placed in.
+    name      the name being added.
+    length    the length of the name.
+    hash      the hash of the name.
+  return:
+    id        the name's id.
+*/
+NAME_ID addName(NAME_TABLE* table, NAME_ID* slot, char* name, int length, unsigned int hash)
+{
+  NAME_ID id = table->count;
+  NAME_ENTRY *page, *entry;
+
+  if((id & (NAME_PAGE_SIZE - 1)) == 0)
+  {
+    page = id >> NAME_PAGE_BITS < NAME_PAGE_LIMIT ? (NAME_ENTRY*) malloc(NAME_PAGE_SIZE * sizeof(NAME_ENTRY)) : NULL;
+    if(page == NULL)
+    {
+      printf("sufficient memory could not be allocated to intern name");
+      PAUSE
+      exit(0);
+    }
+    compareAndSwap((void* volatile*) &table->pages[id >> NAME_PAGE_BITS], NULL, page);
+  }
+  entry = nameEntry(table, id);
+  entry->text = storeName(table, name, length);
+  entry->length = length;
+  entry->hash = hash;
+  table->count++;
+  *slot = id;
+  if(table->count * 2 > table->slotCount) growNameSlots(table);
+  return id;
+}
+
+/*
+  findName
+  description
+    returns the id of a name without adding it to the table.
+  params:
+    name      the name being found.
+  return:
+    id        the name's id, or NAME_NONE if no contact has
+              held it.
+*/
+NAME_ID findName(char* name)
+{
+  NAME_TABLE* table = getNameTable();
+  int length = (int) strlen(name);
+  NAME_ID id;
+
+  lockMutex(&table->lock);
+  id = *findNameSlot(table, name, length, hashName(name, length));
+  unlockMutex(&table->lock);
+  return id;
+}
+
+/*
+  findNameSlot
+  description
+    finds the slot holding a name, or the empty slot it
+    would be placed in.
+  params:
+    table     the name table, which must be locked.
+    name      the name being found.
+    length    the length of the name.
+    hash      the hash of the name.
+  return:
+    slot      the slot of the name.
+*/
+NAME_ID* findNameSlot(NAME_TABLE* table, char* name, int length, unsigned int hash)
+{
+  unsigned int mask = (unsigned int) table->slotCount - 1;
+  unsigned int i = hash & mask;
+  NAME_ENTRY* entry;
+  NAME_ID id;
+
+  //linear probing, the length and hash are checked before the
+  //text is compared
+  while((id = table->slots[i]) != NAME_NONE)
+  {
+    entry = nameEntry(table, id);
+    if(entry->hash == hash && entry->length == length
+      && memcmp(entry->text, name, length) == 0)
+    {
+      break;
+    }
+    i = (i + 1) & mask;
+  }
+  return &table->slots[i];
+}
+
+/*
+  nameEntry
+  description
+    returns the entry of a name.
+  params:
+    table     the name table.
+    id        the name's id.
+  return:
+    entry     the name's entry.
+*/
+NAME_ENTRY* nameEntry(NAME_TABLE* table, NAME_ID id)
+{
+  return table->pages[id >> NAME_PAGE_BITS] + (id & (NAME_PAGE_SIZE - 1));
+}
+
+/*
+  hashName
+  description
+    hashes a name (FNV-1a).
+  params:
+    name      the name being hashed.
+    length    the length of the name.
+  return:
+    hash      the name's hash.
+*/
+unsigned int hashName(char* name, int length)
+{
+  unsigned int hash = 2166136261u;
+  int i;
+
+  for(i = 0; i < length; i++)
+  {
+    hash ^= (unsigned char) name[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/*
+  storeName
+  description
+    copies a name into the table's text, zero padded to a
+    multiple of NAME_ALIGN bytes. Names are placed one after
+    another in large blocks rather than allocated one at a
+    time.
+  params:
+    table     the name table, which must be locked.
+    name      the name being stored.
+    length    the length of the name.
+  return:
+    text      the stored copy of the name.
+*/
+char* storeName(NAME_TABLE* table, char* name, int length)
+{
+  int size = (length / NAME_ALIGN + 1) * NAME_ALIGN;
+  char* text;
+
+  if(table->chunk == NULL || table->chunkUsed + size > table->chunkSize)
+  {
+    table->chunkSize = size > NAME_CHUNK_SIZE ? size : NAME_CHUNK_SIZE;
+    table->chunk = (char*) malloc(table->chunkSize);
+    if(table->chunk == NULL)
+    {
+      printf("sufficient memory could not be allocated to store name");
+      PAUSE
+      exit(0);
+    }
+    table->chunkUsed = 0;
+    table->bytes += table->chunkSize;
+  }
+  text = table->chunk + table->chunkUsed;
+  memset(text, 0, size);
+  memcpy(text, name, length);
+  table->chunkUsed += size;
+  return text;
+}
+
+/*
+  growNameSlots
+  description
+    doubles the number of slots, placing each name again by
+    its hash.
+  params:
+    table     the name table, which must be locked.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int growNameSlots(NAME_TABLE* table)
+{
+  unsigned int mask;
+  unsigned int i;
+  NAME_ID id;
+
+  free(table->slots);
+  table->slotCount *= 2;
+  table->slots = (NAME_ID*) malloc(table->slotCount * sizeof(NAME_ID));
+  if(table->slots == NULL)
+  {
+    printf("sufficient memory could not be allocated to grow name table");
+    PAUSE
+    exit(0);
+  }
+  mask = (unsigned int) table->slotCount - 1;
+  for(i = 0; i <= mask; i++) table->slots[i] = NAME_NONE;
+  for(id = 0; id < table->count; id++)
+  {
+    i = nameEntry(table, id)->hash & mask;
+    while(table->slots[i] != NAME_NONE) i = (i + 1) & mask;
+    table->slots[i] = id;
+  }
+  return 0;
+}
+
+/*
+  nameText
+  description
+    returns the text of a name.
+  params:
+    id        the name's id.
+  return:
+    text      the name, zero padded to a multiple of
+              NAME_ALIGN bytes. It must not be changed.
+*/
+char* nameText(NAME_ID id)
+{
+  return nameEntry(getNameTable(), id)->text;
+}
+
+/*
+  nameLength
+  description
+    returns the length of a name.
+  params:
+    id        the name's id.
+  return:
+    length    the length of the name.
+*/
+int nameLength(NAME_ID id)
+{
+  return nameEntry(getNameTable(), id)->length;
+}
+
+#endif
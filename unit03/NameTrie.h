@@ -0,0 +1,289 @@
+#ifndef NAME_TRIE_H
+#define NAME_TRIE_H
+#include"CommonHeader.h"
+#include"NameTable.h"
+
+//completions kept by each node of a trie, the most a single query
+//can return
+#define TRIE_TOP 10
+
+typedef struct NAME_TRIE_P NAME_TRIE;
+
+NAME_TRIE* newNameTrie(int* counts, int nameCount);
+  NAME_TRIE* newTrieNode(char* label, int length);
+  int insertTrieName(NAME_TRIE* trie, NAME_ID name, int count);
+  int rankTrie(NAME_TRIE* trie);
+  int offerTrieTop(NAME_TRIE* trie, NAME_ID name, int count);
+int deleteNameTrie(NAME_TRIE* trie);
+int completeNameTrie(NAME_TRIE* trie, char* prefix, int k, NAME_ID* names, int* counts);
+
+/*
+  NAME_TRIE
+  description
+    a node of a compressed trie of names, each edge labelled
+    with as many characters as it can be without branching.
+    Each node keeps the names below it held by the most
+    contacts, so that completing a prefix only walks the
+    prefix. Labels point into the text of the name table,
+    which is never freed or moved.
+  data:
+    label       characters on the edge leading to the node.
+    length      the number of characters in the label.
+    name        the name ending at the node, NAME_NONE if
+                none does.
+    count       the number of contacts holding the name.
+    child       the first of the node's children.
+    sibling     the next child of the node's parent.
+    top         the names at or below the node held by the
+                most contacts, most first.
+    topCounts   the number of contacts holding each of them.
+    topCount    the number of names in top.
+*/
+struct NAME_TRIE_P
+{
+  char* label;
+  int length;
+  NAME_ID name;
+  int count;
+  NAME_TRIE* child;
+  NAME_TRIE* sibling;
+  NAME_ID top[TRIE_TOP];
+  int topCounts[TRIE_TOP];
+  int topCount;
+};
+
+/*
+  newNameTrie
+  description
+    builds a trie of every name held by at least one contact.
+  params:
+    counts    the number of contacts holding each name, indexed
+              by id.
+    nameCount the number of ids counted.
+  return:
+    trie*     root of the trie created.
+*/
+NAME_TRIE* newNameTrie(int* counts, int nameCount)
+{
+  NAME_TRIE* trie = newTrieNode("", 0);
+  NAME_ID id;
+
+  for(id = 0; id < nameCount; id++)
+  {
+    //the empty name completes nothing
+    if(counts[id] > 0 && nameLength(id) > 0) insertTrieName(trie, id, counts[id]);
+  }
+  rankTrie(trie);
+  return trie;
+}
+
+/*
+  newTrieNode
+  description
+    creates a trie node holding no name.
+  params:
+    label     characters on the edge leading to the node.
+    length    the number of characters in the label.
+  return:
+    trie*     node created.
+*/
+NAME_TRIE* newTrieNode(char* label, int length)
+{
+  NAME_TRIE* trie = (NAME_TRIE*) calloc(1, sizeof(NAME_TRIE));
+
+  if(trie == NULL)
+  {
+    printf("sufficient memory could not be allocated to create trie node");
+    PAUSE
+    exit(0);
+  }
+  trie->label = label;
+  trie->length = length;
+  trie->name = NAME_NONE;
+  return trie;
+}
+
+/*
+  insertTrieName
+  description
+    adds a name to a trie, splitting the edge it leaves if
+    it leaves one part way along.
+  params:
+    trie      root of the trie.
+    name      the id of the name being added.
+    count     the number of contacts holding the name.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int insertTrieName(NAME_TRIE* trie, NAME_ID name, int count)
+{
+  char* text = nameText(name);
+  int length = nameLength(name);
+  int position = 0, common;
+  NAME_TRIE *child, *middle, **link;
+
+  while(position < length)
+  {
+    link = &trie->child;
+    while(*link != NULL && (*link)->label[0] != text[position]) link = &(*link)->sibling;
+    child = *link;
+    if(child == NULL)
+    {
+      child = newTrieNode(text + position, length - position);
+      child->name = name;
+      child->count = count;
+      *link = child;
+      return 0;
+    }
+
+    common = 1;
+    while(common < child->length && position + common < length
+      && child->label[common] == text[position + common]) common++;
+    if(common < child->length)
+    {
+      //the edge is split where the name leaves it
+      middle = newTrieNode(child->label, common);
+      middle->sibling = child->sibling;
+      middle->child = child;
+      child->sibling = NULL;
+      child->label += common;
+      child->length -= common;
+      *link = middle;
+      child = middle;
+    }
+    trie = child;
+    position += common;
+  }
+  trie->name = name;
+  trie->count = count;
+  return 0;
+}
+
+/*
+  rankTrie
+  description
+    fills the completions of every node of a trie from those
+    of its children.
+  params:
+    trie      node whose completions are being filled.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int rankTrie(NAME_TRIE* trie)
+{
+  NAME_TRIE* child;
+  int i;
+
+  trie->topCount = 0;
+  if(trie->name != NAME_NONE) offerTrieTop(trie, trie->name, trie->count);
+  for(child = trie->child; child != NULL; child = child->sibling)
+  {
+    rankTrie(child);
+    for(i = 0; i < child->topCount; i++) offerTrieTop(trie, child->top[i], child->topCounts[i]);
+  }
+  return 0;
+}
+
+/*
+  offerTrieTop
+  description
+    places a name among the completions of a node if it is
+    held by more contacts than one of them. Names held by
+    as many contacts are ordered alphabetically.
+  params:
+    trie      node whose completions are being filled.
+    name      the id of the name offered.
+    count     the number of contacts holding the name.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int offerTrieTop(NAME_TRIE* trie, NAME_ID name, int count)
+{
+  int i = trie->topCount;
+
+  while(i > 0 && (trie->topCounts[i - 1] < count
+    || (trie->topCounts[i - 1] == count && strcmp(nameText(trie->top[i - 1]), nameText(name)) > 0)))
+  {
+    if(i < TRIE_TOP)
+    {
+      trie->top[i] = trie->top[i - 1];
+      trie->topCounts[i] = trie->topCounts[i - 1];
+    }
+    i--;
+  }
+  if(i < TRIE_TOP)
+  {
+    trie->top[i] = name;
+    trie->topCounts[i] = count;
+    if(trie->topCount < TRIE_TOP) trie->topCount++;
+  }
+  return 0;
+}
+
+/*
+  deleteNameTrie
+  description
+    frees a trie.
+  params:
+    trie      root of the trie being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteNameTrie(NAME_TRIE* trie)
+{
+  NAME_TRIE* child;
+
+  if(trie == NULL) return 0;
+  while((child = trie->child) != NULL)
+  {
+    trie->child = child->sibling;
+    deleteNameTrie(child);
+  }
+  free(trie);
+  return 0;
+}
+
+/*
+  completeNameTrie
+  description
+    finds the names beginning with a prefix which are held
+    by the most contacts. Only the prefix is walked, however
+    many names begin with it.
+  params:
+    trie      root of the trie.
+    prefix    the beginning of the names being completed.
+    k         the most names to return, at most TRIE_TOP.
+    names     filled with the ids of the names found, most
+              held first.
+    counts    filled with the number of contacts holding
+              each name found.
+  return:
+    count     the number of names found.
+*/
+int completeNameTrie(NAME_TRIE* trie, char* prefix, int k, NAME_ID* names, int* counts)
+{
+  int length = (int) strlen(prefix);
+  int position = 0, common, i;
+
+  while(position < length)
+  {
+    trie = trie->child;
+    while(trie != NULL && trie->label[0] != prefix[position]) trie = trie->sibling;
+    if(trie == NULL) return 0;
+
+    //the prefix may end part way along the edge
+    common = trie->length < length - position ? trie->length : length - position;
+    if(memcmp(trie->label, prefix + position, common) != 0) return 0;
+    position += common;
+  }
+
+  if(k > trie->topCount) k = trie->topCount;
+  for(i = 0; i < k; i++)
+  {
+    names[i] = trie->top[i];
+    counts[i] = trie->topCounts[i];
+  }
+  return k;
+}
+
+#endif
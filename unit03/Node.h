@@ -1,10 +1,24 @@
+#ifndef NODE_H
+#define NODE_H
 #include"CommonHeader.h"
+#include"Thread.h"
+#include"Renderer.h"
+
+//nodes are handed out of blocks of 1 << NODE_BLOCK_BITS, a node's
+//handle holds its block in the upper bits and its slot in the lower
+#define NODE_BLOCK_BITS 10
+#define NODE_BLOCK_SIZE (1 << NODE_BLOCK_BITS)
+#define NODE_BLOCK_LIMIT 16384
+//handle of no node, so that zeroed memory holds no branches. The
+//first slot of the first block is never handed out
+#define NODE_NONE 0
 
 typedef struct FunctionPointersP FunctionPointers;
 typedef struct NODE_P NODE;
+typedef struct NODE_ARENA_P NODE_ARENA;
 
 
-NODE* newNode(FunctionPointers* functionPointers, int *staticIndex, FILE* file);
+NODE* newNode(NODE_ARENA* arena, FILE* file);
 int initNode(NODE* node);
 int deleteNode(NODE* node, int clear);
 
@@ -26,11 +40,26 @@ int getIndex(NODE* node);
 int setIndex(NODE* node, int index);
 
 FunctionPointers* getFunctions(NODE* node);
+int getHandle(NODE* node);
+NODE* nodeAt(int handle);
+int* getSlot(NODE* node);
+
+NODE_ARENA* getArena(FunctionPointers* functionPointers);
+NODE* allocNode(NODE_ARENA* arena);
+NODE* cutNode(NODE_ARENA* arena);
+int freeNode(NODE* node);
+NODE* moveNode(NODE* node);
+int releaseBlocks(NODE_ARENA* arena);
 
 int nodeCompareFind(NODE* node, int type, void* target);
 int nodeCompareSort(NODE* node, NODE* nodeIn);
 int editNode(NODE* node);
+int nodeKeyStale(NODE* node);
+int updateNodeKey(NODE* node);
+long long nodeLookupKey(NODE* node);
+int nodeBitmapKey(NODE* node, int type);
 int nodeToString(NODE* node, char* string);
+int renderNode(NODE* node, RENDERER* renderer);
 
 
 /*
@@ -65,11 +94,121 @@ int nodeToString(NODE* node, char* string);
                   param   -value to be tested
                           -target key
                   return  -NULL
+    keyStale    tests whether the value has changed since it
+                last wrote the node's key.
+                  param   -value to be tested
+                  return  -1 if the key is stale, otherwise 0
+    updateKey   writes the node's key again if it is stale.
+                  param   -value whose key is updated
+                  return  -1 if the key was written, otherwise 0
+    moveValue   copies value to fresh memory, freeing the
+                original, when its node is moved.
+                  param   -value to be moved
+                          -key of the node's new location
+                  return  -pointer to moved value
+    sortKey     places value in the order values found by
+                a type of search are printed in.
+                  param   -value to be placed
+                          -type of search
+                  return  -non negative position, or -1
+                           to print in key order
+    newColumns  copies many values into a column store
+                for scanColumns.
+                  param   -values to be copied
+                          -handle of each value's node
+                          -number of values
+                  return  -pointer to new column store
+    scanColumns finds the values in a column store which
+                compareFind would find equal to a target.
+                  param   -column store to be searched
+                          -type of search
+                          -target value
+                          -buffer for the handles found
+                  return  -number found, or -1 if the type 
+                           of search is not supported
+    completeColumns
+                finds the values of a field in a column store
+                beginning with a prefix, held by the most 
+                values.
+                  param   -column store to be searched
+                          -field to be completed
+                          -prefix
+                          -most values to find
+                          -buffer for the values found
+                          -buffer for the number holding each
+                  return  -number found, or -1 if the field
+                           cannot be completed
+    groupColumns
+                counts the values of a run of rows of a column
+                store holding each value of a field of many
+                repeated values.
+                  param   -column store to be counted
+                          -field to be grouped by
+                          -first row counted
+                          -row after the last counted
+                          -counts added to, one for each group
+                  return  -number of groups, or -1 if the field
+                           cannot be grouped
+    deleteColumns
+                frees a column store.
+                  param   -column store to be free'd
+                  return  -NULL
+    lookupKey   the key the value is found by in a lookup
+                table (see LOOKUP_TABLE).
+                  param   -value to be keyed
+                  return  -non negative key, or -1 if the
+                           value is not looked up
+    lookupTarget
+                the key a type of search looks up.
+                  param   -type of search
+                          -target value
+                  return  -non negative key, or -1 if the
+                           type of search is not looked up
+    bitmapKey   the value of a field of few values held by the
+                value, for the bitmap index of the field (see
+                BITMAP_INDEX).
+                  param   -value to be keyed
+                          -type of search answered by the index
+                  return  -small non negative key, or -1 if the
+                           type of search has no index
+    bitmapTarget
+                the value of a field a search is for.
+                  param   -type of search
+                          -target value
+                  return  -small non negative key, or -1 if the
+                           type of search has no index
+    keyPrefix   the beginning shared by the keys of every value
+                a search is for, so that the search can be
+                answered from a range of keys.
+                  param   -type of search
+                          -target value
+                          -string filled with the prefix
+                  return  -1 if the keys share a prefix, 
+                           otherwise 0
+    targetToString
+                modifies given string to describe a search.
+                  param   -type of search
+                          -target value
+                          -string described in
+                  return  -NULL
+    groupToString
+                modifies given string to hold the value of a
+                field shared by a group (see groupColumns).
+                  param   -field grouped by
+                          -group
+                          -string described in
+                  return  -NULL
     toString    modifies given string to hold a 
                 representation of value
                   param   -value to be toString'd
                           -mode in which toString is to operate
                   return  -NULL
+    render      adds the string toString would make of a value
+                for a table to the output of a renderer, or NULL
+                if values are rendered through toString.
+                  param   -value to be rendered
+                          -renderer added to
+                  return  -NULL
 */
 struct FunctionPointersP
 {
@@ -80,7 +219,24 @@ struct FunctionPointersP
   int (*edit)(void* value);
   int (*compareFind)(void* value, int type, void* target);
   int (*compareSort)(void* value, void* key);
+  int (*keyStale)(void* value);
+  int (*updateKey)(void* value);
+  void* (*moveValue)(void* value, char* key);
+  long long (*sortKey)(void* value, int type);
+  void* (*newColumns)(void** values, int* handles, int count);
+  int (*scanColumns)(void* columns, int type, void* target, int* handles);
+  int (*completeColumns)(void* columns, int type, char* prefix, int k, char** names, int* counts);
+  int (*groupColumns)(void* columns, int type, int first, int last, int* counts);
+  int (*deleteColumns)(void* columns);
+  long long (*lookupKey)(void* value);
+  long long (*lookupTarget)(int type, void* target);
+  int (*bitmapKey)(void* value, int type);
+  int (*bitmapTarget)(int type, void* target);
+  int (*keyPrefix)(int type, void* target, char* prefix);
+  int (*targetToString)(int type, void* target, char* string);
+  int (*groupToString)(int type, int group, char* string);
   int (*toString)(void* value, char* string, int type);
+  int (*render)(void* value, RENDERER* renderer);
 
 };
 
@@ -88,61 +244,111 @@ struct FunctionPointersP
   NODE
   description
     node structure.
+    Branches are held as 32 bit handles rather than pointers
+    (see nodeAt), and the function pointers are held once per
+    block rather than by every node. The value comes first and
+    the key last so that the ints between them pack without
+    padding.
   data:
-    functionPointers
-                pointers to external value 
-                  param   -void
-                  return  -function pointers.
-
     value       value held in the node.
+    greater     handle of the branch with a higher ordinal
+                value, NODE_NONE if there is none.
+    less        handle of the branch with a lower ordinal
+                value, NODE_NONE if there is none.
+    handle      32 bit handle of the node within its arena, 
+                through which its function pointers are found
+                (see getFunctions).
     index       index of node in tree.
     height      the height of the node above its lowest leaf
                 (this could be used for illustration of a the
                 tree in its "tree" form).
     weight      the number of nodes with this node in their lineage +1.
-    greater     branch with a higher ordinal value.
-    less        branch with a lower ordinal value.
+    balance     data kept by the tree's balancing policy, the 
+                colour of a red-black node or the priority of a
+                treap node.
 */
 struct NODE_P
 {
-  FunctionPointers* functionPointers;
   void* value;
+  int greater;
+  int less;
+  int handle;
   int index;
   int height;
-  NODE* greater;
-  NODE* less;
-  char key[100];
+  int weight;
+  int balance;
+  char key[KEY_SIZE];
 };
 
+/*
+  NODE_ARENA
+  description
+    the nodes holding values of one kind. Nodes are cut from
+    blocks rather than allocated one by one, so that they sit
+    next to each other in memory and carry no allocator header,
+    and the function pointers are held once per block rather 
+    than by every node. An arena lives as long as the program,
+    nodes freed are handed out again.
+  data:
+    functionPointers
+                function pointers of every node in the arena.
+    free        handle of the first node freed, the rest are
+                linked through their greater branch.
+    block       handle of the first node of the block being
+                cut from.
+    used        number of nodes cut from that block.
+    spare       blocks released by releaseBlocks, whose 
+                handles are cut from again before new ones.
+    spareCount  the number of spare blocks.
+    lock        lock on the arena, nodes may be created by
+                several threads at once.
+    next        next arena created.
+*/
+struct NODE_ARENA_P
+{
+  FunctionPointers* functionPointers;
+  int free;
+  int block;
+  int used;
+  int* spare;
+  int spareCount;
+  MUTEX lock;
+  NODE_ARENA* next;
+};
+
+//every block cut, indexed by the upper bits of a handle, the
+//function pointers of the arena owning each of them and the 
+//number of nodes in use in each
+NODE* nodeBlocks[NODE_BLOCK_LIMIT];
+FunctionPointers* nodeBlockFunctions[NODE_BLOCK_LIMIT];
+int nodeBlockLive[NODE_BLOCK_LIMIT];
+//tables of slots holding the handles of the nodes of each block,
+//built the first time a slot in the block is asked for (see getSlot)
+int* volatile nodeBlockSlots[NODE_BLOCK_LIMIT];
+int volatile nodeBlockCount = 0;
+NODE_ARENA* nodeArenas = NULL;
+//index given to the next node created. It is shared by every tree
+//so that nodes moved from one tree to another by joinTrees or 
+//unionTrees hold indexes no node of their new tree holds.
+int nodeIndex = 0;
+
 /*
   newNode
   description
     creates a new node to be inserted
     into a tree.
   params:
-    functionPointers
-              function pointers being 
-              associated with the new node.
-    staticIndex
-              a value representing how many nodes
-              have been added to the tree, this
-              determines the nodes index value.
+    arena     arena of the tree the node is
+              being created for.
     file      file from which the node should 
               be read.
   return: 
     node*     node created 
 */
-NODE* newNode(FunctionPointers* functionPointers, int *staticIndex, FILE* file)
+NODE* newNode(NODE_ARENA* arena, FILE* file)
 {
-  NODE* node = (NODE*) malloc(sizeof(NODE));
-  if(node == NULL)
-  {
-    printf("sufficient memory could not be allocated to create node");
-    PAUSE
-    exit(0);
-  }
+  NODE* node = allocNode(arena);
   //init node data
-  node->functionPointers = functionPointers;
   node->value = NULL;
   node->key[0] = '\0';
   //populate value
@@ -151,7 +357,7 @@ NODE* newNode(FunctionPointers* functionPointers, int *staticIndex, FILE* file)
     loadNode(node, file);
     if(feof(file))
     {
-      free(node);
+      freeNode(node);
       return NULL;
     }
   }
@@ -161,7 +367,11 @@ NODE* newNode(FunctionPointers* functionPointers, int *staticIndex, FILE* file)
   } 
   setGreater(node, NULL);
   setLess(node, NULL);
-  setIndex(node, (*staticIndex)++);
+  //nodes may be created by several threads feeding one tree
+  setIndex(node, atomicAdd(&nodeIndex, 1));
+  node->height = 1;
+  node->weight = 1;
+  node->balance = 0;
   return node;
 }
 
@@ -180,6 +390,71 @@ int editNode(NODE* node)
   return 0;
 }
 
+/*
+  nodeKeyStale
+  description
+    tests whether the node's key no longer reflects its
+    value, in which case the node is out of place in its 
+    tree until it is removed and added again.
+  params:
+    node      node being tested.
+  return: 
+    stale     1 if the key is stale, otherwise 0.
+*/
+int nodeKeyStale(NODE* node)
+{
+  if(getFunctions(node)->keyStale == NULL) return 0;
+  return getFunctions(node)->keyStale(node->value);
+}
+
+/*
+  updateNodeKey
+  description
+    writes the node's key again if it is stale. Values only
+    mark their keys as stale when they change, and keys are 
+    written when nodes are placed in a tree.
+  params:
+    node      node whose key is being brought up to date.
+  return: 
+    updated   1 if the key was written, otherwise 0.
+*/
+int updateNodeKey(NODE* node)
+{
+  if(getFunctions(node)->updateKey == NULL) return 0;
+  return getFunctions(node)->updateKey(node->value);
+}
+
+/*
+  nodeLookupKey
+  description
+    finds the key a node is found by in a lookup table.
+  params:
+    node      node being keyed.
+  return: 
+    key       the key, or -1 if the node is not looked up.
+*/
+long long nodeLookupKey(NODE* node)
+{
+  if(getFunctions(node)->lookupKey == NULL) return -1;
+  return getFunctions(node)->lookupKey(node->value);
+}
+
+/*
+  nodeBitmapKey
+  description
+    finds the key of a node in the bitmap index of a field.
+  params:
+    node      node being keyed.
+    type      the type of search answered by the index.
+  return: 
+    key       the key, or -1 if the node is not indexed.
+*/
+int nodeBitmapKey(NODE* node, int type)
+{
+  if(getFunctions(node)->bitmapKey == NULL) return -1;
+  return getFunctions(node)->bitmapKey(node->value, type);
+}
+
 /*
   initNode
   description
@@ -216,7 +491,7 @@ int deleteNode(NODE* node, int clear)
     if(clear && getLess(node) != NULL) deleteNode(getLess(node), clear);
     
     getFunctions(node)->deleteValue(getValue(node));
-    free(node);
+    freeNode(node);
   }
   node = NULL;
   return 0;
@@ -324,7 +599,7 @@ int setValue(NODE* node, void* value)
 {
   if(node->value != NULL)
   {
-    getFunctions(node)->deleteValue(node);
+    getFunctions(node)->deleteValue(node->value);
   }
   node->value = value;
   return 0;
@@ -338,11 +613,11 @@ int setValue(NODE* node, void* value)
   params:
     node      node being retrieved from.
   return: 
-    greater   greater node.
+    greater   greater node, NULL if there is none.
 */
 NODE* getGreater(NODE* node)
 {
-  return node->greater;
+  return nodeAt(node->greater);
 }
 
 
@@ -359,7 +634,7 @@ NODE* getGreater(NODE* node)
 */
 int setGreater(NODE* node, NODE* greater)
 {
-  node->greater = greater;
+  node->greater = getHandle(greater);
   return 0;
 }
 
@@ -371,11 +646,11 @@ int setGreater(NODE* node, NODE* greater)
   params:
     node      node being retrieved from.
   return: 
-    less      lesser node.
+    less      lesser node, NULL if there is none.
 */
 NODE* getLess(NODE* node)
 {
-  return node->less;
+  return nodeAt(node->less);
 }
 
 
@@ -392,7 +667,7 @@ NODE* getLess(NODE* node)
 */
 int setLess(NODE* node, NODE* less)
 {
-  node->less = less;
+  node->less = getHandle(less);
   return 0;
 }
 
@@ -438,7 +713,282 @@ int setIndex(NODE* node, int index)
 */
 FunctionPointers* getFunctions(NODE* node)
 {
-  return node->functionPointers;
+  return nodeBlockFunctions[node->handle >> NODE_BLOCK_BITS];
+}
+
+/*
+  getHandle
+  description
+    gets the handle of a node, which identifies it in 32 bits
+    where a pointer would take 64.
+  params:
+    node      node being retrieved from, may be NULL.
+  return: 
+    handle    node handle, NODE_NONE for no node.
+*/
+int getHandle(NODE* node)
+{
+  return node == NULL ? NODE_NONE : node->handle;
+}
+
+/*
+  nodeAt
+  description
+    finds the node a handle refers to.
+  params:
+    handle    handle of the node (see getHandle).
+  return: 
+    node*     node referred to, NULL for NODE_NONE.
+*/
+NODE* nodeAt(int handle)
+{
+  if(handle == NODE_NONE) return NULL;
+  return nodeBlocks[handle >> NODE_BLOCK_BITS] + (handle & (NODE_BLOCK_SIZE - 1));
+}
+
+/*
+  getSlot
+  description
+    returns a slot which holds the handle of a node for as long
+    as the node is in use, outside of any tree. Structures which
+    may move a node while a caller holds the slot it was found
+    in hand this out instead. The slot must not be written to.
+  params:
+    node      the node.
+  return: 
+    slot      slot holding the node's handle.
+*/
+int* getSlot(NODE* node)
+{
+  int block = node->handle >> NODE_BLOCK_BITS, i;
+  int* slots = nodeBlockSlots[block];
+
+  if(slots == NULL)
+  {
+    slots = (int*) malloc(NODE_BLOCK_SIZE * sizeof(int));
+    if(slots == NULL)
+    {
+      printf("sufficient memory could not be allocated to find node");
+      PAUSE
+      exit(0);
+    }
+    for(i = 0; i < NODE_BLOCK_SIZE; i++) slots[i] = (block << NODE_BLOCK_BITS) + i;
+    //threads asking at once each build a table, only one is kept
+    if(!compareAndSwap((void* volatile*) &nodeBlockSlots[block], NULL, slots))
+    {
+      free(slots);
+      slots = nodeBlockSlots[block];
+    }
+  }
+  return slots + (node->handle & (NODE_BLOCK_SIZE - 1));
+}
+
+/*
+  getArena
+  description
+    finds the arena holding nodes with the provided function
+    pointers, creating it if there is none. This should be done
+    while a tree is created, before threads add to it.
+  params:
+    functionPointers
+              function pointers of the nodes.
+  return: 
+    arena     arena found.
+*/
+NODE_ARENA* getArena(FunctionPointers* functionPointers)
+{
+  NODE_ARENA* arena;
+
+  for(arena = nodeArenas; arena != NULL; arena = arena->next)
+  {
+    if(arena->functionPointers == functionPointers) return arena;
+  }
+  arena = (NODE_ARENA*) malloc(sizeof(NODE_ARENA));
+  if(arena == NULL)
+  {
+    printf("sufficient memory could not be allocated to create node arena");
+    PAUSE
+    exit(0);
+  }
+  arena->functionPointers = functionPointers;
+  arena->free = NODE_NONE;
+  arena->block = 0;
+  //the first node created cuts a new block
+  arena->used = NODE_BLOCK_SIZE;
+  arena->spare = NULL;
+  arena->spareCount = 0;
+  initMutex(&arena->lock);
+  arena->next = nodeArenas;
+  nodeArenas = arena;
+  return arena;
+}
+
+/*
+  allocNode
+  description
+    takes an uninitialized node from an arena, reusing one
+    which has been freed where possible.
+  params:
+    arena     arena the node is taken from.
+  return: 
+    node*     node taken, only its handle is set.
+*/
+NODE* allocNode(NODE_ARENA* arena)
+{
+  NODE* node;
+
+  lockMutex(&arena->lock);
+  if(arena->free != NODE_NONE)
+  {
+    node = nodeAt(arena->free);
+    arena->free = node->greater;
+    nodeBlockLive[node->handle >> NODE_BLOCK_BITS]++;
+    unlockMutex(&arena->lock);
+    return node;
+  }
+  unlockMutex(&arena->lock);
+  return cutNode(arena);
+}
+
+/*
+  cutNode
+  description
+    takes an uninitialized node from an arena which has never
+    been used since its block was cut, so that nodes taken one
+    after another sit next to each other in memory.
+  params:
+    arena     arena the node is taken from.
+  return: 
+    node*     node taken, only its handle is set.
+*/
+NODE* cutNode(NODE_ARENA* arena)
+{
+  NODE* node;
+  int block;
+
+  lockMutex(&arena->lock);
+  if(arena->used == NODE_BLOCK_SIZE)
+  {
+    //several arenas may cut blocks at once
+    if(arena->spareCount > 0) block = arena->spare[--arena->spareCount];
+    else block = atomicAdd(&nodeBlockCount, 1);
+    node = block < NODE_BLOCK_LIMIT ? (NODE*) malloc(NODE_BLOCK_SIZE * sizeof(NODE)) : NULL;
+    if(node == NULL)
+    {
+      printf("sufficient memory could not be allocated to create node");
+      PAUSE
+      exit(0);
+    }
+    nodeBlocks[block] = node;
+    nodeBlockFunctions[block] = arena->functionPointers;
+    nodeBlockLive[block] = 0;
+    arena->block = block << NODE_BLOCK_BITS;
+    arena->used = arena->block == NODE_NONE ? 1 : 0;
+  }
+  node = nodeAt(arena->block + arena->used);
+  node->handle = arena->block + arena->used;
+  nodeBlockLive[arena->block >> NODE_BLOCK_BITS]++;
+  arena->used++;
+  unlockMutex(&arena->lock);
+  return node;
+}
+
+/*
+  freeNode
+  description
+    returns a node to its arena, its value is not freed.
+  params:
+    node      node being freed.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int freeNode(NODE* node)
+{
+  NODE_ARENA* arena;
+
+  for(arena = nodeArenas; arena->functionPointers != getFunctions(node); arena = arena->next);
+  lockMutex(&arena->lock);
+  node->greater = arena->free;
+  arena->free = node->handle;
+  nodeBlockLive[node->handle >> NODE_BLOCK_BITS]--;
+  unlockMutex(&arena->lock);
+  return 0;
+}
+
+/*
+  moveNode
+  description
+    copies a node, and its value, to the next fresh node of
+    its arena and frees the original. Branches pointing at the
+    original must be pointed at the copy by the caller.
+  params:
+    node      node being moved.
+  return: 
+    node*     the node's new location.
+*/
+NODE* moveNode(NODE* node)
+{
+  NODE_ARENA* arena;
+  NODE* moved;
+  int handle;
+
+  for(arena = nodeArenas; arena->functionPointers != getFunctions(node); arena = arena->next);
+  moved = cutNode(arena);
+  handle = moved->handle;
+  *moved = *node;
+  moved->handle = handle;
+  moved->value = getFunctions(node)->moveValue(node->value, moved->key);
+  freeNode(node);
+  return moved;
+}
+
+/*
+  releaseBlocks
+  description
+    returns the memory of blocks in which no node is in use,
+    after nodes have been moved out of them, keeping their 
+    handles to be cut from again.
+  params:
+    arena     arena being released from.
+  return: 
+    count     the number of blocks released.
+*/
+int releaseBlocks(NODE_ARENA* arena)
+{
+  int* ptr_free;
+  int block, count = 0;
+
+  lockMutex(&arena->lock);
+  //nodes of empty blocks are taken off the free list first
+  ptr_free = &arena->free;
+  while(*ptr_free != NODE_NONE)
+  {
+    block = *ptr_free >> NODE_BLOCK_BITS;
+    if(nodeBlockLive[block] == 0 && block != arena->block >> NODE_BLOCK_BITS) *ptr_free = nodeAt(*ptr_free)->greater;
+    else ptr_free = &nodeAt(*ptr_free)->greater;
+  }
+  for(block = 0; block < nodeBlockCount && block < NODE_BLOCK_LIMIT; block++)
+  {
+    if(nodeBlocks[block] == NULL || nodeBlockLive[block] != 0) continue;
+    if(nodeBlockFunctions[block] != arena->functionPointers) continue;
+    if(block == arena->block >> NODE_BLOCK_BITS) continue;
+
+    arena->spare = (int*) realloc(arena->spare, (arena->spareCount + 1) * sizeof(int));
+    if(arena->spare == NULL)
+    {
+      printf("sufficient memory could not be allocated to release nodes");
+      PAUSE
+      exit(0);
+    }
+    free(nodeBlocks[block]);
+    nodeBlocks[block] = NULL;
+    free(nodeBlockSlots[block]);
+    nodeBlockSlots[block] = NULL;
+    arena->spare[arena->spareCount++] = block;
+    count++;
+  }
+  unlockMutex(&arena->lock);
+  return count;
 }
 
 /*
@@ -504,3 +1054,33 @@ int nodeToString(NODE* node, char* string)
   return 0;
 }
 
+/*
+  renderNode
+  description
+    adds the row of a node (see nodeToString) to the output of a
+    renderer.
+  params:
+    node      node who's data is being rendered.
+    renderer  renderer the row is added to.
+  return: 
+    NULL      0 value indicating successful exicution.
+*/
+int renderNode(NODE* node, RENDERER* renderer)
+{
+  FunctionPointers* functionPointers = getFunctions(node);
+  char* valueString = valueBufferB;
+
+  renderNumber(renderer, getIndex(node), 5);
+  renderSpaces(renderer, 5);
+  if(functionPointers->render != NULL) functionPointers->render(getValue(node), renderer);
+  else
+  {
+    functionPointers->toString(getValue(node), valueString, 0);
+    renderText(renderer, valueString);
+    valueBufferB[0] = '\0';
+  }
+  renderChar(renderer, '\n');
+  return 0;
+}
+
+#endif
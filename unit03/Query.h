@@ -0,0 +1,1024 @@
+#ifndef QUERY_H
+#define QUERY_H
+#include"CommonHeader.h"
+//BinaryTree.h, which queries are answered through, is included
+//before this header
+
+//nodes of a key range walked to estimate how many it holds, and
+//handles looked up to estimate how many nodes hold a key
+#define QUERY_PROBE 1024
+//a search through no index is assumed to fit one node in this many
+#define QUERY_SELECTIVITY 10
+//rows of a column read in the time taken to visit one node
+#define QUERY_COLUMN_RATE 16
+
+typedef struct QUERY_P QUERY;
+typedef struct QUERY_PLAN_P QUERY_PLAN;
+typedef enum QUERY_OP_P QUERY_OP;
+typedef enum QUERY_PATH_P QUERY_PATH;
+
+QUERY* newQuery(FIND_BY type, void* target);
+QUERY* queryAnd(QUERY* a, QUERY* b);
+QUERY* queryOr(QUERY* a, QUERY* b);
+  QUERY* joinQuery(QUERY_OP op, QUERY* a, QUERY* b);
+int deleteQuery(QUERY* query);
+int matchQuery(NODE* node, QUERY* query);
+
+QUERY_PLAN* planQuery(TREE* tree, QUERY* query, FIND_BY order, int limit);
+  QUERY_PLAN* planTerm(TREE* tree, QUERY* query);
+  QUERY_PLAN* planBranch(TREE* tree, QUERY* query);
+  int estimateRange(TREE* tree, char* prefix);
+  int countVisit(int* ptr_branch, void* context);
+int deletePlan(QUERY_PLAN* plan);
+int printPlan(TREE* tree, QUERY_PLAN* plan);
+  int printStep(TREE* tree, QUERY_PLAN* plan, int depth);
+
+int runQuery(TREE* tree, QUERY_PLAN* plan, NODE** results);
+  BITMAP* runStep(TREE* tree, QUERY_PLAN* plan);
+  int handleVisit(int* ptr_branch, void* context);
+  int streamVisit(int* ptr_branch, void* context);
+  int scanQuery(TREE* tree, QUERY* query, NODE** results);
+  int filterNodes(NODE** nodes, int count, QUERY* query);
+  THREAD_RETURN THREAD_CALL scanThread(void* argument);
+int printQuery(TREE* tree, QUERY* query, FIND_BY order, int limit);
+
+/*
+  QUERY_OP
+  description
+    what a QUERY tests.
+  data:
+    QUERY_TERM  one field, through compareFind.
+    QUERY_AND   every one of its parts.
+    QUERY_OR    any one of its parts.
+*/
+enum QUERY_OP_P
+{
+  QUERY_TERM = 0 ,
+  QUERY_AND  = 1 ,
+  QUERY_OR   = 2
+};
+
+/*
+  QUERY_PATH
+  description
+    how the nodes fitting a step of a QUERY_PLAN are found.
+  data:
+    PATH_KEY_RANGE
+                the range of keys holding them is walked (see
+                the keyPrefix function pointer).
+    PATH_LOOKUP they are looked up in the lookup table.
+    PATH_BITMAP they are read from a bitmap index.
+    PATH_COLUMNS
+                the column store is scanned for them.
+    PATH_FILTER they are not found, only tested among the nodes
+                found by other steps.
+    PATH_INTERSECT
+                those found by the cheapest part are kept, less
+                those missing from the nodes of parts cheap 
+                enough to find.
+    PATH_UNION  those found by every part are merged.
+    PATH_SCAN   every node is tested, on as many threads as
+                there are processors for large trees.
+    PATH_ORDERED_SCAN
+                the tree is walked in order of key until enough
+                nodes have been found.
+*/
+enum QUERY_PATH_P
+{
+  PATH_KEY_RANGE    = 0 ,
+  PATH_LOOKUP       = 1 ,
+  PATH_BITMAP       = 2 ,
+  PATH_COLUMNS      = 3 ,
+  PATH_FILTER       = 4 ,
+  PATH_INTERSECT    = 5 ,
+  PATH_UNION        = 6 ,
+  PATH_SCAN         = 7 ,
+  PATH_ORDERED_SCAN = 8
+};
+
+/*
+  QUERY
+  description
+    a test of the values of nodes, which fields are tested and
+    how they are combined. The targets of its terms belong to
+    the caller, and must be kept until the query is deleted.
+  data:
+    op          what the query tests.
+    type        the field tested by a term, passed to
+                compareFind.
+    target      the value a term's field is compared with.
+    parts       the first part of an AND or OR.
+    next        the next part of the query this is a part of.
+*/
+struct QUERY_P
+{
+  QUERY_OP op;
+  FIND_BY type;
+  void* target;
+  QUERY* parts;
+  QUERY* next;
+};
+
+/*
+  QUERY_PLAN
+  description
+    how a query is answered, a step for each part of it, with
+    the number of nodes expected to fit each and the cost of
+    finding them, counted in node visits.
+  data:
+    query       the part of the query the step answers.
+    path        how the nodes fitting it are found.
+    rows        the number of nodes expected to fit it.
+    cost        the expected cost of finding them.
+    prefix      the beginning of the keys walked by a
+                PATH_KEY_RANGE step.
+    steps       the first step of each part of an AND or OR.
+    next        the next step of the step this is part of.
+    driver      the step whose nodes an intersection starts
+                from.
+    joined      set on the steps of an intersection whose nodes
+                are intersected with those of the driver, rather
+                than tested among them.
+    order       how the results are ordered, BY_KEY or a type
+                of search the values sort (see sortKey). Kept
+                by the first step.
+    limit       the most results returned, 0 for all. Kept by
+                the first step.
+    ordered     set on the first step if its nodes are found in
+                order of key, and no more are found than the
+                limit.
+    threads     the number of threads a PATH_SCAN step uses.
+*/
+struct QUERY_PLAN_P
+{
+  QUERY* query;
+  QUERY_PATH path;
+  int rows;
+  double cost;
+  char prefix[KEY_SIZE];
+  QUERY_PLAN* steps;
+  QUERY_PLAN* next;
+  QUERY_PLAN* driver;
+  int joined;
+  FIND_BY order;
+  int limit;
+  int ordered;
+  int threads;
+};
+
+//names of the paths, as printed in plans
+char* queryPaths[] = {"KEY RANGE", "LOOKUP", "BITMAP", "COLUMN SCAN", "FILTER",
+                      "INTERSECT", "UNION", "SCAN", "ORDERED SCAN"};
+
+/*
+  HandleContext
+  description
+    state of a walk adding the handles of nodes to a bitmap.
+  data:
+    bitmap      bitmap being added to.
+    count       the number of nodes visited so far.
+    limit       the number of nodes after which the walk is
+                stopped, 0 for none.
+*/
+typedef struct HandleContextP
+{
+  BITMAP* bitmap;
+  int count;
+  int limit;
+} HandleContext;
+
+/*
+  StreamContext
+  description
+    state of a walk collecting nodes fitting a query, in order,
+    until enough have been found.
+  data:
+    query       the query nodes are tested against.
+    results     array being filled.
+    count       the number of nodes found so far.
+    limit       the number of nodes after which the walk is
+                stopped, 0 for none.
+*/
+typedef struct StreamContextP
+{
+  QUERY* query;
+  NODE** results;
+  int count;
+  int limit;
+} StreamContext;
+
+/*
+  ScanTask
+  description
+    a share of the nodes of a tree tested against a query by
+    one thread.
+  data:
+    query       the query nodes are tested against.
+    nodes       the nodes being tested, those fitting are moved
+                to the beginning.
+    count       the number of nodes being tested, then the
+                number fitting.
+*/
+typedef struct ScanTaskP
+{
+  QUERY* query;
+  NODE** nodes;
+  int count;
+} ScanTask;
+
+/*
+  newQuery
+  description
+    creates a query testing one field.
+  params:
+    type      the field tested, passed to compareFind.
+    target    the value the field is compared with, which must
+              be kept until the query is deleted.
+  return:
+    query*    query created.
+*/
+QUERY* newQuery(FIND_BY type, void* target)
+{
+  QUERY* query = (QUERY*) calloc(1, sizeof(QUERY));
+
+  if(query == NULL)
+  {
+    printf("sufficient memory could not be allocated to create query");
+    PAUSE
+    exit(0);
+  }
+  query->op = QUERY_TERM;
+  query->type = type;
+  query->target = target;
+  return query;
+}
+
+/*
+  queryAnd
+  description
+    combines two queries into one fitting the nodes fitting
+    both. The queries become part of it.
+  params:
+    a         first query.
+    b         second query.
+  return:
+    query*    the combined query.
+*/
+QUERY* queryAnd(QUERY* a, QUERY* b)
+{
+  return joinQuery(QUERY_AND, a, b);
+}
+
+/*
+  queryOr
+  description
+    combines two queries into one fitting the nodes fitting
+    either. The queries become part of it.
+  params:
+    a         first query.
+    b         second query.
+  return:
+    query*    the combined query.
+*/
+QUERY* queryOr(QUERY* a, QUERY* b)
+{
+  return joinQuery(QUERY_OR, a, b);
+}
+
+/*
+  joinQuery
+  description
+    combines two queries, adding the second to the parts of the
+    first when it already combines its parts the same way.
+  params:
+    op        QUERY_AND or QUERY_OR.
+    a         first query.
+    b         second query.
+  return:
+    query*    the combined query.
+*/
+QUERY* joinQuery(QUERY_OP op, QUERY* a, QUERY* b)
+{
+  QUERY *query, *last;
+
+  if(a == NULL) return b;
+  if(b == NULL) return a;
+  if(a->op == op) query = a;
+  else
+  {
+    query = newQuery(BY_KEY, NULL);
+    query->op = op;
+    query->parts = a;
+  }
+  for(last = query->parts; last->next != NULL; last = last->next);
+  if(b->op == op)
+  {
+    last->next = b->parts;
+    free(b);
+  }
+  else last->next = b;
+  return query;
+}
+
+/*
+  deleteQuery
+  description
+    frees a query and its parts, but not their targets.
+  params:
+    query     query being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteQuery(QUERY* query)
+{
+  QUERY* next;
+
+  while(query != NULL)
+  {
+    next = query->next;
+    deleteQuery(query->parts);
+    free(query);
+    query = next;
+  }
+  return 0;
+}
+
+/*
+  matchQuery
+  description
+    tests whether the value of a node fits a query.
+  params:
+    node      node being tested.
+    query     the query.
+  return:
+    fits      1 if the node fits, otherwise 0.
+*/
+int matchQuery(NODE* node, QUERY* query)
+{
+  QUERY* part;
+
+  if(query->op == QUERY_TERM) return !nodeCompareFind(node, query->type, query->target);
+  for(part = query->parts; part != NULL; part = part->next)
+  {
+    if(matchQuery(node, part) != (query->op == QUERY_AND)) return query->op == QUERY_OR;
+  }
+  return query->op == QUERY_AND;
+}
+
+/*
+  planQuery
+  description
+    chooses how a query is answered. Each term is found through
+    the cheapest index of its field, an AND starts from its
+    cheapest part and an OR merges its parts. Queries which no
+    index can answer cheaply are answered by testing every node,
+    in parallel, or in order of key when only the first few are
+    wanted.
+  params:
+    tree      tree being queried.
+    query     the query.
+    order     BY_KEY, or a type of search the values sort the
+              results of (see sortKey).
+    limit     the most results wanted, 0 for all.
+  return:
+    plan*     plan created, to be freed by deletePlan.
+*/
+QUERY_PLAN* planQuery(TREE* tree, QUERY* query, FIND_BY order, int limit)
+{
+  QUERY_PLAN *plan = planBranch(tree, query), *start;
+  double scanCost, orderedCost;
+
+  plan->order = order;
+  plan->limit = limit;
+  plan->threads = tree->size > PARALLEL_GRAIN ? processorCount() : 1;
+  scanCost = (double) tree->size / plan->threads;
+  if(plan->path == PATH_FILTER || scanCost < plan->cost)
+  {
+    plan->path = PATH_SCAN;
+    plan->cost = scanCost;
+  }
+  start = plan->path == PATH_INTERSECT ? plan->driver : plan;
+  if(order == BY_KEY && limit > 0)
+  {
+    if(start->path == PATH_KEY_RANGE)
+    {
+      //the range is walked in order, and left once enough are found
+      plan->ordered = 1;
+      if(plan->rows > 0 && start->rows > plan->rows) plan->cost = (double) limit * start->rows / plan->rows;
+      else plan->cost = limit;
+      if(plan->cost > start->cost) plan->cost = start->cost;
+    }
+    //fitting nodes are assumed to be spread evenly through the keys
+    orderedCost = (double) limit * tree->size / (plan->rows > 0 ? plan->rows : 1);
+    if(orderedCost < plan->cost)
+    {
+      plan->path = PATH_ORDERED_SCAN;
+      plan->cost = orderedCost;
+      plan->ordered = 1;
+    }
+  }
+  if(limit > 0 && plan->rows > limit) plan->rows = limit;
+  return plan;
+}
+
+/*
+  planBranch
+  description
+    plans a part of a query, a term or the combination of its
+    parts.
+  params:
+    tree      tree being queried.
+    query     the part of the query.
+  return:
+    plan*     step created.
+*/
+QUERY_PLAN* planBranch(TREE* tree, QUERY* query)
+{
+  QUERY_PLAN *plan, *step, *last = NULL;
+  QUERY* part;
+  double cost;
+
+  if(query->op == QUERY_TERM) return planTerm(tree, query);
+  plan = (QUERY_PLAN*) calloc(1, sizeof(QUERY_PLAN));
+  if(plan == NULL)
+  {
+    printf("sufficient memory could not be allocated to plan query");
+    PAUSE
+    exit(0);
+  }
+  plan->query = query;
+  plan->rows = query->op == QUERY_AND ? tree->size : 0;
+  plan->path = query->op == QUERY_AND ? PATH_INTERSECT : PATH_UNION;
+  for(part = query->parts; part != NULL; part = part->next)
+  {
+    step = planBranch(tree, part);
+    if(last == NULL) plan->steps = step;
+    else last->next = step;
+    last = step;
+
+    if(query->op == QUERY_OR)
+    {
+      plan->rows += step->rows;
+      plan->cost += step->cost;
+      //a part no index answers leaves every node to be tested
+      if(step->path == PATH_FILTER) plan->path = PATH_FILTER;
+      continue;
+    }
+    if(step->rows < plan->rows) plan->rows = step->rows;
+    if(step->path != PATH_FILTER && (plan->driver == NULL || step->cost < plan->driver->cost)) plan->driver = step;
+  }
+  if(plan->rows > tree->size) plan->rows = tree->size;
+
+  if(query->op == QUERY_AND)
+  {
+    if(plan->driver == NULL) plan->path = PATH_FILTER;
+    else
+    {
+      //the nodes of other parts are intersected with those of the
+      //driver when that costs less than testing the driver's nodes,
+      //bitmaps being read without visiting any
+      plan->cost = plan->driver->cost;
+      for(step = plan->steps; step != NULL; step = step->next)
+      {
+        if(step == plan->driver || step->path == PATH_FILTER) continue;
+        cost = step->path == PATH_BITMAP ? (double) step->rows / QUERY_COLUMN_RATE : step->cost;
+        if(cost >= plan->driver->rows) continue;
+        step->joined = 1;
+        plan->cost += cost;
+      }
+    }
+  }
+  if(plan->path == PATH_FILTER) plan->cost = tree->size;
+  return plan;
+}
+
+/*
+  planTerm
+  description
+    plans a term of a query, choosing the cheapest index of its
+    field, and estimates the number of nodes fitting it from
+    that index.
+  params:
+    tree      tree being queried.
+    query     the term.
+  return:
+    plan*     step created.
+*/
+QUERY_PLAN* planTerm(TREE* tree, QUERY* query)
+{
+  QUERY_PLAN* plan = (QUERY_PLAN*) calloc(1, sizeof(QUERY_PLAN));
+  FunctionPointers* functions = tree->functionPointers;
+  NODE* found[QUERY_PROBE];
+  int rows;
+
+  if(plan == NULL)
+  {
+    printf("sufficient memory could not be allocated to plan query");
+    PAUSE
+    exit(0);
+  }
+  plan->query = query;
+  plan->path = PATH_FILTER;
+  plan->rows = tree->size / QUERY_SELECTIVITY;
+  plan->cost = tree->size;
+
+  //a lookup or bitmap gives the number of nodes fitting exactly
+  if((rows = lookupTree(tree, query->type, query->target, found, QUERY_PROBE)) >= 0)
+  {
+    plan->path = PATH_LOOKUP;
+    plan->rows = rows;
+    plan->cost = rows;
+  }
+  else if((rows = countTree(tree, query->type, query->target)) >= 0)
+  {
+    plan->path = PATH_BITMAP;
+    plan->rows = rows;
+    plan->cost = rows;
+  }
+  else if(functions->keyPrefix != NULL && functions->keyPrefix(query->type, query->target, plan->prefix))
+  {
+    plan->path = PATH_KEY_RANGE;
+    plan->rows = estimateRange(tree, plan->prefix);
+    plan->cost = plan->rows;
+  }
+  else if(functions->scanColumns != NULL)
+  {
+    plan->path = PATH_COLUMNS;
+    plan->cost = (double) tree->size / QUERY_COLUMN_RATE;
+    //columns written to since they were built are built again
+    if(tree->columns == NULL || tree->columnsStale) plan->cost += tree->size;
+  }
+  return plan;
+}
+
+/*
+  estimateRange
+  description
+    estimates the number of nodes whose keys begin with a
+    prefix, counting them without a walk if the tree keeps the
+    weights of its branches, otherwise walking up to 
+    QUERY_PROBE of them. Ranges larger than that are assumed
+    to hold at least as many nodes as a search through no 
+    index is assumed to fit, so that they are weighed like
+    the terms no index can estimate.
+  params:
+    tree      tree being queried.
+    prefix    the beginning of the keys.
+  return:
+    rows      the estimated number of nodes.
+*/
+int estimateRange(TREE* tree, char* prefix)
+{
+  int count = countRange(tree, prefix);
+
+  if(count < 0)
+  {
+    count = 0;
+    if(!rangeTree(tree, prefix, &countVisit, (void*) &count)) return count;
+  }
+  else if(count < QUERY_PROBE) return count;
+  return count > tree->size / QUERY_SELECTIVITY ? count : tree->size / QUERY_SELECTIVITY;
+}
+
+/*
+  countVisit
+  description
+    walk visitor counting the nodes visited, which stops the
+    walk after QUERY_PROBE.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the count.
+  return:
+    stop      1 once QUERY_PROBE nodes have been counted.
+*/
+int countVisit(int* ptr_branch, void* context)
+{
+  //only the number of nodes matters, not which they are
+  (void) ptr_branch;
+  return ++*((int*) context) >= QUERY_PROBE;
+}
+
+/*
+  deletePlan
+  description
+    frees a plan and its steps.
+  params:
+    plan      plan being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deletePlan(QUERY_PLAN* plan)
+{
+  QUERY_PLAN* next;
+
+  while(plan != NULL)
+  {
+    next = plan->next;
+    deletePlan(plan->steps);
+    free(plan);
+    plan = next;
+  }
+  return 0;
+}
+
+/*
+  printPlan
+  description
+    prints how a query will be answered, with the number of
+    nodes expected to fit each step and its cost.
+  params:
+    tree      tree being queried.
+    plan      the plan.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int printPlan(TREE* tree, QUERY_PLAN* plan)
+{
+  printf("%-34s%10s%12s\n", "plan", "rows", "cost");
+  printStep(tree, plan, 0);
+  if(plan->order == BY_KEY) printf("in order of key");
+  else printf("in order of field %d", (int) plan->order);
+  if(plan->limit > 0) printf(", first %d%s", plan->limit, plan->ordered ? " (stops early)" : "");
+  printf("\n\n");
+  return 0;
+}
+
+/*
+  printStep
+  description
+    prints a step of a plan and the steps of its parts.
+  params:
+    tree      tree being queried.
+    plan      the step.
+    depth     the number of steps it is part of.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int printStep(TREE* tree, QUERY_PLAN* plan, int depth)
+{
+  char* description = valueBufferB;
+  char step[BUFFER];
+  QUERY_PLAN* part;
+
+  description[0] = '\0';
+  if(plan->path == PATH_SCAN && plan->threads > 1) sprintf(step, "%*sPARALLEL SCAN x%d", depth * 2, "", plan->threads);
+  else sprintf(step, "%*s%s", depth * 2, "", queryPaths[plan->path]);
+  printf("%-34s%10d%12.0f", step, plan->rows, plan->cost);
+
+  if(plan->query->op == QUERY_TERM)
+  {
+    if(tree->functionPointers->targetToString != NULL)
+    {
+      tree->functionPointers->targetToString(plan->query->type, plan->query->target, description);
+    }
+    else sprintf(description, "field %d", (int) plan->query->type);
+    printf("  %s", description);
+  }
+  else printf("  %s", plan->query->op == QUERY_AND ? "every part" : "any part");
+  if(plan->path == PATH_KEY_RANGE) printf(" (keys %s...)", plan->prefix);
+  printf("\n");
+  description[0] = '\0';
+
+  for(part = plan->steps; part != NULL; part = part->next)
+  {
+    printStep(tree, part, depth + 1);
+    if(part == plan->driver) printf("%*s(first)\n", depth * 2 + 4, "");
+    if(part->joined) printf("%*s(intersected)\n", depth * 2 + 4, "");
+  }
+  return 0;
+}
+
+/*
+  runQuery
+  description
+    finds the nodes fitting a query by following its plan.
+  params:
+    tree      tree being queried.
+    plan      the plan, from planQuery.
+    results   filled with the nodes found, in the order of the
+              plan. It must have room for one more node than
+              the tree holds.
+  return:
+    count     the number of nodes found.
+*/
+int runQuery(TREE* tree, QUERY_PLAN* plan, NODE** results)
+{
+  StreamContext stream;
+  BITMAP* found;
+  QUERY_PLAN* start = plan->path == PATH_INTERSECT ? plan->driver : plan;
+  int count = 0;
+
+  stream.query = plan->query;
+  stream.results = results;
+  stream.count = 0;
+  stream.limit = plan->limit;
+  if(plan->path == PATH_ORDERED_SCAN)
+  {
+    tree->engine->walk(tree, &streamVisit, (void*) &stream);
+    return stream.count;
+  }
+  if(plan->ordered)
+  {
+    rangeTree(tree, start->prefix, &streamVisit, (void*) &stream);
+    return stream.count;
+  }
+
+  if(plan->path == PATH_SCAN) count = scanQuery(tree, plan->query, results);
+  else
+  {
+    found = runStep(tree, plan);
+    count = bitmapElements(found, results);
+    deleteBitmap(found);
+    //the nodes found by the plan may fit parts of the query only
+    count = filterNodes(results, count, plan->query);
+    qsort(results, count, sizeof(NODE*), &compareElements);
+  }
+  if(plan->order != BY_KEY) radixSortElements(results, count, plan->order);
+  if(plan->limit > 0 && count > plan->limit) count = plan->limit;
+  return count;
+}
+
+/*
+  runStep
+  description
+    finds the handles of the nodes a step of a plan finds,
+    which include those fitting its part of the query.
+  params:
+    tree      tree being queried.
+    plan      the step, which must not be PATH_FILTER.
+  return:
+    bitmap*   new bitmap of the handles, to be freed.
+*/
+BITMAP* runStep(TREE* tree, QUERY_PLAN* plan)
+{
+  HandleContext context;
+  QUERY_PLAN* step;
+  BITMAP *found, *part, *combined;
+  NODE** nodes;
+  int* handles;
+  int i, count;
+
+  context.bitmap = newBitmap();
+  context.count = 0;
+  context.limit = 0;
+  switch(plan->path)
+  {
+    case PATH_KEY_RANGE:
+      rangeTree(tree, plan->prefix, &handleVisit, (void*) &context);
+      return context.bitmap;
+    case PATH_BITMAP:
+      found = bitmapOr(context.bitmap, bitmapTree(tree, plan->query->type, plan->query->target));
+      deleteBitmap(context.bitmap);
+      return found;
+    case PATH_INTERSECT:
+      deleteBitmap(context.bitmap);
+      found = runStep(tree, plan->driver);
+      for(step = plan->steps; step != NULL; step = step->next)
+      {
+        if(!step->joined) continue;
+        if(step->path == PATH_BITMAP) combined = bitmapAnd(found, bitmapTree(tree, step->query->type, step->query->target));
+        else
+        {
+          part = runStep(tree, step);
+          combined = bitmapAnd(found, part);
+          deleteBitmap(part);
+        }
+        deleteBitmap(found);
+        found = combined;
+      }
+      return found;
+    case PATH_UNION:
+      found = context.bitmap;
+      for(step = plan->steps; step != NULL; step = step->next)
+      {
+        part = runStep(tree, step);
+        combined = bitmapOr(found, part);
+        deleteBitmap(found);
+        deleteBitmap(part);
+        found = combined;
+      }
+      return found;
+    default:
+      break;
+  }
+
+  //lookups and column scans give every node fitting the term
+  nodes = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  handles = (int*) nodes;
+  if(nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to run query");
+    PAUSE
+    exit(0);
+  }
+  if(plan->path == PATH_LOOKUP)
+  {
+    count = lookupTree(tree, plan->query->type, plan->query->target, nodes, tree->size + 1);
+    for(i = 0; i < count; i++) bitmapAdd(context.bitmap, (unsigned int) getHandle(nodes[i]));
+  }
+  else
+  {
+    if(tree->columns == NULL || tree->columnsStale) buildColumns(tree);
+    count = tree->functionPointers->scanColumns(tree->columns, plan->query->type, plan->query->target, handles);
+    //a field the columns do not hold leaves every node to be tested
+    if(count < 0)
+    {
+      found = bitmapOr(context.bitmap, bitmapTreeAll(tree));
+      deleteBitmap(context.bitmap);
+      context.bitmap = found;
+    }
+    for(i = 0; i < count; i++) bitmapAdd(context.bitmap, (unsigned int) handles[i]);
+  }
+  free(nodes);
+  return context.bitmap;
+}
+
+/*
+  handleVisit
+  description
+    walk visitor adding the handle of each node to the bitmap
+    of a HandleContext.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the HandleContext.
+  return:
+    stop      1 once the limit of the context is reached.
+*/
+int handleVisit(int* ptr_branch, void* context)
+{
+  HandleContext* handle = (HandleContext*) context;
+
+  bitmapAdd(handle->bitmap, (unsigned int) *ptr_branch);
+  return ++handle->count == handle->limit;
+}
+
+/*
+  streamVisit
+  description
+    walk visitor collecting the nodes fitting the query of a
+    StreamContext.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the StreamContext.
+  return:
+    stop      1 once the limit of the context is reached.
+*/
+int streamVisit(int* ptr_branch, void* context)
+{
+  StreamContext* stream = (StreamContext*) context;
+
+  if(!matchQuery(nodeAt(*ptr_branch), stream->query)) return 0;
+  stream->results[stream->count++] = nodeAt(*ptr_branch);
+  return stream->count == stream->limit;
+}
+
+/*
+  scanQuery
+  description
+    tests every node of a tree against a query (see 
+    filterNodes).
+  params:
+    tree      tree being queried.
+    query     the query.
+    results   filled with the nodes fitting, in order of key.
+              It must have room for one more node than the
+              tree holds.
+  return:
+    count     the number of nodes fitting.
+*/
+int scanQuery(TREE* tree, QUERY* query, NODE** results)
+{
+  CollectContext context;
+
+  context.nodes = results;
+  context.count = 0;
+  tree->engine->walk(tree, &collectVisit, (void*) &context);
+  return filterNodes(results, context.count, query);
+}
+
+/*
+  filterNodes
+  description
+    keeps the nodes fitting a query, in the order they are 
+    given. The nodes are split between as many threads as 
+    there are processors, when there are enough of them.
+  params:
+    nodes     the nodes being tested, those fitting are moved
+              to the beginning.
+    count     the number of nodes.
+    query     the query.
+  return:
+    count     the number of nodes fitting.
+*/
+int filterNodes(NODE** nodes, int count, QUERY* query)
+{
+  ScanTask* tasks;
+  THREAD* threads;
+  int* started;
+  int taskCount = 1, share, i, fitting = 0;
+
+  if(count > PARALLEL_GRAIN) taskCount = processorCount();
+  tasks = (ScanTask*) malloc(taskCount * sizeof(ScanTask));
+  threads = (THREAD*) malloc(taskCount * sizeof(THREAD));
+  started = (int*) calloc(taskCount, sizeof(int));
+  if(tasks == NULL || threads == NULL || started == NULL)
+  {
+    printf("sufficient memory could not be allocated to filter nodes");
+    PAUSE
+    exit(0);
+  }
+  share = (count + taskCount - 1) / taskCount;
+  for(i = 0; i < taskCount; i++)
+  {
+    tasks[i].query = query;
+    tasks[i].nodes = nodes + i * share;
+    tasks[i].count = i * share >= count ? 0 : (count - i * share < share ? count - i * share : share);
+    //the first share is tested by this thread, as are any whose
+    //thread could not be started
+    if(i > 0) started[i] = !startThread(&threads[i], &scanThread, &tasks[i]);
+  }
+  for(i = 0; i < taskCount; i++)
+  {
+    if(!started[i]) scanThread(&tasks[i]);
+  }
+  for(i = 0; i < taskCount; i++)
+  {
+    if(started[i]) joinThread(threads[i]);
+    memmove(nodes + fitting, tasks[i].nodes, tasks[i].count * sizeof(NODE*));
+    fitting += tasks[i].count;
+  }
+  free(tasks);
+  free(threads);
+  free(started);
+  return fitting;
+}
+
+/*
+  scanThread
+  description
+    thread entry point testing the nodes of a ScanTask.
+  params:
+    argument  the ScanTask being carried out.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+THREAD_RETURN THREAD_CALL scanThread(void* argument)
+{
+  ScanTask* task = (ScanTask*) argument;
+  int i, count = 0;
+
+  for(i = 0; i < task->count; i++)
+  {
+    if(matchQuery(task->nodes[i], task->query)) task->nodes[count++] = task->nodes[i];
+  }
+  task->count = count;
+  return 0;
+}
+
+/*
+  printQuery
+  description
+    prints the plan of a query, then the nodes fitting it.
+  params:
+    tree      tree being queried.
+    query     the query.
+    order     BY_KEY, or a type of search the values sort the
+              results of (see sortKey).
+    limit     the most nodes printed, 0 for all.
+  return:
+    count     the number of nodes printed.
+*/
+int printQuery(TREE* tree, QUERY* query, FIND_BY order, int limit)
+{
+  QUERY_PLAN* plan = planQuery(tree, query, order, limit);
+  NODE** results = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  char* headString = valueBufferA;
+  RENDERER* renderer;
+  int i, count;
+
+  if(results == NULL)
+  {
+    printf("sufficient memory could not be allocated to print query");
+    PAUSE
+    exit(0);
+  }
+  printPlan(tree, plan);
+  count = runQuery(tree, plan, results);
+
+  tree->treeDataPointers->tableHeader(headString);
+  printf("index     %s\n", headString);
+  headString[0] = '\0';
+  renderer = newRenderer(stdout);
+  for(i = 0; i < count; i++) renderNode(results[i], renderer);
+  deleteRenderer(renderer);
+  printf("%d record(s) fit your description, %d were expected.\n\n", count, plan->rows);
+
+  free(results);
+  deletePlan(plan);
+  return count;
+}
+
+#endif
@@ -0,0 +1,902 @@
+#ifndef RADIX_TREE_H
+#define RADIX_TREE_H
+#include"CommonHeader.h"
+#include"Node.h"
+
+//number of compressed path characters held in an inner node, longer
+//paths are checked against a leaf below the node
+#define ART_PREFIX 10
+
+typedef enum ART_TYPE_P ART_TYPE;
+typedef struct ART_NODE_P ART_NODE;
+typedef struct ART_LEAF_P ART_LEAF;
+typedef struct ART_NODE4_P ART_NODE4;
+typedef struct ART_NODE16_P ART_NODE16;
+typedef struct ART_NODE48_P ART_NODE48;
+typedef struct ART_NODE256_P ART_NODE256;
+
+ART_NODE* newArtNode(ART_TYPE type);
+ART_NODE* newArtLeaf(NODE* node);
+int deleteArt(ART_NODE* aNode, int clear);
+
+int insertArt(ART_NODE** ref, NODE* node, int depth);
+  int insertArtLeaf(ART_LEAF* leaf, NODE* node);
+  int splitArtLeaf(ART_NODE** ref, NODE* node, int depth);
+  int splitArtPrefix(ART_NODE** ref, NODE* node, int depth, int mismatch);
+
+int removeArt(ART_NODE** ref, NODE* node, int depth);
+  int removeArtChild(ART_NODE** ref, unsigned char c, ART_NODE** child);
+  int shrinkArtNode(ART_NODE** ref);
+
+int* findArt(ART_NODE* aNode, NODE* node);
+int* searchArt(ART_NODE* aNode, char* key);
+int walkArt(ART_NODE* aNode, int (*visit)(int* ptr_branch, void* context), void* context);
+
+ART_NODE** findArtChild(ART_NODE* aNode, unsigned char c);
+int addArtChild(ART_NODE** ref, unsigned char c, ART_NODE* child);
+ART_LEAF* minimumArt(ART_NODE* aNode);
+int matchArtPrefix(ART_NODE* aNode, char* key, int depth);
+int copyArtHeader(ART_NODE* to, ART_NODE* from);
+int keyByte(char* key, int depth);
+
+/*
+  ART_TYPE
+  description
+    the kinds of node making up an adaptive radix tree, inner
+    nodes are named after the number of children they can hold.
+  data:
+    ART_LEAF_NODE
+                holds the elements with one key.
+    ART_NODE_4  up to 4 children, keys held in order.
+    ART_NODE_16 up to 16 children, keys held in order.
+    ART_NODE_48 up to 48 children, reached through a 256 entry
+                index of key characters.
+    ART_NODE_256
+                a child for every key character.
+*/
+enum ART_TYPE_P
+{
+  ART_LEAF_NODE = 0 ,
+  ART_NODE_4    = 1 ,
+  ART_NODE_16   = 2 ,
+  ART_NODE_48   = 3 ,
+  ART_NODE_256  = 4
+};
+
+/*
+  ART_NODE
+  description
+    header shared by every inner node of an adaptive radix tree.
+    Each level of the tree consumes one character of the key,
+    after first consuming the node's compressed path: the run
+    of characters shared by every key below it.
+  data:
+    type        the kind of node.
+    partial     the first ART_PREFIX characters of the compressed
+                path.
+    partialLength
+                the full length of the compressed path.
+    count       the number of children held.
+*/
+struct ART_NODE_P
+{
+  unsigned char type;
+  unsigned char partial[ART_PREFIX];
+  int partialLength;
+  int count;
+};
+
+/*
+  ART_LEAF
+  description
+    leaf of an adaptive radix tree. Elements which share a key
+    hang from one leaf, linked through their greater branches
+    in order of index.
+  data:
+    type        always ART_LEAF_NODE.
+    node        handle of the first element with the leaf's key
+                (see nodeAt).
+*/
+struct ART_LEAF_P
+{
+  unsigned char type;
+  int node;
+};
+
+struct ART_NODE4_P
+{
+  ART_NODE header;
+  unsigned char keys[4];
+  ART_NODE* children[4];
+};
+
+struct ART_NODE16_P
+{
+  ART_NODE header;
+  unsigned char keys[16];
+  ART_NODE* children[16];
+};
+
+struct ART_NODE48_P
+{
+  ART_NODE header;
+  unsigned char index[256];
+  ART_NODE* children[48];
+};
+
+struct ART_NODE256_P
+{
+  ART_NODE header;
+  ART_NODE* children[256];
+};
+
+/*
+  newArtNode
+  description
+    creates an empty inner node.
+  params:
+    type      the kind of node.
+  return:
+    aNode*    node created
+*/
+ART_NODE* newArtNode(ART_TYPE type)
+{
+  ART_NODE* aNode;
+
+  switch(type)
+  {
+    case ART_NODE_4:    aNode = (ART_NODE*) calloc(1, sizeof(ART_NODE4));   break;
+    case ART_NODE_16:   aNode = (ART_NODE*) calloc(1, sizeof(ART_NODE16));  break;
+    case ART_NODE_48:   aNode = (ART_NODE*) calloc(1, sizeof(ART_NODE48));  break;
+    default:            aNode = (ART_NODE*) calloc(1, sizeof(ART_NODE256)); break;
+  }
+  if(aNode == NULL)
+  {
+    printf("sufficient memory could not be allocated to create radix tree node");
+    PAUSE
+    exit(0);
+  }
+  aNode->type = (unsigned char) type;
+  return aNode;
+}
+
+/*
+  newArtLeaf
+  description
+    creates a leaf holding a single element.
+  params:
+    node      the element.
+  return:
+    aNode*    leaf created
+*/
+ART_NODE* newArtLeaf(NODE* node)
+{
+  ART_LEAF* leaf = (ART_LEAF*) malloc(sizeof(ART_LEAF));
+  if(leaf == NULL)
+  {
+    printf("sufficient memory could not be allocated to create radix tree leaf");
+    PAUSE
+    exit(0);
+  }
+  leaf->type = ART_LEAF_NODE;
+  leaf->node = getHandle(node);
+  setLess(node, NULL);
+  setGreater(node, NULL);
+  return (ART_NODE*) leaf;
+}
+
+/*
+  deleteArt
+  description
+    frees an adaptive radix tree.
+  params:
+    aNode     root of the tree.
+    clear     whether the elements are also deleted.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteArt(ART_NODE* aNode, int clear)
+{
+  NODE *node, *next;
+  int i;
+
+  if(aNode == NULL) return 0;
+  switch(aNode->type)
+  {
+    case ART_LEAF_NODE:
+      for(node = nodeAt(((ART_LEAF*) aNode)->node); clear && node != NULL; node = next)
+      {
+        next = getGreater(node);
+        deleteNode(node, 0);
+      }
+      break;
+    case ART_NODE_4:
+      for(i = 0; i < aNode->count; i++) deleteArt(((ART_NODE4*) aNode)->children[i], clear);
+      break;
+    case ART_NODE_16:
+      for(i = 0; i < aNode->count; i++) deleteArt(((ART_NODE16*) aNode)->children[i], clear);
+      break;
+    case ART_NODE_48:
+      for(i = 0; i < 48; i++) deleteArt(((ART_NODE48*) aNode)->children[i], clear);
+      break;
+    case ART_NODE_256:
+      for(i = 0; i < 256; i++) deleteArt(((ART_NODE256*) aNode)->children[i], clear);
+      break;
+  }
+  free(aNode);
+  return 0;
+}
+
+/*
+  insertArt
+  description
+    adds an element to an adaptive radix tree.
+  params:
+    ref       the slot holding the (sub)tree being added to.
+    node      element being added.
+    depth     the number of key characters already consumed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int insertArt(ART_NODE** ref, NODE* node, int depth)
+{
+  ART_NODE* aNode = *ref;
+  ART_NODE** child;
+  int mismatch;
+
+  while(aNode != NULL && aNode->type != ART_LEAF_NODE)
+  {
+    if(aNode->partialLength)
+    {
+      mismatch = matchArtPrefix(aNode, node->key, depth);
+      if(mismatch < aNode->partialLength) return splitArtPrefix(ref, node, depth, mismatch);
+      depth += aNode->partialLength;
+    }
+
+    child = findArtChild(aNode, (unsigned char) keyByte(node->key, depth));
+    if(child == NULL) return addArtChild(ref, (unsigned char) keyByte(node->key, depth), newArtLeaf(node));
+    ref = child;
+    aNode = *ref;
+    depth++;
+  }
+
+  if(aNode == NULL)
+  {
+    *ref = newArtLeaf(node);
+    return 0;
+  }
+  if(strcmp(nodeAt(((ART_LEAF*) aNode)->node)->key, node->key) == 0)
+  {
+    return insertArtLeaf((ART_LEAF*) aNode, node);
+  }
+  return splitArtLeaf(ref, node, depth);
+}
+
+/*
+  insertArtLeaf
+  description
+    adds an element to a leaf with the same key, keeping the
+    elements of the leaf in order of index.
+  params:
+    leaf      leaf being added to.
+    node      element being added.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int insertArtLeaf(ART_LEAF* leaf, NODE* node)
+{
+  int* ptr_branch = &leaf->node;
+
+  while(*ptr_branch != NODE_NONE && nodeAt(*ptr_branch)->index < node->index) ptr_branch = &nodeAt(*ptr_branch)->greater;
+  setLess(node, NULL);
+  node->greater = *ptr_branch;
+  *ptr_branch = node->handle;
+  return 0;
+}
+
+/*
+  splitArtLeaf
+  description
+    replaces a leaf with an inner node holding both it and a
+    leaf for a new element with a different key. The inner
+    node's compressed path covers the characters the keys share.
+  params:
+    ref       the slot holding the leaf.
+    node      element being added.
+    depth     the number of key characters already consumed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int splitArtLeaf(ART_NODE** ref, NODE* node, int depth)
+{
+  ART_NODE* leaf = *ref;
+  char* key = nodeAt(((ART_LEAF*) leaf)->node)->key;
+  ART_NODE* aNode = newArtNode(ART_NODE_4);
+  int length = 0;
+
+  while(keyByte(key, depth + length) == keyByte(node->key, depth + length)) length++;
+  aNode->partialLength = length;
+  memcpy(aNode->partial, node->key + depth, length < ART_PREFIX ? length : ART_PREFIX);
+
+  *ref = aNode;
+  addArtChild(ref, (unsigned char) keyByte(key, depth + length), leaf);
+  addArtChild(ref, (unsigned char) keyByte(node->key, depth + length), newArtLeaf(node));
+  return 0;
+}
+
+/*
+  splitArtPrefix
+  description
+    places a new inner node above a node whose compressed path
+    the key of a new element leaves part way through.
+  params:
+    ref       the slot holding the node.
+    node      element being added.
+    depth     the number of key characters already consumed.
+    mismatch  the position in the compressed path at which the
+              key differs.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int splitArtPrefix(ART_NODE** ref, NODE* node, int depth, int mismatch)
+{
+  ART_NODE* old = *ref;
+  ART_NODE* aNode = newArtNode(ART_NODE_4);
+  char* key;
+  int length;
+
+  aNode->partialLength = mismatch;
+  memcpy(aNode->partial, old->partial, mismatch < ART_PREFIX ? mismatch : ART_PREFIX);
+  *ref = aNode;
+
+  //the old node keeps what remains of its path after the
+  //character at which it now branches
+  if(old->partialLength <= ART_PREFIX)
+  {
+    addArtChild(ref, old->partial[mismatch], old);
+    old->partialLength -= mismatch + 1;
+    memmove(old->partial, old->partial + mismatch + 1, old->partialLength);
+  }
+  else
+  {
+    key = nodeAt(minimumArt(old)->node)->key;
+    addArtChild(ref, (unsigned char) keyByte(key, depth + mismatch), old);
+    old->partialLength -= mismatch + 1;
+    length = old->partialLength < ART_PREFIX ? old->partialLength : ART_PREFIX;
+    memcpy(old->partial, key + depth + mismatch + 1, length);
+  }
+  addArtChild(ref, (unsigned char) keyByte(node->key, depth + mismatch), newArtLeaf(node));
+  return 0;
+}
+
+/*
+  removeArt
+  description
+    removes an element from an adaptive radix tree. Leaves left
+    empty are removed and inner nodes are shrunk to the smallest
+    kind that holds their children.
+  params:
+    ref       the slot holding the (sub)tree being removed from.
+    node      element being removed.
+    depth     the number of key characters already consumed.
+  return:
+    removed   1 if the element was found and removed, else 0.
+*/
+int removeArt(ART_NODE** ref, NODE* node, int depth)
+{
+  ART_NODE* aNode = *ref;
+  ART_NODE** child;
+  int* ptr_branch;
+  unsigned char c;
+  int removed;
+
+  if(aNode == NULL) return 0;
+  if(aNode->type == ART_LEAF_NODE)
+  {
+    ptr_branch = &((ART_LEAF*) aNode)->node;
+    while(*ptr_branch != NODE_NONE && *ptr_branch != node->handle) ptr_branch = &nodeAt(*ptr_branch)->greater;
+    if(*ptr_branch == NODE_NONE) return 0;
+
+    *ptr_branch = node->greater;
+    setGreater(node, NULL);
+    if(((ART_LEAF*) aNode)->node == NODE_NONE)
+    {
+      free(aNode);
+      *ref = NULL;
+    }
+    return 1;
+  }
+
+  if(aNode->partialLength)
+  {
+    if(matchArtPrefix(aNode, node->key, depth) < aNode->partialLength) return 0;
+    depth += aNode->partialLength;
+  }
+  c = (unsigned char) keyByte(node->key, depth);
+  child = findArtChild(aNode, c);
+  if(child == NULL) return 0;
+
+  removed = removeArt(child, node, depth + 1);
+  if(removed && *child == NULL) removeArtChild(ref, c, child);
+  return removed;
+}
+
+/*
+  removeArtChild
+  description
+    removes an empty child slot from an inner node, shrinking
+    the node if it has become sparse.
+  params:
+    ref       the slot holding the inner node.
+    c         key character of the child.
+    child     the child's slot within the node.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int removeArtChild(ART_NODE** ref, unsigned char c, ART_NODE** child)
+{
+  ART_NODE* aNode = *ref;
+  ART_NODE4* node4;
+  ART_NODE16* node16;
+  int position;
+
+  switch(aNode->type)
+  {
+    case ART_NODE_4:
+      node4 = (ART_NODE4*) aNode;
+      position = (int) (child - node4->children);
+      memmove(node4->keys + position, node4->keys + position + 1, aNode->count - position - 1);
+      memmove(node4->children + position, node4->children + position + 1, (aNode->count - position - 1) * sizeof(ART_NODE*));
+      break;
+    case ART_NODE_16:
+      node16 = (ART_NODE16*) aNode;
+      position = (int) (child - node16->children);
+      memmove(node16->keys + position, node16->keys + position + 1, aNode->count - position - 1);
+      memmove(node16->children + position, node16->children + position + 1, (aNode->count - position - 1) * sizeof(ART_NODE*));
+      break;
+    case ART_NODE_48:
+      ((ART_NODE48*) aNode)->index[c] = 0;
+      break;
+    case ART_NODE_256:
+      break;
+  }
+  aNode->count--;
+  return shrinkArtNode(ref);
+}
+
+/*
+  shrinkArtNode
+  description
+    replaces an inner node with a smaller kind once it holds
+    few enough children, and merges a Node4 left with a single
+    child into that child.
+  params:
+    ref       the slot holding the inner node.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int shrinkArtNode(ART_NODE** ref)
+{
+  ART_NODE* aNode = *ref;
+  ART_NODE* smaller = NULL;
+  ART_NODE* child;
+  int i, count = 0, length;
+
+  if(aNode->type == ART_NODE_4 && aNode->count == 1)
+  {
+    child = ((ART_NODE4*) aNode)->children[0];
+    if(child->type != ART_LEAF_NODE)
+    {
+      //the child's path becomes this node's path, the character
+      //which led to the child, and then the child's own path
+      length = aNode->partialLength;
+      if(length < ART_PREFIX) aNode->partial[length] = ((ART_NODE4*) aNode)->keys[0];
+      length++;
+      if(length < ART_PREFIX)
+      {
+        memcpy(aNode->partial + length, child->partial, (child->partialLength < ART_PREFIX - length) ? child->partialLength : ART_PREFIX - length);
+      }
+      memcpy(child->partial, aNode->partial, ART_PREFIX);
+      child->partialLength += aNode->partialLength + 1;
+    }
+    *ref = child;
+    free(aNode);
+    return 0;
+  }
+
+  if(aNode->type == ART_NODE_16 && aNode->count == 3)
+  {
+    smaller = newArtNode(ART_NODE_4);
+    memcpy(((ART_NODE4*) smaller)->keys, ((ART_NODE16*) aNode)->keys, 3);
+    memcpy(((ART_NODE4*) smaller)->children, ((ART_NODE16*) aNode)->children, 3 * sizeof(ART_NODE*));
+  }
+  else if(aNode->type == ART_NODE_48 && aNode->count == 12)
+  {
+    smaller = newArtNode(ART_NODE_16);
+    for(i = 0; i < 256; i++)
+    {
+      if(((ART_NODE48*) aNode)->index[i] == 0) continue;
+      ((ART_NODE16*) smaller)->keys[count] = (unsigned char) i;
+      ((ART_NODE16*) smaller)->children[count++] = ((ART_NODE48*) aNode)->children[((ART_NODE48*) aNode)->index[i] - 1];
+    }
+  }
+  else if(aNode->type == ART_NODE_256 && aNode->count == 37)
+  {
+    smaller = newArtNode(ART_NODE_48);
+    for(i = 0; i < 256; i++)
+    {
+      if(((ART_NODE256*) aNode)->children[i] == NULL) continue;
+      ((ART_NODE48*) smaller)->children[count] = ((ART_NODE256*) aNode)->children[i];
+      ((ART_NODE48*) smaller)->index[i] = (unsigned char) ++count;
+    }
+  }
+
+  if(smaller != NULL)
+  {
+    copyArtHeader(smaller, aNode);
+    *ref = smaller;
+    free(aNode);
+  }
+  return 0;
+}
+
+/*
+  findArt
+  description
+    finds the slot holding a particular element.
+  params:
+    aNode     root of the tree.
+    node      element being searched for.
+  return:
+    ptr_branch
+              the slot holding the element, or NULL.
+*/
+int* findArt(ART_NODE* aNode, NODE* node)
+{
+  int* ptr_branch = searchArt(aNode, node->key);
+
+  while(ptr_branch != NULL && *ptr_branch != NODE_NONE && *ptr_branch != node->handle) ptr_branch = &nodeAt(*ptr_branch)->greater;
+  return (ptr_branch != NULL && *ptr_branch != NODE_NONE) ? ptr_branch : NULL;
+}
+
+/*
+  searchArt
+  description
+    finds the slot holding the first element with a given key.
+    Compressed paths longer than ART_PREFIX are skipped without
+    being checked, the leaf reached is compared in full instead.
+  params:
+    aNode     root of the tree.
+    key       key being searched for.
+  return:
+    ptr_branch
+              the slot holding the element, or NULL.
+*/
+int* searchArt(ART_NODE* aNode, char* key)
+{
+  ART_NODE** child;
+  int depth = 0, i, length, keyLength = (int) strlen(key);
+
+  while(aNode != NULL)
+  {
+    if(aNode->type == ART_LEAF_NODE)
+    {
+      if(strcmp(nodeAt(((ART_LEAF*) aNode)->node)->key, key) == 0) return &((ART_LEAF*) aNode)->node;
+      return NULL;
+    }
+
+    if(aNode->partialLength)
+    {
+      length = aNode->partialLength < ART_PREFIX ? aNode->partialLength : ART_PREFIX;
+      for(i = 0; i < length; i++)
+      {
+        if(aNode->partial[i] != keyByte(key, depth + i)) return NULL;
+      }
+      depth += aNode->partialLength;
+      if(depth > keyLength) return NULL;
+    }
+
+    child = findArtChild(aNode, (unsigned char) keyByte(key, depth));
+    aNode = child != NULL ? *child : NULL;
+    depth++;
+  }
+  return NULL;
+}
+
+/*
+  walkArt
+  description
+    visits every element of an adaptive radix tree in order.
+  params:
+    aNode     root of the tree.
+    visit     function called with the slot of each element,
+              returning nonzero stops the walk.
+    context   passed on to visit.
+  return:
+    stop      nonzero if the walk was stopped.
+*/
+int walkArt(ART_NODE* aNode, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  int* ptr_branch;
+  ART_NODE* child;
+  int i;
+
+  if(aNode == NULL) return 0;
+  switch(aNode->type)
+  {
+    case ART_LEAF_NODE:
+      for(ptr_branch = &((ART_LEAF*) aNode)->node; *ptr_branch != NODE_NONE; ptr_branch = &nodeAt(*ptr_branch)->greater)
+      {
+        if(visit(ptr_branch, context)) return 1;
+      }
+      return 0;
+    case ART_NODE_4:
+      for(i = 0; i < aNode->count; i++)
+      {
+        if(walkArt(((ART_NODE4*) aNode)->children[i], visit, context)) return 1;
+      }
+      return 0;
+    case ART_NODE_16:
+      for(i = 0; i < aNode->count; i++)
+      {
+        if(walkArt(((ART_NODE16*) aNode)->children[i], visit, context)) return 1;
+      }
+      return 0;
+    case ART_NODE_48:
+      for(i = 0; i < 256; i++)
+      {
+        if(((ART_NODE48*) aNode)->index[i] == 0) continue;
+        child = ((ART_NODE48*) aNode)->children[((ART_NODE48*) aNode)->index[i] - 1];
+        if(walkArt(child, visit, context)) return 1;
+      }
+      return 0;
+    case ART_NODE_256:
+      for(i = 0; i < 256; i++)
+      {
+        if(walkArt(((ART_NODE256*) aNode)->children[i], visit, context)) return 1;
+      }
+      return 0;
+  }
+  return 0;
+}
+
+/*
+  findArtChild
+  description
+    finds the slot of an inner node's child for a key character.
+  params:
+    aNode     inner node being searched.
+    c         the key character.
+  return:
+    child     slot holding the child, or NULL if there is none.
+*/
+ART_NODE** findArtChild(ART_NODE* aNode, unsigned char c)
+{
+  ART_NODE4* node4;
+  ART_NODE16* node16;
+  int i;
+
+  switch(aNode->type)
+  {
+    case ART_NODE_4:
+      node4 = (ART_NODE4*) aNode;
+      for(i = 0; i < aNode->count; i++)
+      {
+        if(node4->keys[i] == c) return &node4->children[i];
+      }
+      return NULL;
+    case ART_NODE_16:
+      node16 = (ART_NODE16*) aNode;
+      for(i = 0; i < aNode->count && node16->keys[i] <= c; i++)
+      {
+        if(node16->keys[i] == c) return &node16->children[i];
+      }
+      return NULL;
+    case ART_NODE_48:
+      i = ((ART_NODE48*) aNode)->index[c];
+      return i ? &((ART_NODE48*) aNode)->children[i - 1] : NULL;
+    case ART_NODE_256:
+      return ((ART_NODE256*) aNode)->children[c] ? &((ART_NODE256*) aNode)->children[c] : NULL;
+  }
+  return NULL;
+}
+
+/*
+  addArtChild
+  description
+    adds a child to an inner node, growing the node into the
+    next larger kind when it is full.
+  params:
+    ref       the slot holding the inner node.
+    c         key character of the child.
+    child     the child being added.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int addArtChild(ART_NODE** ref, unsigned char c, ART_NODE* child)
+{
+  ART_NODE* aNode = *ref;
+  ART_NODE* larger;
+  unsigned char* keys;
+  ART_NODE** children;
+  int i, position, capacity;
+
+  if(aNode->type == ART_NODE_256)
+  {
+    ((ART_NODE256*) aNode)->children[c] = child;
+    aNode->count++;
+    return 0;
+  }
+
+  if(aNode->type == ART_NODE_48)
+  {
+    if(aNode->count < 48)
+    {
+      for(position = 0; ((ART_NODE48*) aNode)->children[position] != NULL; position++);
+      ((ART_NODE48*) aNode)->children[position] = child;
+      ((ART_NODE48*) aNode)->index[c] = (unsigned char) (position + 1);
+      aNode->count++;
+      return 0;
+    }
+    larger = newArtNode(ART_NODE_256);
+    for(i = 0; i < 256; i++)
+    {
+      if(((ART_NODE48*) aNode)->index[i])
+      {
+        ((ART_NODE256*) larger)->children[i] = ((ART_NODE48*) aNode)->children[((ART_NODE48*) aNode)->index[i] - 1];
+      }
+    }
+  }
+  else
+  {
+    if(aNode->type == ART_NODE_4)
+    {
+      keys = ((ART_NODE4*) aNode)->keys;
+      children = ((ART_NODE4*) aNode)->children;
+      capacity = 4;
+    }
+    else
+    {
+      keys = ((ART_NODE16*) aNode)->keys;
+      children = ((ART_NODE16*) aNode)->children;
+      capacity = 16;
+    }
+
+    //Node4 and Node16 keep their keys in order, which is the
+    //order the walk visits them in
+    if(aNode->count < capacity)
+    {
+      for(position = 0; position < aNode->count && keys[position] < c; position++);
+      memmove(keys + position + 1, keys + position, aNode->count - position);
+      memmove(children + position + 1, children + position, (aNode->count - position) * sizeof(ART_NODE*));
+      keys[position] = c;
+      children[position] = child;
+      aNode->count++;
+      return 0;
+    }
+
+    if(aNode->type == ART_NODE_4)
+    {
+      larger = newArtNode(ART_NODE_16);
+      memcpy(((ART_NODE16*) larger)->keys, keys, 4);
+      memcpy(((ART_NODE16*) larger)->children, children, 4 * sizeof(ART_NODE*));
+    }
+    else
+    {
+      larger = newArtNode(ART_NODE_48);
+      for(i = 0; i < 16; i++)
+      {
+        ((ART_NODE48*) larger)->children[i] = children[i];
+        ((ART_NODE48*) larger)->index[keys[i]] = (unsigned char) (i + 1);
+      }
+    }
+  }
+
+  copyArtHeader(larger, aNode);
+  *ref = larger;
+  free(aNode);
+  return addArtChild(ref, c, child);
+}
+
+/*
+  minimumArt
+  description
+    returns the least leaf below a node.
+  params:
+    aNode     node being searched.
+  return:
+    leaf      the least leaf.
+*/
+ART_LEAF* minimumArt(ART_NODE* aNode)
+{
+  int i;
+
+  while(aNode->type != ART_LEAF_NODE)
+  {
+    switch(aNode->type)
+    {
+      case ART_NODE_4:  aNode = ((ART_NODE4*) aNode)->children[0];  break;
+      case ART_NODE_16: aNode = ((ART_NODE16*) aNode)->children[0]; break;
+      case ART_NODE_48:
+        for(i = 0; ((ART_NODE48*) aNode)->index[i] == 0; i++);
+        aNode = ((ART_NODE48*) aNode)->children[((ART_NODE48*) aNode)->index[i] - 1];
+        break;
+      default:
+        for(i = 0; ((ART_NODE256*) aNode)->children[i] == NULL; i++);
+        aNode = ((ART_NODE256*) aNode)->children[i];
+        break;
+    }
+  }
+  return (ART_LEAF*) aNode;
+}
+
+/*
+  matchArtPrefix
+  description
+    compares a key with the compressed path of an inner node,
+    reading the part of the path beyond ART_PREFIX from the
+    least leaf below the node.
+  params:
+    aNode     the inner node.
+    key       key being compared.
+    depth     the number of key characters already consumed.
+  return:
+    length    the number of path characters the key matches.
+*/
+int matchArtPrefix(ART_NODE* aNode, char* key, int depth)
+{
+  char* leafKey;
+  int i, length = aNode->partialLength < ART_PREFIX ? aNode->partialLength : ART_PREFIX;
+
+  for(i = 0; i < length; i++)
+  {
+    if(aNode->partial[i] != keyByte(key, depth + i)) return i;
+  }
+  if(aNode->partialLength > ART_PREFIX)
+  {
+    leafKey = nodeAt(minimumArt(aNode)->node)->key;
+    for(; i < aNode->partialLength; i++)
+    {
+      if(keyByte(leafKey, depth + i) != keyByte(key, depth + i)) return i;
+    }
+  }
+  return i;
+}
+
+/*
+  copyArtHeader
+  description
+    copies the compressed path and child count of an inner
+    node being replaced by one of another kind.
+  params:
+    to        the replacement node.
+    from      the node being replaced.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int copyArtHeader(ART_NODE* to, ART_NODE* from)
+{
+  to->count = from->count;
+  to->partialLength = from->partialLength;
+  memcpy(to->partial, from->partial, ART_PREFIX);
+  return 0;
+}
+
+/*
+  keyByte
+  description
+    returns a character of a key. The terminating '\0' is treated
+    as part of the key, so that no key is the prefix of another
+    and descents never read beyond it.
+  params:
+    key       the key.
+    depth     position of the character.
+  return:
+    c         the character.
+*/
+int keyByte(char* key, int depth)
+{
+  return (unsigned char) key[depth];
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+#include"CommonHeader.h"
+
+//bytes of output gathered before they are written, so that a table
+//is written in a few large writes rather than one for each row
+#define RENDER_BUFFER 65536
+
+typedef struct RENDERER_P RENDERER;
+
+RENDERER* newRenderer(FILE* file);
+int deleteRenderer(RENDERER* renderer);
+int flushRenderer(RENDERER* renderer);
+int renderText(RENDERER* renderer, char* text);
+int renderField(RENDERER* renderer, char* text, int width, char marker);
+int renderNumber(RENDERER* renderer, long long value, int width);
+int renderSpaces(RENDERER* renderer, int count);
+int renderChar(RENDERER* renderer, char c);
+
+/*
+  RENDERER
+  description
+    output being gathered for a file. Text is copied into the
+    buffer by the render functions, which format numbers and
+    fields themselves rather than through printf, and the
+    buffer is written out whenever it fills.
+  data:
+    buffer      the output not yet written.
+    used        the number of bytes of the buffer in use.
+    file        the file the output is written to.
+*/
+struct RENDERER_P
+{
+  char* buffer;
+  int used;
+  FILE* file;
+};
+
+/*
+  newRenderer
+  description
+    creates a renderer writing to a file.
+  params:
+    file      the file written to.
+  return:
+    renderer* renderer created.
+*/
+RENDERER* newRenderer(FILE* file)
+{
+  RENDERER* renderer = (RENDERER*) malloc(sizeof(RENDERER));
+
+  if(renderer != NULL) renderer->buffer = (char*) malloc(RENDER_BUFFER);
+  if(renderer == NULL || renderer->buffer == NULL)
+  {
+    printf("sufficient memory could not be allocated to create renderer");
+    PAUSE
+    exit(0);
+  }
+  renderer->used = 0;
+  renderer->file = file;
+  return renderer;
+}
+
+/*
+  deleteRenderer
+  description
+    writes out what is left of the output and frees a
+    renderer.
+  params:
+    renderer  renderer being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteRenderer(RENDERER* renderer)
+{
+  if(renderer == NULL) return 0;
+  flushRenderer(renderer);
+  free(renderer->buffer);
+  free(renderer);
+  return 0;
+}
+
+/*
+  flushRenderer
+  description
+    writes the output gathered to the file, in one write.
+  params:
+    renderer  renderer being written out.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int flushRenderer(RENDERER* renderer)
+{
+  if(renderer->used > 0) fwrite(renderer->buffer, 1, renderer->used, renderer->file);
+  renderer->used = 0;
+  return 0;
+}
+
+/*
+  renderText
+  description
+    adds a string to the output.
+  params:
+    renderer  renderer being added to.
+    text      the string.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int renderText(RENDERER* renderer, char* text)
+{
+  int length = (int) strlen(text), part;
+
+  while(length > 0)
+  {
+    if(renderer->used == RENDER_BUFFER) flushRenderer(renderer);
+    part = RENDER_BUFFER - renderer->used < length ? RENDER_BUFFER - renderer->used : length;
+    memcpy(renderer->buffer + renderer->used, text, part);
+    renderer->used += part;
+    text += part;
+    length -= part;
+  }
+  return 0;
+}
+
+/*
+  renderField
+  description
+    adds a string to the output in a field of a fixed width,
+    as printf's "%*.*s" would. Shorter strings are padded on
+    the left, longer ones are cut short.
+  params:
+    renderer  renderer being added to.
+    text      the string.
+    width     the width of the field, less than RENDER_BUFFER.
+    marker    written in the last place of the field when the
+              string is cut short, 0 for none.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int renderField(RENDERER* renderer, char* text, int width, char marker)
+{
+  char* out;
+  int length = 0, i;
+
+  //the text is measured only as far as the field reaches
+  while(length < width && text[length] != '\0') length++;
+  if(renderer->used + width > RENDER_BUFFER) flushRenderer(renderer);
+  out = renderer->buffer + renderer->used;
+  for(i = length; i < width; i++) *out++ = ' ';
+  for(i = 0; i < length; i++) *out++ = text[i];
+  if(marker != 0 && length > 0 && text[length] != '\0') out[-1] = marker;
+  renderer->used += width;
+  return 0;
+}
+
+/*
+  renderNumber
+  description
+    adds a number to the output in a field of at least a
+    width, padded on the left, as printf's "%*lld" would.
+  params:
+    renderer  renderer being added to.
+    value     the number.
+    width     the least width of the field, less than
+              RENDER_BUFFER.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int renderNumber(RENDERER* renderer, long long value, int width)
+{
+  char digits[24];
+  unsigned long long magnitude = value < 0 ? 0 - (unsigned long long) value : (unsigned long long) value;
+  int count = 0;
+
+  //the digits are found lowest first, and copied out reversed
+  do
+  {
+    digits[count++] = (char) ('0' + magnitude % 10);
+    magnitude /= 10;
+  } while(magnitude > 0);
+  if(value < 0) digits[count++] = '-';
+
+  if(count < width) renderSpaces(renderer, width - count);
+  if(renderer->used + count > RENDER_BUFFER) flushRenderer(renderer);
+  while(count > 0) renderer->buffer[renderer->used++] = digits[--count];
+  return 0;
+}
+
+/*
+  renderSpaces
+  description
+    adds spaces to the output.
+  params:
+    renderer  renderer being added to.
+    count     the number of spaces.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int renderSpaces(RENDERER* renderer, int count)
+{
+  int part;
+
+  while(count > 0)
+  {
+    if(renderer->used == RENDER_BUFFER) flushRenderer(renderer);
+    part = RENDER_BUFFER - renderer->used < count ? RENDER_BUFFER - renderer->used : count;
+    memset(renderer->buffer + renderer->used, ' ', part);
+    renderer->used += part;
+    count -= part;
+  }
+  return 0;
+}
+
+/*
+  renderChar
+  description
+    adds a character to the output.
+  params:
+    renderer  renderer being added to.
+    c         the character.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int renderChar(RENDERER* renderer, char c)
+{
+  if(renderer->used == RENDER_BUFFER) flushRenderer(renderer);
+  renderer->buffer[renderer->used++] = c;
+  return 0;
+}
+
+#endif
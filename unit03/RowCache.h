@@ -0,0 +1,167 @@
+#ifndef ROW_CACHE_H
+#define ROW_CACHE_H
+#include"CommonHeader.h"
+#include"Thread.h"
+
+//bytes held for each row, enough for the shortened string of a
+//contact (see contactToString) and its terminator
+#define ROW_SIZE 48
+//rows are handed out of blocks of 1 << ROW_BLOCK_BITS, a row's
+//handle holds its block in the upper bits and its slot in the lower
+#define ROW_BLOCK_BITS 10
+#define ROW_BLOCK_SIZE (1 << ROW_BLOCK_BITS)
+#define ROW_BLOCK_LIMIT 16384
+//handle of no row, so that zeroed memory holds none
+#define ROW_NONE 0
+
+typedef struct ROW_CACHE_P ROW_CACHE;
+
+ROW_CACHE* getRowCache(void);
+int newRow(void);
+int freeRow(int row);
+char* rowText(int row);
+
+/*
+  ROW_CACHE
+  description
+    rows of a table kept formatted between printings, each
+    held in a slot of ROW_SIZE bytes. Slots are cut one after
+    another from large blocks and reused once freed, so that
+    rows printed one after another are mostly read from
+    memory one after another.
+  data:
+    blocks      every block cut, indexed by the upper bits of
+                a handle.
+    blockCount  the number of blocks cut.
+    used        the number of slots of the last block cut which
+                have been handed out.
+    free        handle of the first freed row, whose slot holds
+                the handle of the next, ROW_NONE if there is none.
+    count       the number of rows in use.
+    lock        held while a row is taken or freed.
+*/
+struct ROW_CACHE_P
+{
+  char* blocks[ROW_BLOCK_LIMIT];
+  int blockCount;
+  int used;
+  int free;
+  int count;
+  MUTEX lock;
+};
+
+//cache every row is held in, created by getRowCache the first
+//time it is needed
+ROW_CACHE* rowCache = NULL;
+
+/*
+  getRowCache
+  description
+    returns the row cache, creating it if it does not yet
+    exist.
+  params:
+    void
+  return:
+    cache     the row cache.
+*/
+ROW_CACHE* getRowCache(void)
+{
+  ROW_CACHE* cache;
+
+  if(rowCache != NULL) return rowCache;
+  cache = (ROW_CACHE*) calloc(1, sizeof(ROW_CACHE));
+  if(cache == NULL)
+  {
+    printf("sufficient memory could not be allocated to create row cache");
+    PAUSE
+    exit(0);
+  }
+  //the first slot is never handed out, so that no row has the
+  //handle ROW_NONE
+  cache->used = 1;
+  cache->free = ROW_NONE;
+  initMutex(&cache->lock);
+  rowCache = cache;
+  return rowCache;
+}
+
+/*
+  newRow
+  description
+    takes a row from the cache, a freed one if there is one.
+  params:
+    void
+  return:
+    row       handle of the row, whose text is unset.
+*/
+int newRow(void)
+{
+  ROW_CACHE* cache = getRowCache();
+  char* block;
+  int row;
+
+  lockMutex(&cache->lock);
+  if(cache->free != ROW_NONE)
+  {
+    row = cache->free;
+    cache->free = *((int*) rowText(row));
+  }
+  else
+  {
+    if(cache->blockCount == 0 || cache->used == ROW_BLOCK_SIZE)
+    {
+      //the block is only stored once it is known to fit the table
+      block = cache->blockCount < ROW_BLOCK_LIMIT ? (char*) malloc(ROW_BLOCK_SIZE * ROW_SIZE) : NULL;
+      if(block == NULL)
+      {
+        printf("sufficient memory could not be allocated to cache row");
+        PAUSE
+        exit(0);
+      }
+      if(cache->blockCount > 0) cache->used = 0;
+      cache->blocks[cache->blockCount++] = block;
+    }
+    row = ((cache->blockCount - 1) << ROW_BLOCK_BITS) | cache->used++;
+  }
+  cache->count++;
+  unlockMutex(&cache->lock);
+  return row;
+}
+
+/*
+  freeRow
+  description
+    returns a row to the cache to be reused.
+  params:
+    row       handle of the row, ROW_NONE is ignored.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int freeRow(int row)
+{
+  ROW_CACHE* cache = getRowCache();
+
+  if(row == ROW_NONE) return 0;
+  lockMutex(&cache->lock);
+  *((int*) rowText(row)) = cache->free;
+  cache->free = row;
+  cache->count--;
+  unlockMutex(&cache->lock);
+  return 0;
+}
+
+/*
+  rowText
+  description
+    returns the text of a row.
+  params:
+    row       handle of the row.
+  return:
+    text      the ROW_SIZE bytes the row is held in.
+*/
+char* rowText(int row)
+{
+  return rowCache->blocks[row >> ROW_BLOCK_BITS] + (row & (ROW_BLOCK_SIZE - 1)) * ROW_SIZE;
+}
+
+#endif
@@ -0,0 +1,435 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+#include"CommonHeader.h"
+#include"Node.h"
+#include"Thread.h"
+
+//maximum height of a tower, enough for 2^24 elements
+#define SKIP_LEVELS 24
+
+//the lowest bit of a next pointer marks the tower holding it as
+//removed, so that no thread links a new tower in behind it
+#define SKIP_MARKED(pointer) ((size_t) (pointer) & 1)
+#define SKIP_MARK(pointer) ((SKIP_NODE*) ((size_t) (pointer) | 1))
+#define SKIP_UNMARK(pointer) ((SKIP_NODE*) ((size_t) (pointer) & ~((size_t) 1)))
+
+typedef struct SKIP_NODE_P SKIP_NODE;
+typedef struct SKIP_LIST_P SKIP_LIST;
+
+SKIP_LIST* newSkipList(void);
+SKIP_NODE* newSkipNode(NODE* node, int level);
+int deleteSkipList(SKIP_LIST* list, int clear);
+
+int insertSkipList(SKIP_LIST* list, NODE* node);
+int removeSkipList(SKIP_LIST* list, SKIP_NODE* victim);
+int* findSkipList(SKIP_LIST* list, NODE* node);
+int* searchSkipList(SKIP_LIST* list, char* key);
+int walkSkipList(SKIP_LIST* list, int (*visit)(int* ptr_branch, void* context), void* context);
+
+int locateSkipList(SKIP_LIST* list, char* key, int index, SKIP_NODE** preds, SKIP_NODE** succs);
+int compareSkipNode(SKIP_NODE* skipNode, char* key, int index);
+int skipLevel(SKIP_LIST* list);
+
+/*
+  SKIP_NODE
+  description
+    tower of a lock free skip list. Each element is held in one
+    tower, linked into the lists of the levels below its height.
+    Towers keep their own copy of the element's key and index so
+    that threads passing through never touch the element itself.
+  data:
+    element     handle of the element held (see nodeAt), first
+                so that the slot holding it is also the address
+                of the tower.
+    retired     next tower in the list of removed towers.
+    index       index of the element.
+    level       height of the tower.
+    key         copy of the element's key, held after next.
+    next        the following tower on each level (possibly
+                marked), allocated to the height of the tower.
+*/
+struct SKIP_NODE_P
+{
+  int element;
+  SKIP_NODE* retired;
+  int index;
+  int level;
+  char* key;
+  SKIP_NODE* volatile next[1];
+};
+
+/*
+  SKIP_LIST
+  description
+    lock free skip list ordered by key and index. Elements are
+    added and removed with compare and swap operations, so any
+    number of threads may add and remove at once. Removed towers
+    stay readable by threads still passing through them until
+    the list is deleted.
+  data:
+    head        tower of full height ahead of every element.
+    retired     towers removed from the list.
+    seed        counter from which tower heights are drawn.
+*/
+struct SKIP_LIST_P
+{
+  SKIP_NODE* head;
+  SKIP_NODE* volatile retired;
+  int volatile seed;
+};
+
+/*
+  newSkipList
+  description
+    creates an empty skip list.
+  params:
+    void
+  return:
+    list*     list created
+*/
+SKIP_LIST* newSkipList(void)
+{
+  SKIP_LIST* list = (SKIP_LIST*) malloc(sizeof(SKIP_LIST));
+  int i;
+
+  if(list == NULL)
+  {
+    printf("sufficient memory could not be allocated to create skip list");
+    PAUSE
+    exit(0);
+  }
+  list->head = newSkipNode(NULL, SKIP_LEVELS);
+  for(i = 0; i < SKIP_LEVELS; i++) list->head->next[i] = NULL;
+  list->retired = NULL;
+  list->seed = 0;
+  return list;
+}
+
+/*
+  newSkipNode
+  description
+    creates a tower for an element.
+  params:
+    node      the element (NULL for the head).
+    level     height of the tower.
+  return:
+    skipNode* tower created
+*/
+SKIP_NODE* newSkipNode(NODE* node, int level)
+{
+  size_t keySize = node != NULL ? strlen(node->key) + 1 : 1;
+  SKIP_NODE* skipNode = (SKIP_NODE*) malloc(sizeof(SKIP_NODE) + (level - 1) * sizeof(SKIP_NODE*) + keySize);
+
+  if(skipNode == NULL)
+  {
+    printf("sufficient memory could not be allocated to create skip list node");
+    PAUSE
+    exit(0);
+  }
+  skipNode->element = getHandle(node);
+  skipNode->retired = NULL;
+  skipNode->index = node != NULL ? node->index : 0;
+  skipNode->level = level;
+  skipNode->key = (char*) &skipNode->next[level];
+  memcpy(skipNode->key, node != NULL ? node->key : "", keySize);
+  return skipNode;
+}
+
+/*
+  deleteSkipList
+  description
+    frees a skip list along with every tower removed from it.
+    No other thread may be using the list.
+  params:
+    list      list being freed.
+    clear     whether the elements still held are also deleted.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteSkipList(SKIP_LIST* list, int clear)
+{
+  SKIP_NODE *skipNode, *next;
+
+  if(list == NULL) return 0;
+  for(skipNode = SKIP_UNMARK(list->head->next[0]); skipNode != NULL; skipNode = next)
+  {
+    next = SKIP_UNMARK(skipNode->next[0]);
+    if(!SKIP_MARKED(skipNode->next[0]))
+    {
+      if(clear) deleteNode(nodeAt(skipNode->element), 0);
+      free(skipNode);
+    }
+  }
+  for(skipNode = list->retired; skipNode != NULL; skipNode = next)
+  {
+    next = skipNode->retired;
+    free(skipNode);
+  }
+  free(list->head);
+  free(list);
+  return 0;
+}
+
+/*
+  insertSkipList
+  description
+    adds an element to a skip list. The tower is made visible
+    by linking it into the lowest level, then linked into each
+    higher level in turn.
+  params:
+    list      list being added to.
+    node      element being added.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int insertSkipList(SKIP_LIST* list, NODE* node)
+{
+  SKIP_NODE *preds[SKIP_LEVELS], *succs[SKIP_LEVELS];
+  SKIP_NODE *skipNode, *next;
+  int level, i;
+
+  setLess(node, NULL);
+  setGreater(node, NULL);
+  skipNode = newSkipNode(node, skipLevel(list));
+  do
+  {
+    locateSkipList(list, skipNode->key, skipNode->index, preds, succs);
+    for(i = 0; i < skipNode->level; i++) skipNode->next[i] = succs[i];
+  }
+  while(!compareAndSwap((void* volatile*) &preds[0]->next[0], succs[0], skipNode));
+
+  for(level = 1; level < skipNode->level; level++)
+  {
+    while(!compareAndSwap((void* volatile*) &preds[level]->next[level], succs[level], skipNode))
+    {
+      locateSkipList(list, skipNode->key, skipNode->index, preds, succs);
+
+      //the tower must point past anything linked in ahead of it,
+      //unless it has already been removed
+      next = skipNode->next[level];
+      if(SKIP_MARKED(next)) return 0;
+      if(next != succs[level] && !compareAndSwap((void* volatile*) &skipNode->next[level], next, succs[level])) return 0;
+    }
+  }
+  return 0;
+}
+
+/*
+  removeSkipList
+  description
+    removes a tower from a skip list. The tower is marked from
+    the top level down, the thread marking the lowest level
+    owns the removal and unlinks the tower from every level.
+  params:
+    list      list being removed from.
+    victim    tower being removed.
+  return:
+    removed   1 if this call removed the tower, 0 if another
+              thread already had.
+*/
+int removeSkipList(SKIP_LIST* list, SKIP_NODE* victim)
+{
+  SKIP_NODE *preds[SKIP_LEVELS], *succs[SKIP_LEVELS];
+  SKIP_NODE* next;
+  int level;
+
+  for(level = victim->level - 1; level > 0; level--)
+  {
+    next = victim->next[level];
+    while(!SKIP_MARKED(next))
+    {
+      compareAndSwap((void* volatile*) &victim->next[level], next, SKIP_MARK(next));
+      next = victim->next[level];
+    }
+  }
+
+  while(1)
+  {
+    next = victim->next[0];
+    if(SKIP_MARKED(next)) return 0;
+    if(compareAndSwap((void* volatile*) &victim->next[0], next, SKIP_MARK(next))) break;
+  }
+
+  //locating the tower unlinks it, after which it is retired
+  locateSkipList(list, victim->key, victim->index, preds, succs);
+  do
+  {
+    victim->retired = list->retired;
+  }
+  while(!compareAndSwap((void* volatile*) &list->retired, victim->retired, victim));
+  return 1;
+}
+
+/*
+  findSkipList
+  description
+    finds the slot holding a particular element.
+  params:
+    list      list being searched.
+    node      element being searched for.
+  return:
+    ptr_branch
+              the slot holding the element, or NULL.
+*/
+int* findSkipList(SKIP_LIST* list, NODE* node)
+{
+  SKIP_NODE *preds[SKIP_LEVELS], *succs[SKIP_LEVELS];
+
+  if(!locateSkipList(list, node->key, node->index, preds, succs)) return NULL;
+  return succs[0]->element == node->handle ? &succs[0]->element : NULL;
+}
+
+/*
+  searchSkipList
+  description
+    finds the slot holding the first element with a given key.
+  params:
+    list      list being searched.
+    key       key being searched for.
+  return:
+    ptr_branch
+              the slot holding the element, or NULL.
+*/
+int* searchSkipList(SKIP_LIST* list, char* key)
+{
+  SKIP_NODE *preds[SKIP_LEVELS], *succs[SKIP_LEVELS];
+
+  //no index is below INT_MIN + 1, so the first tower at or
+  //after this position is the first with the key
+  locateSkipList(list, key, -0x7FFFFFFF, preds, succs);
+  if(succs[0] == NULL || strcmp(succs[0]->key, key) != 0) return NULL;
+  return &succs[0]->element;
+}
+
+/*
+  walkSkipList
+  description
+    visits every element of a skip list in order. Elements
+    added or removed by other threads during the walk may or
+    may not be visited.
+  params:
+    list      list being walked.
+    visit     function called with the slot of each element,
+              returning nonzero stops the walk.
+    context   passed on to visit.
+  return:
+    stop      nonzero if the walk was stopped.
+*/
+int walkSkipList(SKIP_LIST* list, int (*visit)(int* ptr_branch, void* context), void* context)
+{
+  SKIP_NODE* skipNode;
+  SKIP_NODE* next;
+
+  for(skipNode = SKIP_UNMARK(list->head->next[0]); skipNode != NULL; skipNode = SKIP_UNMARK(next))
+  {
+    next = skipNode->next[0];
+    if(!SKIP_MARKED(next) && visit(&skipNode->element, context)) return 1;
+  }
+  return 0;
+}
+
+/*
+  locateSkipList
+  description
+    finds, on every level, the last tower before a position and
+    the first tower at or after it. Marked towers met on the
+    way are unlinked, the search restarts if another thread
+    changes a link first.
+  params:
+    list      list being searched.
+    key       key of the position.
+    index     index of the position.
+    preds     filled with the tower before the position on
+              each level.
+    succs     filled with the tower at or after the position
+              on each level (NULL at the end of the list).
+  return:
+    found     1 if succs[0] is at the position.
+*/
+int locateSkipList(SKIP_LIST* list, char* key, int index, SKIP_NODE** preds, SKIP_NODE** succs)
+{
+  SKIP_NODE *pred, *curr, *succ;
+  int level, restart;
+
+  do
+  {
+    restart = 0;
+    pred = list->head;
+    for(level = SKIP_LEVELS - 1; level >= 0 && !restart; level--)
+    {
+      curr = SKIP_UNMARK(pred->next[level]);
+      while(curr != NULL)
+      {
+        succ = curr->next[level];
+        if(SKIP_MARKED(succ))
+        {
+          if(!compareAndSwap((void* volatile*) &pred->next[level], curr, SKIP_UNMARK(succ)))
+          {
+            restart = 1;
+            break;
+          }
+          curr = SKIP_UNMARK(succ);
+          continue;
+        }
+        if(compareSkipNode(curr, key, index) >= 0) break;
+        pred = curr;
+        curr = SKIP_UNMARK(succ);
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+  }
+  while(restart);
+
+  return succs[0] != NULL && compareSkipNode(succs[0], key, index) == 0;
+}
+
+/*
+  compareSkipNode
+  description
+    compares a tower with a position.
+  params:
+    skipNode  the tower.
+    key       key of the position.
+    index     index of the position.
+  return:
+    comparison
+              the ordinal comparison of key then index.
+*/
+int compareSkipNode(SKIP_NODE* skipNode, char* key, int index)
+{
+  int compare = strcmp(skipNode->key, key);
+  if(compare) return compare;
+  return skipNode->index < index ? -1 : skipNode->index > index;
+}
+
+/*
+  skipLevel
+  description
+    draws the height of a new tower, each level above the first
+    being half as likely as the last.
+  params:
+    list      list the tower is for.
+  return:
+    level     height of the tower.
+*/
+int skipLevel(SKIP_LIST* list)
+{
+  unsigned int bits = (unsigned int) atomicAdd(&list->seed, 1);
+  int level = 1;
+
+  //scramble the counter so that consecutive towers differ
+  bits = (bits ^ 61) ^ (bits >> 16);
+  bits *= 9;
+  bits ^= bits >> 4;
+  bits *= 0x27d4eb2d;
+  bits ^= bits >> 15;
+  while((bits & 1) && level < SKIP_LEVELS)
+  {
+    level++;
+    bits >>= 1;
+  }
+  return level;
+}
+
+#endif
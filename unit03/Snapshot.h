@@ -0,0 +1,160 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include"CommonHeader.h"
+#include"Node.h"
+#include"StringKernels.h"
+
+//number of leading key characters held alongside each node
+#define PREFIX_SIZE 16
+
+typedef struct SNAPSHOT_P SNAPSHOT;
+
+SNAPSHOT* newSnapshot(NODE** nodes, int size);
+int fillSnapshot(SNAPSHOT* snapshot, NODE** nodes, int* next, int position);
+int deleteSnapshot(SNAPSHOT* snapshot);
+NODE* findSnapshot(SNAPSHOT* snapshot, char* key);
+
+/*
+  SNAPSHOT
+  description
+    read only copy of the order of a tree, laid out in a single
+    array in breadth first (Eytzinger) order. The children of
+    position k are found at 2k and 2k+1, so a search walks
+    forward through one array and the positions it will need
+    next can be prefetched.
+  data:
+    nodes       the nodes of the tree in breadth first order,
+                position 0 is unused.
+    prefix      the first PREFIX_SIZE characters of each node's
+                key, zero padded, in the same order.
+    size        the number of nodes held.
+*/
+struct SNAPSHOT_P
+{
+  NODE** nodes;
+  char (*prefix)[PREFIX_SIZE];
+  int size;
+};
+
+/*
+  newSnapshot
+  description
+    creates a snapshot from an ordered array of nodes.
+  params:
+    nodes     the nodes of a tree in order.
+    size      the number of nodes.
+  return:
+    snapshot* snapshot created
+*/
+SNAPSHOT* newSnapshot(NODE** nodes, int size)
+{
+  SNAPSHOT* snapshot = (SNAPSHOT*) malloc(sizeof(SNAPSHOT));
+  int next = 0;
+
+  if(snapshot != NULL)
+  {
+    snapshot->nodes = (NODE**) malloc((size + 1) * sizeof(NODE*));
+    snapshot->prefix = (char (*)[PREFIX_SIZE]) calloc(size + 1, PREFIX_SIZE);
+  }
+  if(snapshot == NULL || snapshot->nodes == NULL || snapshot->prefix == NULL)
+  {
+    printf("sufficient memory could not be allocated to create snapshot");
+    PAUSE
+    exit(0);
+  }
+  snapshot->size = size;
+  snapshot->nodes[0] = NULL;
+  fillSnapshot(snapshot, nodes, &next, 1);
+  return snapshot;
+}
+
+/*
+  fillSnapshot
+  description
+    places ordered nodes at their breadth first positions.
+  params:
+    snapshot  snapshot being filled.
+    nodes     the nodes of a tree in order.
+    next      the position of the next unplaced node in nodes.
+    position  the breadth first position being filled.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int fillSnapshot(SNAPSHOT* snapshot, NODE** nodes, int* next, int position)
+{
+  size_t length;
+
+  if(position > snapshot->size) return 0;
+
+  fillSnapshot(snapshot, nodes, next, 2 * position);
+  snapshot->nodes[position] = nodes[(*next)++];
+  //the prefixes are zeroed when allocated, so shorter keys are 
+  //left zero padded
+  length = strlen(snapshot->nodes[position]->key);
+  memcpy(snapshot->prefix[position], snapshot->nodes[position]->key, length < PREFIX_SIZE ? length : PREFIX_SIZE);
+  fillSnapshot(snapshot, nodes, next, 2 * position + 1);
+  return 0;
+}
+
+/*
+  deleteSnapshot
+  description
+    frees a snapshot (but not the nodes it refers to).
+  params:
+    snapshot  snapshot being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteSnapshot(SNAPSHOT* snapshot)
+{
+  if(snapshot != NULL)
+  {
+    free(snapshot->nodes);
+    free(snapshot->prefix);
+    free(snapshot);
+  }
+  return 0;
+}
+
+/*
+  findSnapshot
+  description
+    finds a node by key. Each step moves to 2k or 2k+1 by
+    adding the comparison result rather than by branching on
+    it, and the block of positions four levels below is 
+    prefetched. Prefixes are compared by the string kernels
+    (see getStringKernels), full keys only when the prefixes
+    are equal.
+  params:
+    snapshot  snapshot being searched.
+    key       key being searched for.
+  return:
+    node      a node with the key, or NULL if none exists.
+*/
+NODE* findSnapshot(SNAPSHOT* snapshot, char* key)
+{
+  STRING_KERNELS* kernels = getStringKernels();
+  char target[PREFIX_SIZE];
+  size_t length = strlen(key);
+  int position = 1, compare;
+
+  memset(target, 0, PREFIX_SIZE);
+  memcpy(target, key, length < PREFIX_SIZE ? length : PREFIX_SIZE);
+  while(position <= snapshot->size)
+  {
+    PREFETCH(snapshot->prefix + 16 * position);
+    compare = kernels->compareFixed(snapshot->prefix[position], target, PREFIX_SIZE);
+    if(compare == 0) compare = strcmp(snapshot->nodes[position]->key, key);
+    position = 2 * position + (compare < 0);
+  }
+
+  //the last step to the left marks the first key not less than
+  //the target, it is found by dropping the trailing right steps
+  while(position & 1) position >>= 1;
+  position >>= 1;
+
+  if(position == 0 || strcmp(snapshot->nodes[position]->key, key) != 0) return NULL;
+  return snapshot->nodes[position];
+}
+
+#endif
@@ -0,0 +1,335 @@
+#ifndef STRING_KERNELS_H
+#define STRING_KERNELS_H
+#include"CommonHeader.h"
+
+//SSE2 is used where the compiler may assume it (every x64
+//processor has it), AVX2 only where the compiler can target it
+//for a single function and the processor is found to support it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include<emmintrin.h>
+  #define KERNEL_SSE2
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+  && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+  #include<immintrin.h>
+  #define KERNEL_AVX2
+  #define AVX2_FUNCTION __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && _MSC_VER >= 1700 && (defined(_M_X64) || defined(_M_IX86))
+  #include<immintrin.h>
+  #include<intrin.h>
+  #define KERNEL_AVX2
+  #define AVX2_FUNCTION
+#endif
+
+typedef struct STRING_KERNELS_P STRING_KERNELS;
+
+STRING_KERNELS* getStringKernels(void);
+int lowestBit(unsigned int mask);
+
+int compareFixedScalar(const char* a, const char* b, int width);
+int compareStringScalar(const char* a, const char* b, int size);
+#ifdef KERNEL_SSE2
+int compareFixedSse2(const char* a, const char* b, int width);
+int compareStringSse2(const char* a, const char* b, int size);
+#endif
+#ifdef KERNEL_AVX2
+int avx2Supported(void);
+int compareFixedAvx2(const char* a, const char* b, int width);
+int compareStringAvx2(const char* a, const char* b, int size);
+#endif
+
+/*
+  STRING_KERNELS
+  description
+    string comparisons written for one instruction set. Each
+    compares a and b as strcmp would, returning the difference
+    between the first pair of bytes which differ.
+  data:
+    name        name of the instruction set.
+    compareFixed
+                compares two strings held in buffers of a fixed
+                width, zero padded after their terminators.
+                  param   -first buffer
+                          -second buffer
+                          -width of both buffers
+                  return  -ordinal comparison
+    compareString
+                compares two terminated strings held in buffers
+                of a known size, which may hold anything after
+                their terminators.
+                  param   -first buffer
+                          -second buffer
+                          -size of both buffers
+                  return  -ordinal comparison
+*/
+struct STRING_KERNELS_P
+{
+  char* name;
+  int (*compareFixed)(const char* a, const char* b, int width);
+  int (*compareString)(const char* a, const char* b, int size);
+};
+
+//kernels of each instruction set
+STRING_KERNELS scalarKernels = {"scalar", &compareFixedScalar, &compareStringScalar};
+#ifdef KERNEL_SSE2
+STRING_KERNELS sse2Kernels = {"sse2", &compareFixedSse2, &compareStringSse2};
+#endif
+#ifdef KERNEL_AVX2
+STRING_KERNELS avx2Kernels = {"avx2", &compareFixedAvx2, &compareStringAvx2};
+#endif
+
+//kernels in use, chosen by getStringKernels the first time they
+//are needed
+STRING_KERNELS* stringKernels = NULL;
+
+/*
+  getStringKernels
+  description
+    returns the kernels of the widest instruction set the
+    processor supports.
+  params:
+    void
+  return:
+    kernels   the kernels in use.
+*/
+STRING_KERNELS* getStringKernels(void)
+{
+  if(stringKernels != NULL) return stringKernels;
+  stringKernels = &scalarKernels;
+#ifdef KERNEL_SSE2
+  stringKernels = &sse2Kernels;
+#endif
+#ifdef KERNEL_AVX2
+  if(avx2Supported()) stringKernels = &avx2Kernels;
+#endif
+  return stringKernels;
+}
+
+/*
+  lowestBit
+  description
+    finds the lowest bit set in a mask.
+  params:
+    mask      a mask with at least one bit set.
+  return:
+    bit       position of the lowest bit set.
+*/
+int lowestBit(unsigned int mask)
+{
+#if defined(__GNUC__)
+  return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+  unsigned long bit;
+  _BitScanForward(&bit, mask);
+  return (int) bit;
+#else
+  int bit = 0;
+  while(!(mask & 1))
+  {
+    mask >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/*
+  compareFixedScalar
+  description
+    compareFixed one byte at a time.
+  params:
+    a         first buffer.
+    b         second buffer.
+    width     width of both buffers.
+  return:
+    comparison
+              the ordinal comparison of the strings.
+*/
+int compareFixedScalar(const char* a, const char* b, int width)
+{
+  int i;
+  for(i = 0; i < width; i++)
+  {
+    if(a[i] != b[i]) return (unsigned char) a[i] - (unsigned char) b[i];
+  }
+  return 0;
+}
+
+/*
+  compareStringScalar
+  description
+    compareString one byte at a time.
+  params:
+    a         first buffer.
+    b         second buffer.
+    size      size of both buffers.
+  return:
+    comparison
+              the ordinal comparison of the strings.
+*/
+int compareStringScalar(const char* a, const char* b, int size)
+{
+  int i;
+  for(i = 0; i < size; i++)
+  {
+    if(a[i] != b[i] || a[i] == '\0') return (unsigned char) a[i] - (unsigned char) b[i];
+  }
+  return 0;
+}
+
+#ifdef KERNEL_SSE2
+/*
+  compareFixedSse2
+  description
+    compareFixed 16 bytes at a time.
+  params:
+    a         first buffer.
+    b         second buffer.
+    width     width of both buffers.
+  return:
+    comparison
+              the ordinal comparison of the strings.
+*/
+int compareFixedSse2(const char* a, const char* b, int width)
+{
+  unsigned int mask;
+  int i, bit;
+
+  for(i = 0; i + 16 <= width; i += 16)
+  {
+    //a bit is set for each byte which differs
+    mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i*) (a + i)),
+                                             _mm_loadu_si128((__m128i*) (b + i)))) & 0xFFFF;
+    if(mask != 0)
+    {
+      bit = i + lowestBit(mask);
+      return (unsigned char) a[bit] - (unsigned char) b[bit];
+    }
+  }
+  return compareFixedScalar(a + i, b + i, width - i);
+}
+
+/*
+  compareStringSse2
+  description
+    compareString 16 bytes at a time.
+  params:
+    a         first buffer.
+    b         second buffer.
+    size      size of both buffers.
+  return:
+    comparison
+              the ordinal comparison of the strings.
+*/
+int compareStringSse2(const char* a, const char* b, int size)
+{
+  __m128i left, zero = _mm_setzero_si128();
+  unsigned int mask;
+  int i, bit;
+
+  for(i = 0; i + 16 <= size; i += 16)
+  {
+    //a bit is set for each byte which differs or ends a
+    left = _mm_loadu_si128((__m128i*) (a + i));
+    mask = (~_mm_movemask_epi8(_mm_cmpeq_epi8(left, _mm_loadu_si128((__m128i*) (b + i)))) & 0xFFFF)
+         | _mm_movemask_epi8(_mm_cmpeq_epi8(left, zero));
+    if(mask != 0)
+    {
+      bit = i + lowestBit(mask);
+      return (unsigned char) a[bit] - (unsigned char) b[bit];
+    }
+  }
+  return compareStringScalar(a + i, b + i, size - i);
+}
+#endif
+
+#ifdef KERNEL_AVX2
+/*
+  avx2Supported
+  description
+    tests whether the processor, and operating system, support
+    AVX2.
+  params:
+    void
+  return:
+    supported 1 if AVX2 may be used, otherwise 0.
+*/
+int avx2Supported(void)
+{
+#if defined(__GNUC__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#else
+  int info[4];
+  __cpuid(info, 1);
+  //the operating system must save the ymm registers (OSXSAVE)
+  if(!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6) return 0;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#endif
+}
+
+/*
+  compareFixedAvx2
+  description
+    compareFixed 32 bytes at a time.
+  params:
+    a         first buffer.
+    b         second buffer.
+    width     width of both buffers.
+  return:
+    comparison
+              the ordinal comparison of the strings.
+*/
+AVX2_FUNCTION int compareFixedAvx2(const char* a, const char* b, int width)
+{
+  unsigned int mask;
+  int i, bit;
+
+  for(i = 0; i + 32 <= width; i += 32)
+  {
+    mask = ~(unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*) (a + i)),
+                                                                  _mm256_loadu_si256((__m256i*) (b + i))));
+    if(mask != 0)
+    {
+      bit = i + lowestBit(mask);
+      return (unsigned char) a[bit] - (unsigned char) b[bit];
+    }
+  }
+  return compareFixedScalar(a + i, b + i, width - i);
+}
+
+/*
+  compareStringAvx2
+  description
+    compareString 32 bytes at a time.
+  params:
+    a         first buffer.
+    b         second buffer.
+    size      size of both buffers.
+  return:
+    comparison
+              the ordinal comparison of the strings.
+*/
+AVX2_FUNCTION int compareStringAvx2(const char* a, const char* b, int size)
+{
+  __m256i left, zero = _mm256_setzero_si256();
+  unsigned int mask;
+  int i, bit;
+
+  for(i = 0; i + 32 <= size; i += 32)
+  {
+    left = _mm256_loadu_si256((__m256i*) (a + i));
+    mask = ~(unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(left, _mm256_loadu_si256((__m256i*) (b + i))))
+         | (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(left, zero));
+    if(mask != 0)
+    {
+      bit = i + lowestBit(mask);
+      return (unsigned char) a[bit] - (unsigned char) b[bit];
+    }
+  }
+  return compareStringScalar(a + i, b + i, size - i);
+}
+#endif
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef THREAD_H
+#define THREAD_H
+#include"CommonHeader.h"
+
+//thin wrappers over the native thread api so that the tree
+//code does not need to know which platform it is running on
+#ifdef _WIN32
+  #include<windows.h>
+  typedef HANDLE THREAD;
+  typedef CRITICAL_SECTION MUTEX;
+  typedef DWORD THREAD_RETURN;
+  #define THREAD_CALL WINAPI
+#else
+  #include<pthread.h>
+  #include<unistd.h>
+  #include<time.h>
+  typedef pthread_t THREAD;
+  typedef pthread_mutex_t MUTEX;
+  typedef void* THREAD_RETURN;
+  #define THREAD_CALL
+#endif
+
+typedef THREAD_RETURN (THREAD_CALL *THREAD_FUNCTION)(void* argument);
+
+int startThread(THREAD* thread, THREAD_FUNCTION function, void* argument);
+int joinThread(THREAD thread);
+int processorCount(void);
+int atomicAdd(int volatile* target, int value);
+int compareAndSwap(void* volatile* target, void* expected, void* desired);
+int initMutex(MUTEX* mutex);
+int deleteMutex(MUTEX* mutex);
+int lockMutex(MUTEX* mutex);
+int unlockMutex(MUTEX* mutex);
+int sleepThread(int milliseconds);
+
+/*
+  startThread
+  description
+    starts a new thread running the provided function.
+  params:
+    thread    handle to be filled with the new thread.
+    function  function to be run by the thread.
+    argument  argument passed to the function.
+  return:
+    result    0 on success, nonzero if the thread could not
+              be started (the caller should then run the
+              function itself).
+*/
+int startThread(THREAD* thread, THREAD_FUNCTION function, void* argument)
+{
+#ifdef _WIN32
+  *thread = CreateThread(NULL, 0, function, argument, 0, NULL);
+  return *thread == NULL;
+#else
+  return pthread_create(thread, NULL, function, argument);
+#endif
+}
+
+/*
+  joinThread
+  description
+    waits for a thread to finish and releases it.
+  params:
+    thread    thread being waited on.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int joinThread(THREAD thread)
+{
+#ifdef _WIN32
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+#else
+  pthread_join(thread, NULL);
+#endif
+  return 0;
+}
+
+/*
+  processorCount
+  description
+    returns the number of processors available.
+  params:
+    void
+  return:
+    count     the number of processors (at least 1).
+*/
+int processorCount(void)
+{
+  int count;
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  count = (int) info.dwNumberOfProcessors;
+#else
+  count = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  return count > 0 ? count : 1;
+}
+
+
+/*
+  atomicAdd
+  description
+    adds to an integer shared between threads as a single
+    indivisible operation.
+  params:
+    target    the integer being added to.
+    value     the amount added.
+  return:
+    previous  the value of the integer before the addition.
+*/
+int atomicAdd(int volatile* target, int value)
+{
+#ifdef _WIN32
+  return (int) InterlockedExchangeAdd((LONG volatile*) target, (LONG) value);
+#else
+  return __sync_fetch_and_add(target, value);
+#endif
+}
+
+/*
+  compareAndSwap
+  description
+    replaces a pointer shared between threads, as a single
+    indivisible operation, if it still holds an expected value.
+  params:
+    target    the pointer being replaced.
+    expected  the value the pointer must hold.
+    desired   the value it is replaced with.
+  return:
+    swapped   nonzero if the pointer was replaced.
+*/
+int compareAndSwap(void* volatile* target, void* expected, void* desired)
+{
+#ifdef _WIN32
+  return InterlockedCompareExchangePointer(target, desired, expected) == expected;
+#else
+  return __sync_bool_compare_and_swap(target, expected, desired);
+#endif
+}
+
+/*
+  initMutex
+  description
+    initializes a lock which only one thread may hold at a time.
+  params:
+    mutex     the lock being initialized.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int initMutex(MUTEX* mutex)
+{
+#ifdef _WIN32
+  InitializeCriticalSection(mutex);
+#else
+  pthread_mutex_init(mutex, NULL);
+#endif
+  return 0;
+}
+
+/*
+  deleteMutex
+  description
+    releases a lock, which must not be held.
+  params:
+    mutex     the lock being released.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteMutex(MUTEX* mutex)
+{
+#ifdef _WIN32
+  DeleteCriticalSection(mutex);
+#else
+  pthread_mutex_destroy(mutex);
+#endif
+  return 0;
+}
+
+/*
+  lockMutex
+  description
+    takes a lock, waiting for any other thread holding it.
+  params:
+    mutex     the lock being taken.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int lockMutex(MUTEX* mutex)
+{
+#ifdef _WIN32
+  EnterCriticalSection(mutex);
+#else
+  pthread_mutex_lock(mutex);
+#endif
+  return 0;
+}
+
+/*
+  unlockMutex
+  description
+    gives up a lock held by this thread.
+  params:
+    mutex     the lock being given up.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int unlockMutex(MUTEX* mutex)
+{
+#ifdef _WIN32
+  LeaveCriticalSection(mutex);
+#else
+  pthread_mutex_unlock(mutex);
+#endif
+  return 0;
+}
+
+/*
+  sleepThread
+  description
+    suspends the calling thread.
+  params:
+    milliseconds
+              how long the thread is suspended for.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int sleepThread(int milliseconds)
+{
+#ifdef _WIN32
+  Sleep(milliseconds);
+#else
+  struct timespec interval;
+
+  interval.tv_sec = milliseconds / 1000;
+  interval.tv_nsec = (long) (milliseconds % 1000) * 1000000L;
+  nanosleep(&interval, NULL);
+#endif
+  return 0;
+}
+
+#endif
@@ -0,0 +1,497 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+#include"CommonHeader.h"
+#include"NameTable.h"
+#include"StringKernels.h"
+
+//the most edits a similar name may be from the name searched for
+#define TRIGRAM_DISTANCE_LIMIT 3
+//longest pattern searched for, that of a name
+#define TRIGRAM_PATTERN_SIZE 128
+
+typedef struct TRIGRAM_INDEX_P TRIGRAM_INDEX;
+
+TRIGRAM_INDEX* newTrigramIndex(NAME_ID* names, int count);
+  int trigramAt(char* text, int position);
+  int compareTrigramPairs(const void* a, const void* b);
+  NAME_ID* findPostings(TRIGRAM_INDEX* index, int trigram, int* count);
+int deleteTrigramIndex(TRIGRAM_INDEX* index);
+int containingNames(TRIGRAM_INDEX* index, char* pattern, NAME_ID* names);
+int similarNames(TRIGRAM_INDEX* index, char* pattern, int distance, NAME_ID* names);
+  int patternTrigrams(char* pattern, int* trigrams);
+int intersectPostings(NAME_ID* a, int aCount, NAME_ID* b, int bCount, NAME_ID* out);
+int foldChar(char c);
+int containsFolded(char* text, char* pattern);
+int editDistance(char* a, char* b, int limit);
+
+/*
+  TRIGRAM_INDEX
+  description
+    an inverted index from each run of three characters
+    (trigram) found in a set of names to the names holding
+    it, ignoring case. A name holding a pattern holds every
+    trigram of the pattern, and a name a few edits from a
+    pattern holds most of them, so the names worth comparing
+    with a pattern are found from its trigrams' postings
+    alone.
+  data:
+    names       every name indexed, by ascending id.
+    nameCount   the number of names indexed.
+    trigrams    every trigram found, ascending.
+    offsets     where the postings of each trigram begin, with
+                one more entry marking where the last end.
+    postings    the ids of the names holding each trigram,
+                ascending within each trigram.
+    trigramCount
+                the number of trigrams.
+*/
+struct TRIGRAM_INDEX_P
+{
+  NAME_ID* names;
+  int nameCount;
+  int* trigrams;
+  int* offsets;
+  NAME_ID* postings;
+  int trigramCount;
+};
+
+/*
+  newTrigramIndex
+  description
+    indexes the trigrams of a set of names.
+  params:
+    names     the ids of the names, ascending.
+    count     the number of names.
+  return:
+    index*    index created.
+*/
+TRIGRAM_INDEX* newTrigramIndex(NAME_ID* names, int count)
+{
+  TRIGRAM_INDEX* index = (TRIGRAM_INDEX*) calloc(1, sizeof(TRIGRAM_INDEX));
+  long long* pairs;
+  int pairCount = 0, i, j, length, trigram;
+
+  for(i = 0; i < count; i++)
+  {
+    length = nameLength(names[i]);
+    if(length > 2) pairCount += length - 2;
+  }
+  pairs = (long long*) malloc((pairCount + 1) * sizeof(long long));
+  if(index != NULL)
+  {
+    index->names = (NAME_ID*) malloc((count + 1) * sizeof(NAME_ID));
+    index->postings = (NAME_ID*) malloc((pairCount + 1) * sizeof(NAME_ID));
+    index->trigrams = (int*) malloc((pairCount + 1) * sizeof(int));
+    index->offsets = (int*) malloc((pairCount + 2) * sizeof(int));
+  }
+  if(index == NULL || pairs == NULL || index->names == NULL || index->postings == NULL
+    || index->trigrams == NULL || index->offsets == NULL)
+  {
+    printf("sufficient memory could not be allocated to create trigram index");
+    PAUSE
+    exit(0);
+  }
+  memcpy(index->names, names, count * sizeof(NAME_ID));
+  index->nameCount = count;
+
+  //each trigram of each name is paired with the name, and the
+  //pairs are sorted so that each trigram's names lie together
+  pairCount = 0;
+  for(i = 0; i < count; i++)
+  {
+    length = nameLength(names[i]);
+    for(j = 0; j + 2 < length; j++)
+    {
+      trigram = trigramAt(nameText(names[i]), j);
+      pairs[pairCount++] = ((long long) trigram << 32) | (unsigned int) names[i];
+    }
+  }
+  qsort(pairs, pairCount, sizeof(long long), &compareTrigramPairs);
+
+  j = 0;
+  index->trigramCount = 0;
+  for(i = 0; i < pairCount; i++)
+  {
+    //a name holding a trigram twice is posted once
+    if(i > 0 && pairs[i] == pairs[i - 1]) continue;
+    trigram = (int) (pairs[i] >> 32);
+    if(index->trigramCount == 0 || index->trigrams[index->trigramCount - 1] != trigram)
+    {
+      index->trigrams[index->trigramCount] = trigram;
+      index->offsets[index->trigramCount++] = j;
+    }
+    index->postings[j++] = (NAME_ID) (pairs[i] & 0xFFFFFFFF);
+  }
+  index->offsets[index->trigramCount] = j;
+
+  free(pairs);
+  return index;
+}
+
+/*
+  trigramAt
+  description
+    packs the three characters of a text from a position
+    into a single value, ignoring case.
+  params:
+    text      the text holding the trigram.
+    position  where the trigram begins.
+  return:
+    trigram   the packed trigram.
+*/
+int trigramAt(char* text, int position)
+{
+  return (foldChar(text[position]) << 16) | (foldChar(text[position + 1]) << 8) | foldChar(text[position + 2]);
+}
+
+/*
+  compareTrigramPairs
+  description
+    orders pairs of trigrams and name ids, for qsort.
+  params:
+    a         pointer to the first pair.
+    b         pointer to the second pair.
+  return:
+    comparison
+              the ordinal comparison of the pairs.
+*/
+int compareTrigramPairs(const void* a, const void* b)
+{
+  long long left = *((long long*) a), right = *((long long*) b);
+  return left < right ? -1 : left > right;
+}
+
+/*
+  findPostings
+  description
+    finds the names holding a trigram.
+  params:
+    index     index being searched.
+    trigram   the trigram.
+    count     set to the number of names found.
+  return:
+    postings  the ids of the names holding the trigram.
+*/
+NAME_ID* findPostings(TRIGRAM_INDEX* index, int trigram, int* count)
+{
+  int low = 0, high = index->trigramCount - 1, middle;
+
+  while(low <= high)
+  {
+    middle = (low + high) / 2;
+    if(index->trigrams[middle] < trigram) low = middle + 1;
+    else if(index->trigrams[middle] > trigram) high = middle - 1;
+    else
+    {
+      *count = index->offsets[middle + 1] - index->offsets[middle];
+      return index->postings + index->offsets[middle];
+    }
+  }
+  *count = 0;
+  return NULL;
+}
+
+/*
+  deleteTrigramIndex
+  description
+    frees a trigram index.
+  params:
+    index     index being freed.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int deleteTrigramIndex(TRIGRAM_INDEX* index)
+{
+  if(index == NULL) return 0;
+  free(index->names);
+  free(index->trigrams);
+  free(index->offsets);
+  free(index->postings);
+  free(index);
+  return 0;
+}
+
+/*
+  containingNames
+  description
+    finds the names which hold a pattern, ignoring case. The
+    postings of the pattern's trigrams are intersected,
+    shortest first, and the names left are checked.
+  params:
+    index     index being searched.
+    pattern   the text being searched for.
+    names     filled with the ids of the names found,
+              ascending. It must have room for every name
+              indexed.
+  return:
+    count     the number of names found.
+*/
+int containingNames(TRIGRAM_INDEX* index, char* pattern, NAME_ID* names)
+{
+  int trigrams[TRIGRAM_PATTERN_SIZE];
+  int trigramCount = patternTrigrams(pattern, trigrams);
+  NAME_ID *candidates = index->names, *postings, *scratch = NULL, *swap;
+  int candidateCount = index->nameCount, postingCount, shortest = 0, i, count = 0;
+
+  if(trigramCount > 0)
+  {
+    for(i = 1; i < trigramCount; i++)
+    {
+      findPostings(index, trigrams[i], &postingCount);
+      findPostings(index, trigrams[shortest], &candidateCount);
+      if(postingCount < candidateCount) shortest = i;
+    }
+    candidates = findPostings(index, trigrams[shortest], &candidateCount);
+    scratch = (NAME_ID*) malloc((2 * candidateCount + 1) * sizeof(NAME_ID));
+    if(scratch == NULL)
+    {
+      printf("sufficient memory could not be allocated to search trigram index");
+      PAUSE
+      exit(0);
+    }
+    for(i = 0; i < trigramCount && candidateCount > 0; i++)
+    {
+      if(i == shortest) continue;
+      postings = findPostings(index, trigrams[i], &postingCount);
+      //the candidates are kept in whichever half of the scratch
+      //space they were not read from
+      swap = candidates == scratch ? scratch + candidateCount : scratch;
+      candidateCount = intersectPostings(candidates, candidateCount, postings, postingCount, swap);
+      candidates = swap;
+    }
+  }
+
+  for(i = 0; i < candidateCount; i++)
+  {
+    if(containsFolded(nameText(candidates[i]), pattern)) names[count++] = candidates[i];
+  }
+  free(scratch);
+  return count;
+}
+
+/*
+  similarNames
+  description
+    finds the names within a number of edits (insertions,
+    deletions and substitutions of a character) of a pattern,
+    ignoring case. Each edit spoils at most three trigrams,
+    so only names holding all but three per edit of the
+    pattern's trigrams are compared with it.
+  params:
+    index     index being searched.
+    pattern   the name being searched for.
+    distance  the most edits allowed, at most
+              TRIGRAM_DISTANCE_LIMIT.
+    names     filled with the ids of the names found,
+              ascending. It must have room for every name
+              indexed.
+  return:
+    count     the number of names found.
+*/
+int similarNames(TRIGRAM_INDEX* index, char* pattern, int distance, NAME_ID* names)
+{
+  int trigrams[TRIGRAM_PATTERN_SIZE];
+  int trigramCount = patternTrigrams(pattern, trigrams);
+  int length = (int) strlen(pattern), needed, postingCount, i, j, count = 0;
+  unsigned char* shared = NULL;
+  NAME_ID* postings;
+
+  if(distance > TRIGRAM_DISTANCE_LIMIT) distance = TRIGRAM_DISTANCE_LIMIT;
+  needed = trigramCount - 3 * distance;
+  if(needed > 0)
+  {
+    //the trigrams each name shares with the pattern are counted
+    shared = (unsigned char*) calloc(getNameTable()->count, 1);
+    if(shared == NULL)
+    {
+      printf("sufficient memory could not be allocated to search trigram index");
+      PAUSE
+      exit(0);
+    }
+    for(i = 0; i < trigramCount; i++)
+    {
+      postings = findPostings(index, trigrams[i], &postingCount);
+      for(j = 0; j < postingCount; j++) shared[postings[j]]++;
+    }
+  }
+
+  for(i = 0; i < index->nameCount; i++)
+  {
+    NAME_ID name = index->names[i];
+    if(shared != NULL && shared[name] < needed) continue;
+    if(abs(nameLength(name) - length) > distance) continue;
+    if(editDistance(nameText(name), pattern, distance) <= distance) names[count++] = name;
+  }
+  free(shared);
+  return count;
+}
+
+/*
+  patternTrigrams
+  description
+    finds the distinct trigrams of a pattern.
+  params:
+    pattern   the pattern, of at most TRIGRAM_PATTERN_SIZE
+              characters.
+    trigrams  filled with the trigrams.
+  return:
+    count     the number of trigrams.
+*/
+int patternTrigrams(char* pattern, int* trigrams)
+{
+  int length = (int) strlen(pattern), count = 0, trigram, i, j;
+
+  if(length > TRIGRAM_PATTERN_SIZE) length = TRIGRAM_PATTERN_SIZE;
+  for(i = 0; i + 2 < length; i++)
+  {
+    trigram = trigramAt(pattern, i);
+    for(j = 0; j < count && trigrams[j] != trigram; j++);
+    if(j == count) trigrams[count++] = trigram;
+  }
+  return count;
+}
+
+/*
+  intersectPostings
+  description
+    finds the ids held by two ascending lists of ids. With
+    SSE2 four ids of each list are compared with one another
+    at once, the second list rotated a lane at a time.
+  params:
+    a         the first list.
+    aCount    the number of ids in the first list.
+    b         the second list.
+    bCount    the number of ids in the second list.
+    out       filled with the ids held by both, ascending. It
+              may not be either list.
+  return:
+    count     the number of ids held by both.
+*/
+int intersectPostings(NAME_ID* a, int aCount, NAME_ID* b, int bCount, NAME_ID* out)
+{
+  int i = 0, j = 0, count = 0;
+#ifdef KERNEL_SSE2
+  __m128i left, right, match;
+  int mask;
+
+  while(i + 4 <= aCount && j + 4 <= bCount)
+  {
+    left = _mm_loadu_si128((__m128i*) (a + i));
+    right = _mm_loadu_si128((__m128i*) (b + j));
+    match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(left, right),
+                                      _mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, 0x39))),
+                         _mm_or_si128(_mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, 0x4E)),
+                                      _mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, 0x93))));
+    //four bits are set for each of a's ids found in b's four
+    mask = _mm_movemask_epi8(match);
+    while(mask != 0)
+    {
+      int bit = lowestBit(mask);
+      out[count++] = a[i + bit / 4];
+      mask &= ~(15 << bit);
+    }
+    //the four ending lower cannot match anything further along
+    if(a[i + 3] < b[j + 3]) i += 4;
+    else if(a[i + 3] > b[j + 3]) j += 4;
+    else
+    {
+      i += 4;
+      j += 4;
+    }
+  }
+#endif
+  while(i < aCount && j < bCount)
+  {
+    if(a[i] < b[j]) i++;
+    else if(a[i] > b[j]) j++;
+    else
+    {
+      out[count++] = a[i];
+      i++;
+      j++;
+    }
+  }
+  return count;
+}
+
+/*
+  foldChar
+  description
+    returns a character in lower case, so that names are
+    compared ignoring case.
+  params:
+    c         the character.
+  return:
+    folded    the character in lower case, as an unsigned
+              value.
+*/
+int foldChar(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : (unsigned char) c;
+}
+
+/*
+  containsFolded
+  description
+    tests whether a text holds a pattern, ignoring case.
+  params:
+    text      the text being searched.
+    pattern   the pattern being searched for.
+  return:
+    contains  1 if the text holds the pattern, otherwise 0.
+*/
+int containsFolded(char* text, char* pattern)
+{
+  int i, j;
+
+  for(i = 0; text[i] != '\0' || pattern[0] == '\0'; i++)
+  {
+    for(j = 0; pattern[j] != '\0' && foldChar(text[i + j]) == foldChar(pattern[j]); j++);
+    if(pattern[j] == '\0') return 1;
+  }
+  return 0;
+}
+
+/*
+  editDistance
+  description
+    counts the edits (insertions, deletions and substitutions
+    of a character) needed to make one text another, ignoring
+    case, giving up once more than a limit are needed.
+  params:
+    a         the first text, of at most TRIGRAM_PATTERN_SIZE
+              characters.
+    b         the second text, of at most
+              TRIGRAM_PATTERN_SIZE characters.
+    limit     the most edits of interest.
+  return:
+    distance  the number of edits, or limit + 1 if more than
+              limit are needed.
+*/
+int editDistance(char* a, char* b, int limit)
+{
+  int previous[TRIGRAM_PATTERN_SIZE + 1], current[TRIGRAM_PATTERN_SIZE + 1];
+  int aLength = (int) strlen(a), bLength = (int) strlen(b), lowest, i, j, cost;
+
+  if(aLength > TRIGRAM_PATTERN_SIZE) aLength = TRIGRAM_PATTERN_SIZE;
+  if(bLength > TRIGRAM_PATTERN_SIZE) bLength = TRIGRAM_PATTERN_SIZE;
+  for(j = 0; j <= bLength; j++) previous[j] = j;
+  for(i = 1; i <= aLength; i++)
+  {
+    current[0] = lowest = i;
+    for(j = 1; j <= bLength; j++)
+    {
+      cost = previous[j - 1] + (foldChar(a[i - 1]) != foldChar(b[j - 1]));
+      if(previous[j] + 1 < cost) cost = previous[j] + 1;
+      if(current[j - 1] + 1 < cost) cost = current[j - 1] + 1;
+      current[j] = cost;
+      if(cost < lowest) lowest = cost;
+    }
+    //every later row is at least as far as this one's nearest
+    if(lowest > limit) return limit + 1;
+    memcpy(previous, current, (bLength + 1) * sizeof(int));
+  }
+  return previous[bLength] > limit ? limit + 1 : previous[bLength];
+}
+
+#endif
@@ -0,0 +1,1364 @@
+/*
+  Program: benchmark.c
+
+  compares the balancing policies of the BINARY_ENGINE on the
+  operation mixes of the contact book, and the engines a tree
+  can be held in on adding, finding, walking and removing 
+  contacts. It also checks that contacts holding new names
+  can be added by several threads at once. It is built on its own,
+  alongside (not as part of) lab3:
+    cc -O2 benchmark.c -o benchmark -lpthread
+  and run with an optional number of contacts (default 100000):
+    benchmark 250000
+*/
+#include"CommonHeader.h"
+#include<time.h>
+
+#include "BinaryTree.h"
+#include "Contact.h"
+#include "ContactColumns.h"
+#include "Query.h"
+#include "Aggregate.h"
+
+//number of operations carried out by each mix
+#define BENCHMARK_OPERATIONS 1000000
+//number of comparisons timed for each string kernel
+#define KERNEL_COMPARISONS 20000000
+//number of contacts compared, few enough to stay in cache so that
+//the comparisons rather than memory are timed
+#define KERNEL_SET 1024
+//number of completions timed, and of first name scans they are
+//compared with
+#define COMPLETIONS 1000000
+#define NAME_SCANS 100
+//number of pattern searches timed through the trigram indexes,
+//and by comparing every contact
+#define PATTERN_SEARCHES 1000
+#define PATTERN_WALKS 10
+//number of phone numbers looked up through the lookup table, and
+//found by walking the tree
+#define PHONE_LOOKUPS 1000000
+#define PHONE_WALKS 100
+//number of area codes counted through the bitmap index, and by
+//scanning the column store
+#define AREA_COUNTS 100000
+#define AREA_SCANS 100
+//number of times each report query is timed through its plan, and
+//by testing every contact
+#define QUERY_RUNS 100
+#define QUERY_WALKS 10
+//number of report queries timed
+#define REPORT_QUERIES 5
+//number of times each aggregate is timed through the column store
+//and indexes, and by walking the tree
+#define AGGREGATE_RUNS 100
+#define AGGREGATE_WALKS 10
+//number of aggregates timed
+#define AGGREGATES 4
+//number of times the table of every contact is written through a
+//renderer, with and without the row cache, and through a sprintf 
+//and fprintf of each row
+#define RENDER_RUNS 10
+//number of times every contact is walked through each engine
+#define ENGINE_WALKS 10
+//number of threads adding contacts at once to a skip list
+#define INGEST_THREADS 8
+
+typedef struct BENCHMARK_MIX_P BENCHMARK_MIX;
+typedef struct AGGREGATE_WALK_P AGGREGATE_WALK;
+typedef struct INGEST_TASK_P INGEST_TASK;
+
+NODE* newBenchmarkNode(TREE* tree, int seed);
+int runMix(TREE* tree, NODE** nodes, int count, BENCHMARK_MIX* mix, double* zipf);
+int editBenchmarkNode(TREE* tree, NODE* node);
+double* newZipf(int count);
+int zipfIndex(double* zipf, int count);
+int benchmarkRandom(void);
+int runKernels(TREE* tree, NODE** nodes, int count);
+int runCompletions(TREE* tree);
+int runPatterns(TREE* tree, NODE** nodes, int count);
+int runPhoneLookups(TREE* tree, NODE** nodes, int count);
+int runAreaCounts(TREE* tree, NODE** nodes, int count);
+int runQueries(TREE* tree);
+  int queryVisit(int* ptr_branch, void* context);
+int runAggregates(TREE* tree);
+  int aggregateVisit(int* ptr_branch, void* context);
+int runRenders(TREE* tree);
+  int fprintfVisit(int* ptr_branch, void* context);
+int runEngines(TreeDataPointers* treeDataPointers, FunctionPointers* nodeFunctionPointers, NODE** nodes, int count);
+  int engineVisit(int* ptr_branch, void* context);
+int runIngest(TreeDataPointers* treeDataPointers, FunctionPointers* nodeFunctionPointers, int count);
+  THREAD_RETURN THREAD_CALL ingestThread(void* argument);
+double secondsSince(clock_t start);
+
+/*
+  BENCHMARK_MIX
+  description
+    a mix of operations run against each policy.
+  data:
+    name        name printed for the mix.
+    readPercent percentage of operations which look a contact
+                up by key, the rest modify a contact (which
+                removes and re-adds it).
+    skewed      whether contacts are chosen with a Zipf 
+                distribution, so that a few hundred of them
+                receive most of the operations, rather than
+                uniformly.
+*/
+struct BENCHMARK_MIX_P
+{
+  char* name;
+  int readPercent;
+  int skewed;
+};
+
+/*
+  AGGREGATE_WALK
+  description
+    state of a walk computing an aggregate the way the tree 
+    was before aggregates, testing and formatting each contact
+    fitting a query to count it, or counting the contacts of
+    each group itself.
+  data:
+    query       the query counted, NULL if the contacts are
+                grouped.
+    type        the field the contacts are grouped by.
+    counts      the number of contacts in each group.
+    found       the number of contacts fitting the query.
+*/
+struct AGGREGATE_WALK_P
+{
+  QUERY* query;
+  CONTACT_FIELD type;
+  int* counts;
+  int found;
+};
+
+/*
+  INGEST_TASK
+  description
+    a run of contacts added to a tree by one thread, each 
+    holding a last name no other contact holds.
+  data:
+    tree        tree added to.
+    first       the first contact's number, from which its
+                name is made.
+    last        the number after the last contact's.
+    misread     the number of names which did not read back as
+                they were set.
+*/
+struct INGEST_TASK_P
+{
+  TREE* tree;
+  int first;
+  int last;
+  int misread;
+};
+
+BENCHMARK_MIX benchmarkMixes[] =
+{
+  {"lookup only", 100, 0},
+  {"read heavy",   95, 0},
+  {"balanced",     50, 0},
+  {"write heavy",  10, 0},
+  {"skewed read", 100, 1},
+  {"skewed mixed", 95, 1}
+};
+
+int main(int argc, char** argv)
+{
+  //ADHOC_BALANCE re-adds whole branches on each write and is
+  //left out, it does not finish in reasonable time at this size
+  BALANCE_POLICY policies[] = {AVL_BALANCE, RED_BLACK_BALANCE, TREAP_BALANCE, SCAPEGOAT_BALANCE, SPLAY_BALANCE};
+  char* policyNames[] = {"avl", "red-black", "treap", "scapegoat", "splay"};
+  int policyCount = sizeof(policies) / sizeof(policies[0]);
+  int mixCount = sizeof(benchmarkMixes) / sizeof(benchmarkMixes[0]);
+  int count = argc > 1 ? atoi(argv[1]) : 100000;
+  int i, j, p, m;
+
+  FunctionPointers nodeFunctionPointers;
+  TreeDataPointers treeDataPointers;
+  TREE* tree;
+  NODE **nodes, *node;
+  double* zipf;
+  clock_t start;
+
+  if(count <= 0) count = 100000;
+  nodes = (NODE**) malloc(count * sizeof(NODE*));
+  if(nodes == NULL)
+  {
+    printf("sufficient memory could not be allocated to run benchmark");
+    PAUSE
+    exit(0);
+  }
+  zipf = newZipf(count);
+
+  nodeFunctionPointers.newValue    = (void *(*)(char* key))                        &newContact;
+  nodeFunctionPointers.deleteValue = (int (*)(void *value))                         &deleteContact;
+  nodeFunctionPointers.saveValue   = (int (*)(FILE *file, void *value))             &saveContact;
+  nodeFunctionPointers.loadValue   = (void *(*)(FILE *file, char* key))             &loadContact;
+  nodeFunctionPointers.edit        = (int (*)(void *value))                         &editContact;
+  nodeFunctionPointers.compareFind = (int (*)(void *value, int type, void *target)) &contactCompareFind;
+  nodeFunctionPointers.compareSort = (int (*)(void *value, void *key))              &contactCompareSort;
+  nodeFunctionPointers.keyStale    = (int (*)(void *value))                         &getKeyStale;
+  nodeFunctionPointers.updateKey   = (int (*)(void *value))                         &updateKey;
+  nodeFunctionPointers.toString    = (int (*)(void* value, char* string, int type)) &contactToString;
+  nodeFunctionPointers.render      = (int (*)(void* value, RENDERER* renderer))     &contactRender;
+  nodeFunctionPointers.moveValue   = (void *(*)(void *value, char* key))            &moveContact;
+  nodeFunctionPointers.sortKey     = (long long (*)(void* value, int type))         &contactSortKey;
+  nodeFunctionPointers.newColumns  = (void *(*)(void** values, int* handles, int count))        &newContactColumns;
+  nodeFunctionPointers.scanColumns = (int (*)(void* columns, int type, void* target, int* handles)) &scanContactColumns;
+  nodeFunctionPointers.completeColumns = (int (*)(void* columns, int type, char* prefix, int k, char** names, int* counts)) &completeContactColumns;
+  nodeFunctionPointers.groupColumns = (int (*)(void* columns, int type, int first, int last, int* counts)) &groupContactColumns;
+  nodeFunctionPointers.deleteColumns = (int (*)(void* columns))                                     &deleteContactColumns;
+  nodeFunctionPointers.lookupKey   = (long long (*)(void* value))                   &contactLookupKey;
+  nodeFunctionPointers.lookupTarget = (long long (*)(int type, void* target))       &contactLookupTarget;
+  nodeFunctionPointers.bitmapKey   = (int (*)(void* value, int type))               &contactBitmapKey;
+  nodeFunctionPointers.bitmapTarget = (int (*)(int type, void* target))             &contactBitmapTarget;
+  nodeFunctionPointers.keyPrefix   = (int (*)(int type, void* target, char* prefix)) &contactKeyPrefix;
+  nodeFunctionPointers.targetToString = (int (*)(int type, void* target, char* string)) &contactTargetToString;
+  nodeFunctionPointers.groupToString = (int (*)(int type, int group, char* string)) &contactGroupToString;
+  treeDataPointers.findMenu        = (int (*)())                                    &findMenu;
+  treeDataPointers.prompt          = (int (*)(int type, void* input))               &prompt;
+  treeDataPointers.tableHeader     =                                                &contactTableHeader;
+  //no initial data is read
+  treeDataPointers.fileAddress     =                                                 "";
+  treeDataPointers.engine          =                                                 BINARY_ENGINE;
+  //the benchmark holds on to its nodes, which compaction would move
+  treeDataPointers.compact         =                                                 0;
+  treeDataPointers.interactive     =                                                 0;
+
+  printf("%d contacts, %d operations per mix (seconds)\n\n", count, BENCHMARK_OPERATIONS);
+  printf("%-12s%10s%10s", "policy", "insert", "batch");
+  for(m = 0; m < mixCount; m++) printf("%13s", benchmarkMixes[m].name);
+  printf("%8s\n", "height");
+
+  for(p = 0; p < policyCount; p++)
+  {
+    treeDataPointers.balance = policies[p];
+    printf("%-12s", policyNames[p]);
+
+    //contacts added one at a time
+    tree = newBinaryTree(&treeDataPointers, &nodeFunctionPointers);
+    srand(1);
+    for(i = 0; i < count; i++) nodes[i] = newBenchmarkNode(tree, benchmarkRandom());
+    start = clock();
+    for(i = 0; i < count; i++) addElement(tree, nodes[i], 0);
+    printf("%10.3f", secondsSince(start));
+    deleteTree(tree);
+
+    //contacts added as a single batch
+    tree = newBinaryTree(&treeDataPointers, &nodeFunctionPointers);
+    srand(1);
+    for(i = 0; i < count; i++) nodes[i] = newBenchmarkNode(tree, benchmarkRandom());
+    start = clock();
+    addElements(tree, nodes, count);
+    printf("%10.3f", secondsSince(start));
+
+    //the batch is left sorted, it is shuffled so that the contacts
+    //chosen most often by skewed mixes are spread over the tree
+    for(i = count - 1; i > 0; i--)
+    {
+      j = benchmarkRandom() % (i + 1);
+      node = nodes[i];
+      nodes[i] = nodes[j];
+      nodes[j] = node;
+    }
+
+    for(m = 0; m < mixCount; m++)
+    {
+      srand(2 + m);
+      start = clock();
+      j = runMix(tree, nodes, count, &benchmarkMixes[m], zipf);
+      printf("%13.3f", secondsSince(start));
+      if(j != tree->size) printf("\nERROR: %d OF %d CONTACTS FOUND\n", j, tree->size);
+    }
+    //heights are not kept by every policy, so they are measured
+    printf("%8d\n", measureBranch(nodeAt(tree->root)));
+    //completions and string kernels are timed on the first
+    //policy's tree
+    if(p == 0) runCompletions(tree);
+    if(p == 0) runPatterns(tree, nodes, count);
+    if(p == 0) runPhoneLookups(tree, nodes, count);
+    if(p == 0) runAreaCounts(tree, nodes, count);
+    if(p == 0) runQueries(tree);
+    if(p == 0) runAggregates(tree);
+    if(p == 0) runRenders(tree);
+    if(p == 0) runKernels(tree, nodes, count);
+    else deleteTree(tree);
+  }
+  printf("\n");
+  runEngines(&treeDataPointers, &nodeFunctionPointers, nodes, count);
+  printf("\n");
+  runIngest(&treeDataPointers, &nodeFunctionPointers, count);
+  printf("\n");
+  runKernels(NULL, NULL, 0);
+  runCompletions(NULL);
+  runPatterns(NULL, NULL, 0);
+  runPhoneLookups(NULL, NULL, 0);
+  runAreaCounts(NULL, NULL, 0);
+  runQueries(NULL);
+  runAggregates(NULL);
+  runRenders(NULL);
+  //each contact holds two ids, the text of a name is held once
+  printf("\n%d contacts hold %d names in %ld bytes of text, %d bytes per contact\n",
+    count, getNameTable()->count, getNameTable()->bytes, (int) sizeof(CONTACT));
+
+  free(nodes);
+  free(zipf);
+  return 0;
+}
+
+/*
+  newBenchmarkNode
+  description
+    creates a node holding a generated contact, without
+    prompting the user.
+  params:
+    tree      tree the node will be added to.
+    seed      value from which the contact is generated.
+  return:
+    node*     node created
+*/
+NODE* newBenchmarkNode(TREE* tree, int seed)
+{
+  NODE* node = allocNode(tree->arena);
+  CONTACT* contact = (CONTACT*) malloc(sizeof(CONTACT));
+  short phoneNumber[3];
+  char name[NAME_SIZE + 1];
+
+  if(contact == NULL)
+  {
+    printf("sufficient memory could not be allocated to create node");
+    PAUSE
+    exit(0);
+  }
+  //zeroed contacts hold empty names
+  memset(contact, 0, sizeof(CONTACT));
+  node->value = contact;
+  node->key[0] = '\0';
+  setLess(node, NULL);
+  setGreater(node, NULL);
+  node->height = 1;
+  node->weight = 1;
+  node->balance = 0;
+  //contacts may be created by several threads at once
+  setIndex(node, atomicAdd(&nodeIndex, 1));
+
+  contact->key = node->key;
+  phoneNumber[0] = (short) (200 + seed % 800);
+  phoneNumber[1] = (short) (200 + seed / 800 % 800);
+  phoneNumber[2] = (short) (seed % 10000);
+  setPhoneNumber(contact, phoneNumber);
+  //a few thousand last names, so that many contacts share one
+  sprintf(name, "Name%d", seed % 3000);
+  setLastName(contact, name);
+  sprintf(name, "First%d", seed / 3000 % 500);
+  setFirstName(contact, name);
+  return node;
+}
+
+/*
+  runMix
+  description
+    carries out BENCHMARK_OPERATIONS lookups and modifications
+    of randomly chosen contacts.
+  params:
+    tree      tree being operated on.
+    nodes     every node held by the tree.
+    count     the number of nodes.
+    mix       the mix of operations.
+    zipf      distribution used by skewed mixes (see newZipf).
+  return:
+    found     the number of nodes which can still be found
+              afterwards (which should be all of them).
+*/
+int runMix(TREE* tree, NODE** nodes, int count, BENCHMARK_MIX* mix, double* zipf)
+{
+  int* ptr_branch;
+  int i, found = 0;
+
+  for(i = 0; i < BENCHMARK_OPERATIONS; i++)
+  {
+    NODE* node = nodes[mix->skewed ? zipfIndex(zipf, count) : benchmarkRandom() % count];
+    if(rand() % 100 < mix->readPercent)
+    {
+      ptr_branch = tree->engine->search(tree, node->key);
+      if(ptr_branch == NULL) printf("\nERROR: INPUT NOT FOUND\n");
+    }
+    else editBenchmarkNode(tree, node);
+  }
+
+  for(i = 0; i < count; i++)
+  {
+    found += tree->engine->find(tree, BY_KEY, nodes[i]) != NULL;
+  }
+  return found;
+}
+
+/*
+  editBenchmarkNode
+  description
+    modifies a contact the way modifyElement does, by taking
+    it out of the tree, changing its name and re-adding it.
+  params:
+    tree      tree holding the node.
+    node      node being modified.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int editBenchmarkNode(TREE* tree, NODE* node)
+{
+  char name[NAME_SIZE + 1];
+  int* ptr_branch = tree->engine->find(tree, BY_KEY, node);
+
+  tree->size--;
+  recordWrite(tree, 1, 1);
+  unindexElement(tree, node);
+  tree->engine->remove(tree, ptr_branch);
+
+  sprintf(name, "Name%d", rand() % 3000);
+  setLastName((CONTACT*) getValue(node), name);
+  addElement(tree, node, 0);
+  return 0;
+}
+
+/*
+  runKernels
+  description
+    times the string kernels of each instruction set the 
+    processor supports, comparing keys of contacts and
+    finding contacts by key (which compares keys at each 
+    level of the tree). The results of a tree are
+    held until they are printed by a call without one.
+  params:
+    tree      tree being looked up, which is deleted once the
+              kernels have been timed. NULL prints the results.
+    nodes     every node held by the tree.
+    count     the number of nodes.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runKernels(TREE* tree, NODE** nodes, int count)
+{
+  static double results[3][2];
+  STRING_KERNELS* kernels[3];
+  STRING_KERNELS* chosen = getStringKernels();
+  int kernelCount = 0, i, j, k, found = 0;
+  int set = count < KERNEL_SET ? count : KERNEL_SET;
+  int rounds = set > 1 ? KERNEL_COMPARISONS / set : 0;
+  clock_t start;
+
+  kernels[kernelCount++] = &scalarKernels;
+#ifdef KERNEL_SSE2
+  kernels[kernelCount++] = &sse2Kernels;
+#endif
+#ifdef KERNEL_AVX2
+  if(avx2Supported()) kernels[kernelCount++] = &avx2Kernels;
+#endif
+
+  if(tree == NULL)
+  {
+    printf("%-12s%18s%14s\n", "kernel", "key compare (ns)", "lookups (s)");
+    for(k = 0; k < kernelCount; k++)
+    {
+      printf("%-12s%18.2f%14.3f\n", kernels[k]->name, results[k][0], results[k][1]);
+    }
+    return 0;
+  }
+  if(set < 2)
+  {
+    deleteTree(tree);
+    return 0;
+  }
+
+  for(k = 0; k < kernelCount; k++)
+  {
+    stringKernels = kernels[k];
+
+    //pairs of contacts, whose keys share the prefix given to them
+    start = clock();
+    for(i = 0; i < rounds; i++)
+    {
+      for(j = 1; j < set; j++)
+      {
+        found += contactCompareSort((CONTACT*) getValue(nodes[j - 1]), (CONTACT*) getValue(nodes[j])) == 0;
+      }
+    }
+    results[k][0] = secondsSince(start) * 1e9 / ((double) rounds * (set - 1));
+
+    srand(1);
+    start = clock();
+    for(i = 0; i < BENCHMARK_OPERATIONS; i++)
+    {
+      found += tree->engine->find(tree, BY_KEY, nodes[benchmarkRandom() % count]) != NULL;
+    }
+    results[k][1] = secondsSince(start);
+  }
+  //the count is used so that the comparisons are not left out
+  if(found < 0) printf("%d", found);
+  stringKernels = chosen;
+  deleteTree(tree);
+  return 0;
+}
+
+/*
+  runCompletions
+  description
+    times completing first names one keystroke at a time, as 
+    the lookup screen does, against finding every contact with
+    a first name by scanning the tree's columns. The results
+    are held until they are printed by a call without a tree.
+  params:
+    tree      tree being searched, NULL prints the results.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runCompletions(TREE* tree)
+{
+  static double built, completed, scanned;
+  char* typed = "First123";
+  char prefix[NAME_SIZE + 1];
+  char* names[COMPLETION_COUNT];
+  int counts[COMPLETION_COUNT];
+  NODE** results;
+  NAME_ID name = findName(typed);
+  int i, length = (int) strlen(typed), found = 0;
+  clock_t start;
+
+  if(tree == NULL)
+  {
+    printf("\nfirst names: trie built in %.3f s, completion %.3f us, exact name scan %.1f us\n",
+      built, completed, scanned);
+    return 0;
+  }
+  results = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  if(results == NULL)
+  {
+    printf("sufficient memory could not be allocated to run completions");
+    PAUSE
+    exit(0);
+  }
+
+  //the first completion builds the columns and the trie
+  start = clock();
+  found += completeTree(tree, (FIND_BY) FIRST_NAME, "F", COMPLETION_COUNT, names, counts);
+  built = secondsSince(start);
+
+  start = clock();
+  for(i = 0; i < COMPLETIONS; i++)
+  {
+    strncpy(prefix, typed, i % length + 1);
+    prefix[i % length + 1] = '\0';
+    found += completeTree(tree, (FIND_BY) FIRST_NAME, prefix, COMPLETION_COUNT, names, counts);
+  }
+  completed = secondsSince(start) * 1e6 / COMPLETIONS;
+
+  start = clock();
+  for(i = 0; i < NAME_SCANS; i++) found += scanTree(tree, (FIND_BY) FIRST_NAME, &name, results);
+  scanned = secondsSince(start) * 1e6 / NAME_SCANS;
+
+  //the count is used so that the searches are not left out
+  if(found < 0) printf("%d", found);
+  free(results);
+  return 0;
+}
+
+/*
+  runPatterns
+  description
+    times finding the contacts either of whose names hold a
+    pattern, and those with a name spelt similarly to one,
+    through the trigram indexes of the tree's columns against
+    comparing every contact. The results are held until they
+    are printed by a call without a tree.
+  params:
+    tree      tree being searched, NULL prints the results.
+    nodes     every node of the tree.
+    count     the number of nodes.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runPatterns(TREE* tree, NODE** nodes, int count)
+{
+  static double built, results[2][2];
+  static int matches[2];
+  static char* names[] = {"contains \"me12\"", "within 2 of \"Nmae1234\""};
+  NAME_PATTERN patterns[2];
+  CONTACT_FIELD types[] = {NAME_CONTAINS, NAME_SIMILAR};
+  NODE** found;
+  int i, j, k, walked;
+  clock_t start;
+
+  if(tree == NULL)
+  {
+    printf("\nname patterns: trigram indexes built in %.3f s\n", built);
+    for(k = 0; k < 2; k++)
+    {
+      printf("  %-24s %6d contacts, indexed %.1f us, every contact %.1f us\n",
+        names[k], matches[k], results[k][0], results[k][1]);
+    }
+    return 0;
+  }
+  found = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  if(found == NULL)
+  {
+    printf("sufficient memory could not be allocated to run pattern searches");
+    PAUSE
+    exit(0);
+  }
+  strcpy(patterns[0].text, "me12");
+  patterns[0].distance = 0;
+  strcpy(patterns[1].text, "Nmae1234");
+  patterns[1].distance = 2;
+
+  //the first search builds both name columns' indexes
+  start = clock();
+  scanTree(tree, (FIND_BY) NAME_CONTAINS, &patterns[0], found);
+  built = secondsSince(start);
+
+  for(k = 0; k < 2; k++)
+  {
+    start = clock();
+    for(i = 0; i < PATTERN_SEARCHES; i++) matches[k] = scanTree(tree, (FIND_BY) types[k], &patterns[k], found);
+    results[k][0] = secondsSince(start) * 1e6 / PATTERN_SEARCHES;
+
+    start = clock();
+    for(i = 0; i < PATTERN_WALKS; i++)
+    {
+      walked = 0;
+      for(j = 0; j < count; j++) walked += !compareNamePattern((CONTACT*) nodes[j]->value, types[k], &patterns[k]);
+    }
+    results[k][1] = secondsSince(start) * 1e6 / PATTERN_WALKS;
+    if(walked != matches[k]) printf("\nERROR: %d OF %d CONTACTS FOUND\n", matches[k], walked);
+  }
+  free(found);
+  return 0;
+}
+
+/*
+  runPhoneLookups
+  description
+    times finding a contact by its phone number, as caller id
+    does, through the lookup table against walking the tree 
+    for it. The results are held until they are printed by a
+    call without a tree.
+  params:
+    tree      tree being searched, NULL prints the results.
+    nodes     every node of the tree.
+    count     the number of nodes.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runPhoneLookups(TREE* tree, NODE** nodes, int count)
+{
+  static double built, looked, walked;
+  long long number;
+  NODE* node;
+  int i, found = 0;
+  clock_t start;
+
+  if(tree == NULL)
+  {
+    printf("\nphone numbers: lookup table built in %.3f s, lookup %.3f us, tree walk %.1f us\n",
+      built, looked, walked);
+    return 0;
+  }
+
+  start = clock();
+  buildLookup(tree);
+  built = secondsSince(start);
+
+  start = clock();
+  for(i = 0; i < PHONE_LOOKUPS; i++)
+  {
+    number = getPhoneNumberNum((CONTACT*) nodes[benchmarkRandom() % count]->value);
+    found += lookupTree(tree, (FIND_BY) PHONE_NUMBER, &number, &node, 1);
+  }
+  looked = secondsSince(start) * 1e6 / PHONE_LOOKUPS;
+  if(found != PHONE_LOOKUPS) printf("\nERROR: %d OF %d NUMBERS FOUND\n", found, PHONE_LOOKUPS);
+
+  start = clock();
+  for(i = 0; i < PHONE_WALKS; i++)
+  {
+    number = getPhoneNumberNum((CONTACT*) nodes[benchmarkRandom() % count]->value);
+    found += tree->engine->find(tree, (FIND_BY) PHONE_NUMBER, &number) != NULL;
+  }
+  walked = secondsSince(start) * 1e6 / PHONE_WALKS;
+
+  //the count is used so that the searches are not left out
+  if(found < 0) printf("%d", found);
+  return 0;
+}
+
+/*
+  runAreaCounts
+  description
+    times counting the contacts in an area code through its 
+    bitmap, and listing those in either of two area codes 
+    through the union of their bitmaps, against scanning the
+    column store for them. The results are held until they 
+    are printed by a call without a tree.
+  params:
+    tree      tree being searched, NULL prints the results.
+    nodes     every node of the tree.
+    count     the number of nodes.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runAreaCounts(TREE* tree, NODE** nodes, int count)
+{
+  static double built, counted, joined, scanned;
+  short areas[2];
+  BITMAP *first, *second, *either;
+  int* handles;
+  int i, found = 0;
+  clock_t start;
+
+  if(tree == NULL)
+  {
+    printf("\narea codes: bitmaps built in %.3f s, count %.3f us, union %.1f us, column scan %.1f us\n",
+      built, counted, joined, scanned);
+    return 0;
+  }
+  handles = (int*) malloc((count + 1) * sizeof(int));
+  if(handles == NULL)
+  {
+    printf("sufficient memory could not be allocated to count area codes");
+    PAUSE
+    exit(0);
+  }
+
+  start = clock();
+  getBitmapIndex(tree, (FIND_BY) AREA_CODE);
+  built = secondsSince(start);
+
+  start = clock();
+  for(i = 0; i < AREA_COUNTS; i++)
+  {
+    areas[0] = (short) (getPhoneNumberNum((CONTACT*) nodes[benchmarkRandom() % count]->value) / PHONE_AREA_SCALE);
+    found += countTree(tree, (FIND_BY) AREA_CODE, &areas[0]);
+  }
+  counted = secondsSince(start) * 1e6 / AREA_COUNTS;
+
+  start = clock();
+  for(i = 0; i < AREA_SCANS; i++)
+  {
+    areas[0] = (short) (getPhoneNumberNum((CONTACT*) nodes[benchmarkRandom() % count]->value) / PHONE_AREA_SCALE);
+    areas[1] = (short) (getPhoneNumberNum((CONTACT*) nodes[benchmarkRandom() % count]->value) / PHONE_AREA_SCALE);
+    first = bitmapTree(tree, (FIND_BY) AREA_CODE, &areas[0]);
+    second = bitmapTree(tree, (FIND_BY) AREA_CODE, &areas[1]);
+    //the bitmaps belong to the tree's index, and are only read
+    //under its lock, as groupTree reads them
+    lockMutex(&tree->bitmapLock);
+    either = bitmapOr(first, second);
+    unlockMutex(&tree->bitmapLock);
+    found += bitmapValues(either, (unsigned int*) handles);
+    deleteBitmap(either);
+  }
+  joined = secondsSince(start) * 1e6 / AREA_SCANS;
+
+  if(tree->columns == NULL || tree->columnsStale) buildColumns(tree);
+  start = clock();
+  for(i = 0; i < AREA_SCANS; i++)
+  {
+    areas[0] = (short) (getPhoneNumberNum((CONTACT*) nodes[benchmarkRandom() % count]->value) / PHONE_AREA_SCALE);
+    areas[1] = (short) (getPhoneNumberNum((CONTACT*) nodes[benchmarkRandom() % count]->value) / PHONE_AREA_SCALE);
+    found += tree->functionPointers->scanColumns(tree->columns, AREA_CODE, &areas[0], handles);
+    found += tree->functionPointers->scanColumns(tree->columns, AREA_CODE, &areas[1], handles);
+  }
+  scanned = secondsSince(start) * 1e6 / AREA_SCANS;
+
+  free(handles);
+  //the count is used so that the searches are not left out
+  if(found < 0) printf("%d", found);
+  return 0;
+}
+
+/*
+  runQueries
+  description
+    times report queries combining several fields, answered 
+    through their plans against testing every contact as the
+    tree is walked. The results are held until they are 
+    printed by a call without a tree.
+  params:
+    tree      tree being searched, NULL prints the results.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runQueries(TREE* tree)
+{
+  static char* names[REPORT_QUERIES] = 
+  {
+    "last name Name12.. and area 212",
+    "area 300 or area 301",
+    "first name First4.. and area 500 range",
+    "part me99 or first First49.., first 20",
+    "first First7 and (area 400 or Name29..)"
+  };
+  static QUERY_PATH paths[REPORT_QUERIES];
+  static int rows[REPORT_QUERIES], expected[REPORT_QUERIES];
+  static double planned[REPORT_QUERIES], walked[REPORT_QUERIES];
+  QUERY* queries[REPORT_QUERIES];
+  QUERY_PLAN* plan;
+  NODE** results;
+  short areas[4] = {212, 300, 301, 400};
+  long long range[2] = {500 * PHONE_AREA_SCALE, 501 * PHONE_AREA_SCALE - 1};
+  NAME_ID firstName = findName("First7");
+  NAME_PATTERN pattern;
+  FIND_BY orders[REPORT_QUERIES] = {BY_KEY, BY_KEY, BY_KEY, BY_KEY, (FIND_BY) PHONE_NUMBER};
+  int limits[REPORT_QUERIES] = {0, 0, 0, 20, 0};
+  int i, q;
+  clock_t start;
+
+  if(tree == NULL)
+  {
+    printf("\n%-42s%-14s%8s%10s%14s%14s\n", "report query", "plan", "rows", "expected", "planned us", "walk us");
+    for(q = 0; q < REPORT_QUERIES; q++)
+    {
+      printf("%-42s%-14s%8d%10d%14.1f%14.1f\n", names[q], queryPaths[paths[q]], rows[q], expected[q], planned[q], walked[q]);
+    }
+    return 0;
+  }
+  results = (NODE**) malloc((tree->size + 1) * sizeof(NODE*));
+  if(results == NULL)
+  {
+    printf("sufficient memory could not be allocated to run queries");
+    PAUSE
+    exit(0);
+  }
+  strcpy(pattern.text, "me99");
+  pattern.distance = 0;
+  queries[0] = queryAnd(newQuery((FIND_BY) LAST_NAME_PREFIX, "Name12"), newQuery((FIND_BY) AREA_CODE, &areas[0]));
+  queries[1] = queryOr(newQuery((FIND_BY) AREA_CODE, &areas[1]), newQuery((FIND_BY) AREA_CODE, &areas[2]));
+  queries[2] = queryAnd(newQuery((FIND_BY) FIRST_NAME_PREFIX, "First4"), newQuery((FIND_BY) PHONE_RANGE, range));
+  queries[3] = queryOr(newQuery((FIND_BY) NAME_CONTAINS, &pattern), newQuery((FIND_BY) FIRST_NAME_PREFIX, "First49"));
+  queries[4] = queryAnd(newQuery((FIND_BY) FIRST_NAME, &firstName), 
+    queryOr(newQuery((FIND_BY) AREA_CODE, &areas[3]), newQuery((FIND_BY) LAST_NAME_PREFIX, "Name29")));
+
+  for(q = 0; q < REPORT_QUERIES; q++)
+  {
+    //the first run builds the indexes the plan reads
+    plan = planQuery(tree, queries[q], orders[q], limits[q]);
+    runQuery(tree, plan, results);
+    deletePlan(plan);
+
+    start = clock();
+    for(i = 0; i < QUERY_RUNS; i++)
+    {
+      plan = planQuery(tree, queries[q], orders[q], limits[q]);
+      rows[q] = runQuery(tree, plan, results);
+      paths[q] = plan->path;
+      expected[q] = plan->rows;
+      deletePlan(plan);
+    }
+    planned[q] = secondsSince(start) * 1e6 / QUERY_RUNS;
+
+    start = clock();
+    for(i = 0; i < QUERY_WALKS; i++) tree->engine->walk(tree, &queryVisit, (void*) queries[q]);
+    walked[q] = secondsSince(start) * 1e6 / QUERY_WALKS;
+    deleteQuery(queries[q]);
+  }
+  free(results);
+  return 0;
+}
+
+/*
+  queryVisit
+  description
+    walk visitor testing each node against a query, as the 
+    tree was searched before queries were planned.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the query.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int queryVisit(int* ptr_branch, void* context)
+{
+  //the count is kept so that the tests are not left out
+  static int volatile found;
+  found += matchQuery(nodeAt(*ptr_branch), (QUERY*) context);
+  return 0;
+}
+
+/*
+  runAggregates
+  description
+    times counting the contacts fitting a query, grouping them
+    by area code and by last name, and finding the most common
+    first names, against walking the tree for them. The 
+    results are held until they are printed by a call without
+    a tree.
+  params:
+    tree      tree being counted, NULL prints the results.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runAggregates(TREE* tree)
+{
+  static char* names[AGGREGATES] = 
+  {
+    "count Name12.. or area 212",
+    "group by area code",
+    "group by last name",
+    "top 10 first names"
+  };
+  static CONTACT_FIELD types[AGGREGATES] = {0, AREA_CODE, LAST_NAME, FIRST_NAME};
+  static int values[AGGREGATES];
+  static double aggregated[AGGREGATES], walked[AGGREGATES];
+  AGGREGATE_WALK walk;
+  QUERY* query;
+  short area = 212;
+  int groups[10], counts[10];
+  int *grouped, groupCount, i, a;
+  clock_t start;
+
+  if(tree == NULL)
+  {
+    printf("\n%-42s%8s%14s%14s\n", "aggregate", "values", "computed us", "walk us");
+    for(a = 0; a < AGGREGATES; a++)
+    {
+      printf("%-42s%8d%14.1f%14.1f\n", names[a], values[a], aggregated[a], walked[a]);
+    }
+    return 0;
+  }
+  query = queryOr(newQuery((FIND_BY) LAST_NAME_PREFIX, "Name12"), newQuery((FIND_BY) AREA_CODE, &area));
+  walk.counts = (int*) malloc((getNameTable()->count + AREA_CODE_LIMIT) * sizeof(int));
+  if(walk.counts == NULL)
+  {
+    printf("sufficient memory could not be allocated to run aggregates");
+    PAUSE
+    exit(0);
+  }
+
+  for(a = 0; a < AGGREGATES; a++)
+  {
+    //the first run builds the indexes and columns read, and is
+    //not timed
+    start = clock();
+    for(i = 0; i <= AGGREGATE_RUNS; i++)
+    {
+      if(i == 1) start = clock();
+      if(a == 0) values[a] = countQuery(tree, query);
+      else if(a < 3)
+      {
+        grouped = groupTree(tree, (FIND_BY) types[a], &groupCount);
+        for(values[a] = 0; groupCount > 0; groupCount--) values[a] += grouped[groupCount - 1] > 0;
+        free(grouped);
+      }
+      else values[a] = topGroups(tree, (FIND_BY) types[a], 10, groups, counts);
+    }
+    aggregated[a] = secondsSince(start) * 1e6 / AGGREGATE_RUNS;
+
+    walk.query = a == 0 ? query : NULL;
+    walk.type = types[a];
+    start = clock();
+    for(i = 0; i < AGGREGATE_WALKS; i++)
+    {
+      walk.found = 0;
+      memset(walk.counts, 0, (getNameTable()->count + AREA_CODE_LIMIT) * sizeof(int));
+      tree->engine->walk(tree, &aggregateVisit, (void*) &walk);
+      if(a == 3) rankGroups(walk.counts, getNameTable()->count, 10, groups);
+    }
+    walked[a] = secondsSince(start) * 1e6 / AGGREGATE_WALKS;
+  }
+  deleteQuery(query);
+  free(walk.counts);
+  return 0;
+}
+
+/*
+  aggregateVisit
+  description
+    walk visitor adding a contact to an AGGREGATE_WALK.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the AGGREGATE_WALK.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int aggregateVisit(int* ptr_branch, void* context)
+{
+  AGGREGATE_WALK* walk = (AGGREGATE_WALK*) context;
+  CONTACT* contact = (CONTACT*) getValue(nodeAt(*ptr_branch));
+
+  if(walk->query != NULL)
+  {
+    //a contact was counted by printing it
+    if(!matchQuery(nodeAt(*ptr_branch), walk->query)) return 0;
+    nodeToString(nodeAt(*ptr_branch), valueBufferA);
+    walk->found++;
+  }
+  else if(walk->type == AREA_CODE) walk->counts[getPhoneNumberNum(contact) / PHONE_AREA_SCALE]++;
+  else if(walk->type == LAST_NAME) walk->counts[getLastNameId(contact)]++;
+  else walk->counts[getFirstNameId(contact)]++;
+  return 0;
+}
+
+/*
+  runRenders
+  description
+    times writing the table of every contact to a temporary
+    file through renderTree, formatting each row and copying
+    it from the row cache, against formatting each row with
+    nodeToString and writing it with fprintf. The results are
+    held until they are printed by a call without a tree.
+  params:
+    tree      tree being written, NULL prints the results.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runRenders(TREE* tree)
+{
+  static double rendered, cached, filled, printed;
+  static long renderedBytes, cachedBytes, printedBytes;
+  int (*render)(void* value, RENDERER* renderer) = tree == NULL ? NULL : tree->functionPointers->render;
+  FILE* file;
+  int i;
+  clock_t start;
+
+  if(tree == NULL)
+  {
+    printf("\ntable of every contact: renderer %.1f ms (%ld bytes), row cache %.1f ms (%ld bytes, %.1f ms filling it), fprintf %.1f ms (%ld bytes)\n",
+      rendered, renderedBytes, cached, cachedBytes, filled, printed, printedBytes);
+    return 0;
+  }
+  if((file = tmpfile()) == NULL) return 0;
+
+  start = clock();
+  for(i = 0; i < RENDER_RUNS; i++)
+  {
+    rewind(file);
+    renderTree(tree, BY_KEY, NULL, file);
+  }
+  rendered = secondsSince(start) * 1e3 / RENDER_RUNS;
+  renderedBytes = ftell(file);
+
+  //the first listing formats every row into the cache
+  tree->functionPointers->render = (int (*)(void* value, RENDERER* renderer)) &contactRenderRow;
+  start = clock();
+  rewind(file);
+  renderTree(tree, BY_KEY, NULL, file);
+  filled = secondsSince(start) * 1e3;
+  start = clock();
+  for(i = 0; i < RENDER_RUNS; i++)
+  {
+    rewind(file);
+    renderTree(tree, BY_KEY, NULL, file);
+  }
+  cached = secondsSince(start) * 1e3 / RENDER_RUNS;
+  cachedBytes = ftell(file);
+  tree->functionPointers->render = render;
+
+  start = clock();
+  for(i = 0; i < RENDER_RUNS; i++)
+  {
+    rewind(file);
+    tree->engine->walk(tree, &fprintfVisit, (void*) file);
+  }
+  printed = secondsSince(start) * 1e3 / RENDER_RUNS;
+  printedBytes = ftell(file);
+
+  fclose(file);
+  return 0;
+}
+
+/*
+  fprintfVisit
+  description
+    walk visitor writing the row of a node to a file the way
+    the tree did before rows were rendered.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the file written to.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int fprintfVisit(int* ptr_branch, void* context)
+{
+  nodeToString(nodeAt(*ptr_branch), valueBufferA);
+  fprintf((FILE*) context, "%s\n", valueBufferA);
+  return 0;
+}
+
+/*
+  runEngines
+  description
+    times adding contacts one at a time, finding them by key,
+    walking every contact in order and removing them one at a
+    time through each TREE_ENGINE, and prints the results. The
+    BINARY_ENGINE is timed under AVL_BALANCE.
+  params:
+    treeDataPointers
+              settings trees are created with, whose engine and
+              balance are changed for each engine timed.
+    nodeFunctionPointers
+              functions of the contacts.
+    nodes     room for count nodes, which are created for each
+              engine.
+    count     the number of contacts.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runEngines(TreeDataPointers* treeDataPointers, FunctionPointers* nodeFunctionPointers, NODE** nodes, int count)
+{
+  TREE_ENGINE engines[] = {BINARY_ENGINE, BTREE_ENGINE, ART_ENGINE, SKIPLIST_ENGINE};
+  char* engineNames[] = {"binary", "b-tree", "radix", "skip list"};
+  int engineCount = sizeof(engines) / sizeof(engines[0]);
+  TREE_ENGINE engine = treeDataPointers->engine;
+  BALANCE_POLICY balance = treeDataPointers->balance;
+  TREE* tree;
+  NODE* node;
+  int* ptr_branch;
+  int e, i, walked, found;
+  clock_t start;
+
+  printf("%-12s%10s%10s%10s%10s\n", "engine", "insert", "find", "walk (ms)", "remove");
+  treeDataPointers->balance = AVL_BALANCE;
+  for(e = 0; e < engineCount; e++)
+  {
+    treeDataPointers->engine = engines[e];
+    printf("%-12s", engineNames[e]);
+
+    tree = newBinaryTree(treeDataPointers, nodeFunctionPointers);
+    srand(1);
+    for(i = 0; i < count; i++) nodes[i] = newBenchmarkNode(tree, benchmarkRandom());
+    start = clock();
+    for(i = 0; i < count; i++) addElement(tree, nodes[i], 0);
+    printf("%10.3f", secondsSince(start));
+
+    srand(2);
+    found = 0;
+    start = clock();
+    for(i = 0; i < BENCHMARK_OPERATIONS; i++)
+    {
+      found += tree->engine->search(tree, nodes[benchmarkRandom() % count]->key) != NULL;
+    }
+    printf("%10.3f", secondsSince(start));
+    if(found != BENCHMARK_OPERATIONS) printf("\nERROR: %d OF %d CONTACTS FOUND\n", found, BENCHMARK_OPERATIONS);
+
+    start = clock();
+    for(i = 0; i < ENGINE_WALKS; i++)
+    {
+      walked = 0;
+      tree->engine->walk(tree, &engineVisit, (void*) &walked);
+    }
+    printf("%10.1f", secondsSince(start) * 1e3 / ENGINE_WALKS);
+    if(walked != tree->size) printf("\nERROR: %d OF %d CONTACTS WALKED\n", walked, tree->size);
+
+    //contacts sharing a key are interchangeable, so the one
+    //found is removed rather than the one searched for
+    start = clock();
+    for(i = 0; i < count; i++)
+    {
+      ptr_branch = tree->engine->search(tree, nodes[i]->key);
+      node = nodeAt(*ptr_branch);
+      tree->size--;
+      recordWrite(tree, 1, 1);
+      unindexElement(tree, node);
+      tree->engine->remove(tree, ptr_branch);
+      deleteNode(node, 0);
+    }
+    printf("%10.3f\n", secondsSince(start));
+    if(tree->size != 0) printf("ERROR: %d CONTACTS LEFT\n", tree->size);
+    deleteTree(tree);
+  }
+  treeDataPointers->engine = engine;
+  treeDataPointers->balance = balance;
+  return 0;
+}
+
+/*
+  engineVisit
+  description
+    walk visitor counting the nodes visited.
+  params:
+    ptr_branch
+              the branch referencing the node being visited.
+    context   the count.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int engineVisit(int* ptr_branch, void* context)
+{
+  //only the number of nodes matters, not which they are
+  (void) ptr_branch;
+  ++*((int*) context);
+  return 0;
+}
+
+/*
+  runIngest
+  description
+    adds contacts to a SKIPLIST_ENGINE tree from several threads
+    at once, each contact holding a new last name, so that names
+    are interned by some threads while others read names to
+    key their contacts. Every contact and name is then checked,
+    and the result printed.
+  params:
+    treeDataPointers
+              settings the tree is created with, whose engine is
+              changed for the run.
+    nodeFunctionPointers
+              functions of the contacts.
+    count     the number of contacts added.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+int runIngest(TreeDataPointers* treeDataPointers, FunctionPointers* nodeFunctionPointers, int count)
+{
+  INGEST_TASK tasks[INGEST_THREADS];
+  THREAD threads[INGEST_THREADS];
+  int started[INGEST_THREADS];
+  TREE_ENGINE engine = treeDataPointers->engine;
+  char name[NAME_SIZE + 1];
+  TREE* tree;
+  NAME_ID id;
+  int i, walked = 0, misread = 0;
+
+  treeDataPointers->engine = SKIPLIST_ENGINE;
+  tree = newBinaryTree(treeDataPointers, nodeFunctionPointers);
+  for(i = 0; i < INGEST_THREADS; i++)
+  {
+    tasks[i].tree = tree;
+    tasks[i].first = (int) ((long long) count * i / INGEST_THREADS);
+    tasks[i].last = (int) ((long long) count * (i + 1) / INGEST_THREADS);
+    tasks[i].misread = 0;
+    started[i] = !startThread(&threads[i], &ingestThread, &tasks[i]);
+  }
+  //runs whose thread could not be started are added by this one
+  for(i = 0; i < INGEST_THREADS; i++)
+  {
+    if(started[i]) joinThread(threads[i]);
+    else ingestThread(&tasks[i]);
+    misread += tasks[i].misread;
+  }
+
+  for(i = 0; i < count; i++)
+  {
+    sprintf(name, "Ingest%d", i);
+    id = findName(name);
+    misread += id == NAME_NONE || strcmp(nameText(id), name) != 0;
+  }
+  tree->engine->walk(tree, &engineVisit, (void*) &walked);
+  printf("concurrent ingest: %d threads added %d contacts holding new names, %d walked, %d names misread\n",
+    INGEST_THREADS, tree->size, walked, misread);
+  if(walked != count || tree->size != count || misread != 0) printf("ERROR: CONCURRENT INGEST LOST CONTACTS OR NAMES\n");
+  deleteTree(tree);
+  treeDataPointers->engine = engine;
+  return 0;
+}
+
+/*
+  ingestThread
+  description
+    thread entry point adding the contacts of an INGEST_TASK.
+  params:
+    argument  the INGEST_TASK being carried out.
+  return:
+    NULL      0 value indicating successful exicution.
+*/
+THREAD_RETURN THREAD_CALL ingestThread(void* argument)
+{
+  INGEST_TASK* task = (INGEST_TASK*) argument;
+  char name[NAME_SIZE + 1];
+  NODE* node;
+  int i;
+
+  for(i = task->first; i < task->last; i++)
+  {
+    node = newBenchmarkNode(task->tree, i);
+    sprintf(name, "Ingest%d", i);
+    setLastName((CONTACT*) getValue(node), name);
+    addElement(task->tree, node, 0);
+    task->misread += strcmp(getLastName((CONTACT*) getValue(node)), name) != 0;
+  }
+  return 0;
+}
+
+/*
+  newZipf
+  description
+    creates the cumulative Zipf distribution (exponent 1) of
+    choosing each of a number of items.
+  params:
+    count     the number of items.
+  return:
+    zipf      the probability of choosing an item at or before
+              each position.
+*/
+double* newZipf(int count)
+{
+  double* zipf = (double*) malloc(count * sizeof(double));
+  double total = 0;
+  int i;
+
+  if(zipf == NULL)
+  {
+    printf("sufficient memory could not be allocated to run benchmark");
+    PAUSE
+    exit(0);
+  }
+  for(i = 0; i < count; i++) total += 1.0 / (i + 1);
+  zipf[0] = 1.0 / total;
+  for(i = 1; i < count; i++) zipf[i] = zipf[i - 1] + 1.0 / ((i + 1) * total);
+  return zipf;
+}
+
+/*
+  zipfIndex
+  description
+    chooses an item from a Zipf distribution.
+  params:
+    zipf      distribution created by newZipf.
+    count     the number of items.
+  return:
+    index     position of the item chosen.
+*/
+int zipfIndex(double* zipf, int count)
+{
+  double chance = benchmarkRandom() / (double) 0x40000000;
+  int low = 0, high = count - 1, middle;
+
+  while(low < high)
+  {
+    middle = (low + high) / 2;
+    if(zipf[middle] < chance) low = middle + 1;
+    else high = middle;
+  }
+  return low;
+}
+
+/*
+  benchmarkRandom
+  description
+    returns a random number of 30 bits, rand alone may only
+    provide 15.
+  params:
+    void
+  return:
+    random    a non negative random number.
+*/
+int benchmarkRandom(void)
+{
+  return ((rand() << 15) ^ rand()) & 0x3FFFFFFF;
+}
+
+/*
+  secondsSince
+  description
+    returns the processor time used since a clock reading.
+  params:
+    start     the earlier clock reading.
+  return:
+    seconds   the time elapsed.
+*/
+double secondsSince(clock_t start)
+{
+  return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
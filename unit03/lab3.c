@@ -8,8 +8,18 @@
 
 #include "BinaryTree.h"
 #include "Contact.h"
+#include "ContactColumns.h"
+#include "Query.h"
+#include "Aggregate.h"
+//most criteria a report is made from
+#define REPORT_TERMS 8
+//argument printing every contact without the menu, so that the
+//table can be written to a file or another program
+#define PRINT_ARGUMENT "-print"
+
 typedef enum MAIN_MENU_CHOICE_P MAIN_MENU_CHOICE;
 MAIN_MENU_CHOICE mainMenu(void);
+int printReport(TREE* tree);
 
 
 
@@ -28,6 +38,12 @@ MAIN_MENU_CHOICE mainMenu(void);
     PRINT_BY_CRITERIA print all contacts fitting specified
                       criteria.
     PRINT_ALL         print all contacts.
+    COMPLETE_NAME     print the most common names
+                      beginning with a prefix.
+    COUNT_GROUPS      print the number of contacts holding
+                      each area code or name, most first.
+    PRINT_REPORT      print the contacts fitting several 
+                      criteria, and how they were found.
 
 */
 enum MAIN_MENU_CHOICE_P 
@@ -38,10 +54,13 @@ enum MAIN_MENU_CHOICE_P
   DELETE_CONTACT    = 3 ,
   PRINT_RECORD      = 4 ,
   PRINT_BY_CRITERIA = 5 ,
-  PRINT_ALL         = 6
+  PRINT_ALL         = 6 ,
+  COMPLETE_NAME     = 7 ,
+  COUNT_GROUPS      = 8 ,
+  PRINT_REPORT      = 9
 };
 
-int main(int argc, char* argv)
+int main(int argc, char** argv)
 {
   TREE* tree;
   int choice;
@@ -57,18 +76,47 @@ int main(int argc, char* argv)
   nodeFunctionPointers.edit			   = (int (*)(void *value))                         &editContact;
   nodeFunctionPointers.compareFind = (int (*)(void *value, int type, void *target)) &contactCompareFind;
   nodeFunctionPointers.compareSort = (int (*)(void *value, void *key))              &contactCompareSort;
+  nodeFunctionPointers.keyStale    = (int (*)(void *value))                         &getKeyStale;
+  nodeFunctionPointers.updateKey   = (int (*)(void *value))                         &updateKey;
   nodeFunctionPointers.toString		 = (int (*)(void* value, char* string, int type)) &contactToString;
+  //rows are kept formatted between listings
+  nodeFunctionPointers.render      = (int (*)(void* value, RENDERER* renderer))     &contactRenderRow;
+  nodeFunctionPointers.moveValue	 = (void *(*)(void *value, char* key))            &moveContact;
+  nodeFunctionPointers.sortKey	   = (long long (*)(void* value, int type))          &contactSortKey;
+  nodeFunctionPointers.newColumns  = (void *(*)(void** values, int* handles, int count))        &newContactColumns;
+  nodeFunctionPointers.scanColumns = (int (*)(void* columns, int type, void* target, int* handles)) &scanContactColumns;
+  nodeFunctionPointers.completeColumns = (int (*)(void* columns, int type, char* prefix, int k, char** names, int* counts)) &completeContactColumns;
+  nodeFunctionPointers.groupColumns = (int (*)(void* columns, int type, int first, int last, int* counts)) &groupContactColumns;
+  nodeFunctionPointers.deleteColumns = (int (*)(void* columns))                                     &deleteContactColumns;
+  nodeFunctionPointers.lookupKey   = (long long (*)(void* value))                   &contactLookupKey;
+  nodeFunctionPointers.lookupTarget = (long long (*)(int type, void* target))       &contactLookupTarget;
+  nodeFunctionPointers.bitmapKey   = (int (*)(void* value, int type))               &contactBitmapKey;
+  nodeFunctionPointers.bitmapTarget = (int (*)(int type, void* target))             &contactBitmapTarget;
+  nodeFunctionPointers.keyPrefix   = (int (*)(int type, void* target, char* prefix)) &contactKeyPrefix;
+  nodeFunctionPointers.targetToString = (int (*)(int type, void* target, char* string)) &contactTargetToString;
+  nodeFunctionPointers.groupToString = (int (*)(int type, int group, char* string)) &contactGroupToString;
   treeDataPointers.findMenu			   = (int (*)())                                    &findMenu;
   treeDataPointers.prompt			     = (int (*)(int type, void* input))               &prompt;
   treeDataPointers.tableHeader	   =                                                &contactTableHeader;
   treeDataPointers.fileAddress	   =                                                 fileAddress;
+  treeDataPointers.engine	       =                                                 BINARY_ENGINE;
+  treeDataPointers.balance	      =                                                 AVL_BALANCE;
+  treeDataPointers.compact	      =                                                 1;
+  treeDataPointers.interactive    =                                                 !(argc > 1 && !strcmp(argv[1], PRINT_ARGUMENT));
   
   tree = newBinaryTree(&treeDataPointers, &nodeFunctionPointers);
+  if(!treeDataPointers.interactive)
+  {
+    printTree(tree, BY_KEY, NULL);
+    deleteTree(tree);
+    return 0;
+  }
   choice = 1;
   while(choice)
   {
     char* inputBuf;
     CONTACT_FIELD type;
+    int limit;
 
     
     choice = mainMenu();
@@ -101,6 +149,30 @@ int main(int argc, char* argv)
       case PRINT_ALL: 
               printTree(tree, BY_KEY, NULL);
               break;
+      case COMPLETE_NAME: 
+              inputBuf = valueBufferC;
+              inputBuf[0] = '\0';
+
+              type = completeMenu();
+              if(type == 0) break;
+
+              promptPrefix(inputBuf);
+              printCompletions(tree, (FIND_BY) type, inputBuf);
+
+              inputBuf[0] = '\0';
+              break;
+      case COUNT_GROUPS: 
+              type = groupMenu();
+              if(type == 0) break;
+
+              printf("most values to print (0 for all): ");
+              scanf("%d", &limit);
+              FLUSH
+              printGroups(tree, (FIND_BY) type, limit < 0 ? 0 : limit);
+              break;
+      case PRINT_REPORT: 
+              printReport(tree);
+              break;
       case EXIT_PROGRAM: 
               saveTree(tree);
               deleteTree(tree);
@@ -130,10 +202,13 @@ MAIN_MENU_CHOICE mainMenu(void)
   printf("4. Print a specific name and phone number (first occurance).\n");
   printf("5. Print a specific name and phone number (all fitting criteria).\n");
   printf("6. Print all names and phone numbers.\n");
+  printf("7. Complete a name (most common first).\n");
+  printf("8. Count contacts by area code or name (most common first).\n");
+  printf("9. Print contacts fitting several criteria.\n");
   printf("0. Exit from program.\n");
   scanf("%d", &choice);
   FLUSH
-  while(choice > 6 || choice < 0)
+  while(choice > 9 || choice < 0)
   {
     CLEAR
     printf("WELCOME TO CONTACT TREE SET MENU!!\n\n");
@@ -144,6 +219,9 @@ MAIN_MENU_CHOICE mainMenu(void)
     printf("4. Print a specific name and phone number (first occurance).\n");
     printf("5. Print a specific name and phone number (all fitting criteria).\n");
     printf("6. Print all names and phone numbers.\n");
+    printf("7. Complete a name (most common first).\n");
+    printf("8. Count contacts by area code or name (most common first).\n");
+    printf("9. Print contacts fitting several criteria.\n");
     printf("0. Exit from program.\n");
     scanf("%d", &choice);
     FLUSH
@@ -153,3 +231,61 @@ MAIN_MENU_CHOICE mainMenu(void)
 
 }
 
+/*
+  printReport
+  description
+    collects criteria from the user, each joined to those 
+    before it by and or or, then prints the contacts fitting 
+    them and how they were found, or only their number.
+  params:
+    tree      tree being reported on.
+  return: 
+    count     the number of criteria used.
+*/
+int printReport(TREE* tree)
+{
+  void* targets[REPORT_TERMS];
+  QUERY* query = NULL;
+  CONTACT_FIELD type;
+  int count, join, limit = 0, i;
+
+  for(count = 0; count < REPORT_TERMS; count++)
+  {
+    CLEAR
+    printf("criterion %d:\n", count + 1);
+    type = findMenu();
+    if(type == 0 || type == 1) break;
+    targets[count] = malloc(BUFFER);
+    if(targets[count] == NULL)
+    {
+      printf("sufficient memory could not be allocated to print report");
+      PAUSE
+      exit(0);
+    }
+    prompt(type, targets[count]);
+
+    join = 1;
+    if(count > 0)
+    {
+      printf("1. Fitting this and the criteria before.\n");
+      printf("2. Fitting this or the criteria before.\n");
+      scanf("%d", &join);
+      FLUSH
+    }
+    if(join == 2) query = queryOr(query, newQuery((FIND_BY) type, targets[count]));
+    else query = queryAnd(query, newQuery((FIND_BY) type, targets[count]));
+  }
+  if(query != NULL)
+  {
+    printf("most records to print (0 for all, -1 to count them only): ");
+    scanf("%d", &limit);
+    FLUSH
+    CLEAR
+    if(limit < 0) printf("%d record(s) fit your description.\n\n", countQuery(tree, query));
+    else printQuery(tree, query, BY_KEY, limit);
+  }
+  deleteQuery(query);
+  for(i = 0; i < count; i++) free(targets[i]);
+  return count;
+}
+